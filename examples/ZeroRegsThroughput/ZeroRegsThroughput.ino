@@ -0,0 +1,65 @@
+#include <ZeroRegs.h>
+
+// Times a whole dump on Serial and on SerialUSB, written a line at a time (as
+// printZeroRegs() does) and in small pieces (as it did before it collected
+// lines), then prints the times on Serial.  Without whole lines the printers
+// made about one write() for every 4 bytes, so SmallWrites passes each line
+// on in pieces that size.  Every dump prints the same snapshot, so only how it
+// is written differs.
+
+class SmallWrites : public Print {
+  public:
+    SmallWrites(Print &out) : out(out) {}
+    size_t write(uint8_t c) {
+      return out.write(c);
+    }
+    size_t write(const uint8_t *buffer, size_t size) {
+      for (size_t i = 0; i < size; i += 4) {
+        out.write(buffer + i, size - i < 4 ? size - i : 4);
+      }
+      return size;
+    }
+  private:
+    Print &out;
+};
+
+ZeroRegSnapshot snap;
+
+uint32_t timeDump(Print &out) {
+  ZeroRegOptions opts = { out, false };
+  uint32_t start = micros();
+  printZeroRegs(opts, snap);
+  out.flush();
+  return micros() - start;
+}
+
+void setup() {
+  Serial.begin(115200);
+  SerialUSB.begin(9600);
+  while (! Serial) {}  // wait for serial monitor to attach
+  while (! SerialUSB) {}
+  captureZeroRegs(snap);
+
+  SmallWrites serialSmall(Serial);
+  SmallWrites usbSmall(SerialUSB);
+  uint32_t serialLines = timeDump(Serial);
+  uint32_t serialPieces = timeDump(serialSmall);
+  uint32_t usbLines = timeDump(SerialUSB);
+  uint32_t usbPieces = timeDump(usbSmall);
+
+  Serial.println("--------------------------- THROUGHPUT");
+  Serial.print("Serial:  lines=");
+  Serial.print(serialLines);
+  Serial.print("us pieces=");
+  Serial.print(serialPieces);
+  Serial.println("us");
+  Serial.print("SerialUSB:  lines=");
+  Serial.print(usbLines);
+  Serial.print("us pieces=");
+  Serial.print(usbPieces);
+  Serial.println("us");
+}
+
+void loop() {
+  // Do nothing
+}
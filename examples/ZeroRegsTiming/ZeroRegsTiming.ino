@@ -0,0 +1,16 @@
+#include <ZeroRegs.h>
+
+// Prints the registers, then how long reading and printing each section took.
+// Compare the "print" cycles at different baud rates (or on SerialUSB) to see
+// how much of the time is just waiting for the output.
+
+void setup() {
+  Serial.begin(115200);
+  while (! Serial) {}  // wait for serial monitor to attach
+  ZeroRegOptions opts = { Serial, false };
+  printZeroRegsTimed(opts);
+}
+
+void loop() {
+  // Do nothing
+}
@@ -0,0 +1,30 @@
+#include <ZeroRegs.h>
+
+// Samples SERCOM0 (Serial1) and the EIC 100 times a second using TC4, and
+// prints what was sampled whenever something is typed into the serial monitor.
+
+ZeroRegWatchState watch;
+uint8_t buffer[2048];
+
+void TC4_Handler() {
+  sampleZeroRegsWatch(watch);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (! Serial) {}  // wait for serial monitor to attach
+  Serial1.begin(9600);
+  if (!beginZeroRegsWatch(watch, TC4, 4, 100, "SERCOM0 EIC", buffer, sizeof(buffer))) {
+    Serial.println("couldn't start watching");
+  }
+}
+
+void loop() {
+  if (Serial.available()) {
+    while (Serial.available()) {
+      Serial.read();
+    }
+    ZeroRegOptions opts = { Serial, false };
+    printZeroRegsWatch(opts, watch);
+  }
+}
@@ -0,0 +1,126 @@
+// vim: ts=4 sts=4 sw=4 et si ai
+/*
+Arduino.cpp - Just enough of the Arduino API for ZeroRegs to build on a host.
+*/
+
+#include "Arduino.h"
+#include <time.h>
+
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::printNumber(unsigned long long n, uint8_t base) {
+    char buf[8 * sizeof(n) + 1];
+    char *str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2) {
+        base = 10;
+    }
+    do {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (n);
+    return write(str);
+}
+
+size_t Print::print(const char str[])               { return write(str); }
+size_t Print::print(char c)                         { return write((uint8_t)c); }
+size_t Print::print(unsigned char n, int base)      { return print((unsigned long long)n, base); }
+size_t Print::print(int n, int base)                { return print((long long)n, base); }
+size_t Print::print(unsigned int n, int base)       { return print((unsigned long long)n, base); }
+size_t Print::print(long n, int base)               { return print((long long)n, base); }
+size_t Print::print(unsigned long n, int base)      { return print((unsigned long long)n, base); }
+
+size_t Print::print(long long n, int base) {
+    if (base == 0) {
+        return write((uint8_t)n);
+    }
+    if (base == 10 && n < 0) {
+        return print('-') + printNumber(-(unsigned long long)n, 10);
+    }
+    // like the Arduino core, other bases show the bits of the 32-bit value
+    return printNumber((unsigned long)n & 0xFFFFFFFFUL, base);
+}
+
+size_t Print::print(unsigned long long n, int base) {
+    if (base == 0) {
+        return write((uint8_t)n);
+    }
+    return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+}
+
+size_t Print::println(void)                                 { return write("\r\n"); }
+size_t Print::println(const char str[])                     { return print(str) + println(); }
+size_t Print::println(char c)                               { return print(c) + println(); }
+size_t Print::println(unsigned char n, int base)            { return print(n, base) + println(); }
+size_t Print::println(int n, int base)                      { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base)             { return print(n, base) + println(); }
+size_t Print::println(long n, int base)                     { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base)            { return print(n, base) + println(); }
+size_t Print::println(long long n, int base)                { return print(n, base) + println(); }
+size_t Print::println(unsigned long long n, int base)       { return print(n, base) + println(); }
+size_t Print::println(double n, int digits)                 { return print(n, digits) + println(); }
+
+
+static unsigned long long ZeroRegsHost_nowMicros() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+void delay(unsigned long ms) {
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+unsigned long micros(void) {
+    return (unsigned long)ZeroRegsHost_nowMicros();
+}
+
+unsigned long millis(void) {
+    return (unsigned long)(ZeroRegsHost_nowMicros() / 1000);
+}
+
+
+// [variant.cpp Arduino Zero] the first 20 pins
+#define D   PIN_ATTR_DIGITAL
+#define DPT (PIN_ATTR_DIGITAL | PIN_ATTR_PWM | PIN_ATTR_TIMER)
+const PinDescription g_APinDescription[] = {
+    { PORTA, 11, PIO_SERCOM,        D,                -1, -1, -1, 11 },   // D0
+    { PORTA, 10, PIO_SERCOM,        D,                -1, -1, -1, 10 },   // D1
+    { PORTA, 14, PIO_DIGITAL,       D,                -1, -1, -1, 14 },   // D2
+    { PORTA,  9, PIO_TIMER,         DPT,              -1, -1, -1,  9 },   // D3
+    { PORTA,  8, PIO_TIMER,         DPT,              -1, -1, -1, -1 },   // D4
+    { PORTA, 15, PIO_TIMER,         DPT,              -1, -1, -1, 15 },   // D5
+    { PORTA, 20, PIO_TIMER_ALT,     DPT,              -1, -1, -1,  4 },   // D6
+    { PORTA, 21, PIO_DIGITAL,       D,                -1, -1, -1,  5 },   // D7
+    { PORTA,  6, PIO_TIMER,         DPT,              -1, -1, -1,  6 },   // D8
+    { PORTA,  7, PIO_TIMER,         DPT,              -1, -1, -1,  7 },   // D9
+    { PORTA, 18, PIO_TIMER,         DPT,              -1, -1, -1,  2 },   // D10
+    { PORTA, 16, PIO_TIMER,         DPT,              -1, -1, -1,  0 },   // D11
+    { PORTA, 19, PIO_TIMER_ALT,     DPT,              -1, -1, -1,  3 },   // D12
+    { PORTA, 17, PIO_PWM,           DPT,              -1, -1, -1,  1 },   // D13
+    { PORTA,  2, PIO_ANALOG,        PIN_ATTR_ANALOG,   0, -1, -1,  2 },   // A0
+    { PORTB,  8, PIO_ANALOG,        DPT,               2, -1, -1,  8 },   // A1
+    { PORTB,  9, PIO_ANALOG,        DPT,               3, -1, -1,  9 },   // A2
+    { PORTA,  4, PIO_ANALOG,        DPT,               4, -1, -1,  4 },   // A3
+    { PORTA,  5, PIO_ANALOG,        DPT,               5, -1, -1,  5 },   // A4
+    { PORTB,  2, PIO_ANALOG,        PIN_ATTR_ANALOG,  10, -1, -1,  2 },   // A5
+};
+#undef D
+#undef DPT
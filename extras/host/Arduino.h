@@ -0,0 +1,128 @@
+// vim: ts=4 sts=4 sw=4 et si ai
+/*
+Arduino.h - Just enough of the Arduino API for ZeroRegs to build on a host.
+
+This is used by the host build in this directory.  It is not part of the
+library, and isn't used when building for a board.
+*/
+
+#ifndef ZERO_REGS_HOST_ARDUINO_H
+#define ZERO_REGS_HOST_ARDUINO_H
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <samd.h>
+
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+
+
+// same interface as the Arduino core's Print
+class Print {
+    public:
+        virtual ~Print() {}
+        virtual size_t write(uint8_t c) = 0;
+        virtual size_t write(const uint8_t *buffer, size_t size);
+        size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+        size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+        virtual int availableForWrite() { return 0; }
+        virtual void flush() {}
+
+        size_t print(const char str[]);
+        size_t print(char c);
+        size_t print(unsigned char n, int base = DEC);
+        size_t print(int n, int base = DEC);
+        size_t print(unsigned int n, int base = DEC);
+        size_t print(long n, int base = DEC);
+        size_t print(unsigned long n, int base = DEC);
+        size_t print(long long n, int base = DEC);
+        size_t print(unsigned long long n, int base = DEC);
+        size_t print(double n, int digits = 2);
+
+        size_t println(const char str[]);
+        size_t println(char c);
+        size_t println(unsigned char n, int base = DEC);
+        size_t println(int n, int base = DEC);
+        size_t println(unsigned int n, int base = DEC);
+        size_t println(long n, int base = DEC);
+        size_t println(unsigned long n, int base = DEC);
+        size_t println(long long n, int base = DEC);
+        size_t println(unsigned long long n, int base = DEC);
+        size_t println(double n, int digits = 2);
+        size_t println(void);
+
+    private:
+        size_t printNumber(unsigned long long n, uint8_t base);
+};
+
+
+// a Print which writes to a stdio stream
+class HostPrint : public Print {
+    public:
+        HostPrint(FILE *stream) : stream(stream) {}
+        virtual size_t write(uint8_t c) { return fputc(c, stream) == EOF ? 0 : 1; }
+        virtual size_t write(const uint8_t *buffer, size_t size) { return fwrite(buffer, 1, size, stream); }
+        virtual int availableForWrite() { return 4096; }
+        virtual void flush() { fflush(stream); }
+        using Print::write;
+    private:
+        FILE *stream;
+};
+
+
+void delay(unsigned long ms);
+unsigned long micros(void);
+unsigned long millis(void);
+
+
+// same as the Arduino SAMD core's WVariant.h
+typedef enum _EPortType {
+    NOT_A_PORT = -1,
+    PORTA = 0,
+    PORTB = 1,
+    PORTC = 2,
+} EPortType;
+typedef enum _EPioType {
+    PIO_NOT_A_PIN = -1,
+    PIO_EXTINT = 0,
+    PIO_ANALOG,
+    PIO_SERCOM,
+    PIO_SERCOM_ALT,
+    PIO_TIMER,
+    PIO_TIMER_ALT,
+    PIO_COM,
+    PIO_AC_CLK,
+    PIO_DIGITAL,
+    PIO_INPUT,
+    PIO_INPUT_PULLUP,
+    PIO_OUTPUT,
+    PIO_PWM = PIO_TIMER,
+} EPioType;
+#define PIN_ATTR_NONE       (0UL<<0)
+#define PIN_ATTR_COMBO      (1UL<<0)
+#define PIN_ATTR_ANALOG     (1UL<<1)
+#define PIN_ATTR_DIGITAL    (1UL<<2)
+#define PIN_ATTR_PWM        (1UL<<3)
+#define PIN_ATTR_TIMER      (1UL<<4)
+typedef struct _PinDescription {
+    EPortType   ulPort;
+    uint32_t    ulPin;
+    EPioType    ulPinType;
+    uint32_t    ulPinAttribute;
+    int         ulADCChannelNumber;
+    int         ulPWMChannel;
+    int         ulTCChannel;
+    int         ulExtInt;
+} PinDescription;
+
+// the first pins of the Arduino Zero variant
+#define PINS_COUNT (20u)
+extern const PinDescription g_APinDescription[];
+
+#endif // ZERO_REGS_HOST_ARDUINO_H
@@ -0,0 +1,320 @@
+// vim: ts=4 sts=4 sw=4 et si ai
+/*
+ZeroRegsHost.cpp - Simulated SAM D21 register file, so ZeroRegs runs on a host.
+*/
+
+#include "ZeroRegsHost.h"
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "the ZeroRegs host register file only works on x86-64 Linux"
+#endif
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+#define ZEROREGSHOST_PAGE   0x1000UL
+#define ZEROREGSHOST_TF     0x100       // x86 EFLAGS trap flag (single step)
+#define ZEROREGSHOST_WRITE  0x2         // x86 page fault error code: was a write
+
+uint32_t ZeroRegsHost_PRIMASK = 0;
+uint8_t ZeroRegsHost_syncReads = 2;
+
+
+// [10.2 DSrevF] Product Mapping
+struct ZeroRegsHost_Region {
+    uintptr_t   addr;
+    size_t      size;
+};
+static const ZeroRegsHost_Region ZeroRegsHost_regions[] = {
+    { 0x00800000, 0xB000 },     // NVM user row, calibration, serial number
+    { 0x20000000, 0x8000 },     // SRAM (for DMAC and USB descriptors)
+    { 0x40000000, 0x10000 },    // AHB-APB bridge A
+    { 0x41000000, 0x10000 },    // AHB-APB bridge B
+    { 0x42000000, 0x10000 },    // AHB-APB bridge C
+    { 0xE000E000, 0x1000 },     // System Control Space
+};
+#define ZEROREGSHOST_REGIONS (sizeof(ZeroRegsHost_regions) / sizeof(ZeroRegsHost_regions[0]))
+
+// Flash starts at 0, which Linux won't map, so only the part above 64k is
+// there.  It isn't a register, so it keeps its contents across a reset.
+static const ZeroRegsHost_Region ZeroRegsHost_flash = { 0x00010000, 0x30000 };
+// [22.6 DSrevF] a row is erased at once
+#define ZEROREGSHOST_NVM_ROW 256
+
+
+// registers which hold a different value for each ID written to their low byte
+struct ZeroRegsHost_Bank {
+    uintptr_t   addr;
+    uint8_t     width;
+    uint8_t     idMask;
+    uint32_t    value[64];
+};
+static ZeroRegsHost_Bank ZeroRegsHost_banks[] = {
+    { (uintptr_t)&GCLK->CLKCTRL,    sizeof(GCLK->CLKCTRL),  GCLK_CLKCTRL_ID_Msk,        {} },
+    { (uintptr_t)&GCLK->GENCTRL,    sizeof(GCLK->GENCTRL),  GCLK_GENCTRL_ID_Msk,        {} },
+    { (uintptr_t)&GCLK->GENDIV,     sizeof(GCLK->GENDIV),   GCLK_GENDIV_ID_Msk,         {} },
+    { (uintptr_t)&EVSYS->CHANNEL,   sizeof(EVSYS->CHANNEL), EVSYS_CHANNEL_CHANNEL_Msk,  {} },
+    { (uintptr_t)&EVSYS->USER,      sizeof(EVSYS->USER),    EVSYS_USER_USER_Msk,        {} },
+};
+#define ZEROREGSHOST_BANKS (sizeof(ZeroRegsHost_banks) / sizeof(ZeroRegsHost_banks[0]))
+
+// [20.8 DSrevF] DMAC registers from CHCTRLA through CHSTATUS depend on CHID
+#define ZEROREGSHOST_DMAC_CHANNEL_ADDR  ((uintptr_t)&DMAC->CHCTRLA)
+#define ZEROREGSHOST_DMAC_CHANNEL_SIZE  ((uintptr_t)&DMAC->CHSTATUS + sizeof(DMAC->CHSTATUS) - ZEROREGSHOST_DMAC_CHANNEL_ADDR)
+static uint8_t ZeroRegsHost_dmacChannels[16][16];
+// [20.6.3.7 DSrevF] the CRC engine's running CRC-32, before it's complemented
+static uint32_t ZeroRegsHost_crc;
+// [30.8.1 DSrevF] a software reset puts a TC's registers back to 0
+static Tc* const ZeroRegsHost_tcs[] = {
+    TC3, TC4, TC5,
+#ifdef TC6
+    TC6, TC7,
+#endif
+};
+#define ZEROREGSHOST_TCS (sizeof(ZeroRegsHost_tcs) / sizeof(ZeroRegsHost_tcs[0]))
+
+// pages with registers which need to be trapped
+static const uintptr_t ZeroRegsHost_trapped[] = {
+    (uintptr_t)GCLK & ~(ZEROREGSHOST_PAGE - 1),
+    (uintptr_t)EVSYS & ~(ZEROREGSHOST_PAGE - 1),
+    (uintptr_t)DMAC & ~(ZEROREGSHOST_PAGE - 1),
+    (uintptr_t)NVMCTRL & ~(ZEROREGSHOST_PAGE - 1),
+    (uintptr_t)TC3 & ~(ZEROREGSHOST_PAGE - 1),
+    (uintptr_t)TC5 & ~(ZEROREGSHOST_PAGE - 1),     // and TC6, TC7
+    (uintptr_t)SysTick & ~(ZEROREGSHOST_PAGE - 1),
+};
+#define ZEROREGSHOST_TRAPPED (sizeof(ZeroRegsHost_trapped) / sizeof(ZeroRegsHost_trapped[0]))
+
+// the access which is being single-stepped
+static struct {
+    bool        active;
+    uintptr_t   addr;
+    uintptr_t   page;
+    bool        write;
+    uint8_t     width;
+    uint8_t     before;     // low byte of the register before the write
+} ZeroRegsHost_pending;
+static uint8_t ZeroRegsHost_syncBusy = 0;
+
+
+static uint32_t ZeroRegsHost_read(uintptr_t addr, uint8_t width) {
+    switch (width) {
+        case 1: return *(volatile uint8_t*)addr;
+        case 2: return *(volatile uint16_t*)addr;
+        default: return *(volatile uint32_t*)addr;
+    }
+}
+
+static void ZeroRegsHost_write(uintptr_t addr, uint8_t width, uint32_t value) {
+    switch (width) {
+        case 1: *(volatile uint8_t*)addr = value; break;
+        case 2: *(volatile uint16_t*)addr = value; break;
+        default: *(volatile uint32_t*)addr = value; break;
+    }
+}
+
+// How many bytes the store instruction at `ip` writes.  Only needs to tell
+// byte stores (ID selects) from wider ones, for the code gcc generates.
+static uint8_t ZeroRegsHost_storeWidth(const uint8_t* ip) {
+    uint8_t width = 4;
+    for (;; ip++) {
+        if (*ip == 0x66) {
+            width = 2;
+        } else if ((*ip & 0xF0) == 0x40) {
+            // REX prefix
+            if (*ip & 0x08) {
+                width = 8;
+            }
+        } else {
+            break;
+        }
+    }
+    switch (*ip) {
+        case 0x08:  // or r/m8, r8
+        case 0x20:  // and r/m8, r8
+        case 0x30:  // xor r/m8, r8
+        case 0x80:  // (op) r/m8, imm8
+        case 0x86:  // xchg r/m8, r8
+        case 0x88:  // mov r/m8, r8
+        case 0xC6:  // mov r/m8, imm8
+            return 1;
+    }
+    return width;
+}
+
+static void ZeroRegsHost_beforeAccess() {
+    if (ZeroRegsHost_pending.write) {
+        ZeroRegsHost_pending.before = *(volatile uint8_t*)ZeroRegsHost_pending.addr;
+        return;
+    }
+    if (ZeroRegsHost_pending.addr == (uintptr_t)&SysTick->VAL) {
+        // the Arduino core reloads every millisecond
+        uint32_t load = SysTick->LOAD;
+        SysTick->VAL = load - (uint32_t)((uint64_t)(micros() % 1000) * (load + 1) / 1000);
+    }
+    if (ZeroRegsHost_pending.addr == (uintptr_t)&GCLK->STATUS) {
+        volatile uint8_t* status = (volatile uint8_t*)&GCLK->STATUS;
+        if (ZeroRegsHost_syncBusy) {
+            ZeroRegsHost_syncBusy--;
+            *status |= GCLK_STATUS_SYNCBUSY;
+        } else {
+            *status &= ~GCLK_STATUS_SYNCBUSY;
+        }
+    }
+}
+
+static void ZeroRegsHost_afterAccess() {
+    if (!ZeroRegsHost_pending.write) {
+        return;
+    }
+    uintptr_t addr = ZeroRegsHost_pending.addr;
+    if (addr >= (uintptr_t)GCLK && addr < (uintptr_t)GCLK + sizeof(Gclk)) {
+        ZeroRegsHost_syncBusy = ZeroRegsHost_syncReads;
+    }
+    for (uint8_t i = 0; i < ZEROREGSHOST_BANKS; i++) {
+        ZeroRegsHost_Bank &bank = ZeroRegsHost_banks[i];
+        if (addr != bank.addr) {
+            continue;
+        }
+        if (ZeroRegsHost_pending.width == 1) {
+            // [15.6.4.1 DSrevF] Indirect Access
+            uint8_t id = *(volatile uint8_t*)addr & bank.idMask;
+            ZeroRegsHost_write(addr, bank.width, bank.value[id]);
+        } else {
+            uint32_t value = ZeroRegsHost_read(addr, bank.width);
+            bank.value[value & bank.idMask] = value;
+        }
+        return;
+    }
+    if (addr == (uintptr_t)&DMAC->CHID) {
+        uint8_t before = ZeroRegsHost_pending.before & DMAC_CHID_ID_Msk;
+        uint8_t after = DMAC->CHID.reg & DMAC_CHID_ID_Msk;
+        memcpy(ZeroRegsHost_dmacChannels[before], (void*)ZEROREGSHOST_DMAC_CHANNEL_ADDR, ZEROREGSHOST_DMAC_CHANNEL_SIZE);
+        memcpy((void*)ZEROREGSHOST_DMAC_CHANNEL_ADDR, ZeroRegsHost_dmacChannels[after], ZEROREGSHOST_DMAC_CHANNEL_SIZE);
+    }
+    if (addr == (uintptr_t)&DMAC->CRCCHKSUM) {
+        ZeroRegsHost_crc = DMAC->CRCCHKSUM.reg;
+    }
+    if (addr == (uintptr_t)&DMAC->CRCDATAIN && DMAC->CTRL.bit.CRCENABLE
+            && DMAC->CRCCTRL.bit.CRCSRC == DMAC_CRCCTRL_CRCSRC_IO_Val && DMAC->CRCCTRL.bit.CRCPOLY == DMAC_CRCCTRL_CRCPOLY_CRC32_Val
+            && DMAC->CRCCTRL.bit.CRCBEATSIZE == DMAC_CRCCTRL_CRCBEATSIZE_BYTE_Val) {
+        // only byte beats from the CPU
+        ZeroRegsHost_crc ^= DMAC->CRCDATAIN.reg & 0xFF;
+        for (uint8_t b = 0; b < 8; b++) {
+            ZeroRegsHost_crc = (ZeroRegsHost_crc >> 1) ^ (0xEDB88320 & -(ZeroRegsHost_crc & 1));
+        }
+        DMAC->CRCCHKSUM.reg = ~ZeroRegsHost_crc;
+    }
+    if (addr == (uintptr_t)&NVMCTRL->CTRLA) {
+        // [22.8 DSrevF] only erasing does anything, since writes to flash
+        // land directly instead of in the page buffer
+        uint16_t ctrla = NVMCTRL->CTRLA.reg;
+        uintptr_t row = (NVMCTRL->ADDR.reg * 2) & ~(uintptr_t)(ZEROREGSHOST_NVM_ROW - 1);
+        if ((ctrla & NVMCTRL_CTRLA_CMDEX_Msk) == NVMCTRL_CTRLA_CMDEX_KEY && (ctrla & NVMCTRL_CTRLA_CMD_Msk) == NVMCTRL_CTRLA_CMD_ER
+                && row >= ZeroRegsHost_flash.addr && row < ZeroRegsHost_flash.addr + ZeroRegsHost_flash.size) {
+            memset((void*)row, 0xFF, ZEROREGSHOST_NVM_ROW);
+        }
+    }
+    for (uint8_t i = 0; i < ZEROREGSHOST_TCS; i++) {
+        TcCount16* tc = &ZeroRegsHost_tcs[i]->COUNT16;
+        if (addr == (uintptr_t)&tc->CTRLA && tc->CTRLA.bit.SWRST) {
+            memset((void*)tc, 0, sizeof(*tc));
+        }
+    }
+}
+
+static void ZeroRegsHost_onSEGV(int sig, siginfo_t* info, void* uctx) {
+    ucontext_t* ctx = (ucontext_t*)uctx;
+    uintptr_t addr = (uintptr_t)info->si_addr;
+    uintptr_t page = addr & ~(ZEROREGSHOST_PAGE - 1);
+    bool trapped = false;
+    for (uint8_t i = 0; i < ZEROREGSHOST_TRAPPED; i++) {
+        trapped = trapped || (page == ZeroRegsHost_trapped[i]);
+    }
+    if (!trapped || ZeroRegsHost_pending.active) {
+        // a real crash, so let it happen
+        signal(sig, SIG_DFL);
+        return;
+    }
+    ZeroRegsHost_pending.active = true;
+    ZeroRegsHost_pending.addr = addr;
+    ZeroRegsHost_pending.page = page;
+    ZeroRegsHost_pending.write = ctx->uc_mcontext.gregs[REG_ERR] & ZEROREGSHOST_WRITE;
+    ZeroRegsHost_pending.width = ZeroRegsHost_pending.write ? ZeroRegsHost_storeWidth((const uint8_t*)ctx->uc_mcontext.gregs[REG_RIP]) : 0;
+    mprotect((void*)page, ZEROREGSHOST_PAGE, PROT_READ | PROT_WRITE);
+    ZeroRegsHost_beforeAccess();
+    // let the access happen, then come back to onTRAP
+    ctx->uc_mcontext.gregs[REG_EFL] |= ZEROREGSHOST_TF;
+}
+
+static void ZeroRegsHost_onTRAP(int sig, siginfo_t* info, void* uctx) {
+    ucontext_t* ctx = (ucontext_t*)uctx;
+    if (!ZeroRegsHost_pending.active) {
+        signal(sig, SIG_DFL);
+        return;
+    }
+    ZeroRegsHost_afterAccess();
+    mprotect((void*)ZeroRegsHost_pending.page, ZEROREGSHOST_PAGE, PROT_NONE);
+    ZeroRegsHost_pending.active = false;
+    ctx->uc_mcontext.gregs[REG_EFL] &= ~ZEROREGSHOST_TF;
+}
+
+
+bool ZeroRegsHost_begin() {
+    for (uint8_t i = 0; i < ZEROREGSHOST_REGIONS; i++) {
+        const ZeroRegsHost_Region &region = ZeroRegsHost_regions[i];
+        void* addr = mmap((void*)region.addr, region.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (addr != (void*)region.addr) {
+            fprintf(stderr, "ZeroRegsHost: failed to map 0x%08lx\n", (unsigned long)region.addr);
+            return false;
+        }
+    }
+    void* flash = mmap((void*)ZeroRegsHost_flash.addr, ZeroRegsHost_flash.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (flash != (void*)ZeroRegsHost_flash.addr) {
+        fprintf(stderr, "ZeroRegsHost: failed to map 0x%08lx\n", (unsigned long)ZeroRegsHost_flash.addr);
+        return false;
+    }
+    // erased
+    memset(flash, 0xFF, ZeroRegsHost_flash.size);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags = SA_SIGINFO;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_sigaction = ZeroRegsHost_onSEGV;
+    sigaction(SIGSEGV, &sa, NULL);
+    sa.sa_sigaction = ZeroRegsHost_onTRAP;
+    sigaction(SIGTRAP, &sa, NULL);
+
+    ZeroRegsHost_reset();
+    return true;
+}
+
+void ZeroRegsHost_reset() {
+    for (uint8_t i = 0; i < ZEROREGSHOST_TRAPPED; i++) {
+        mprotect((void*)ZeroRegsHost_trapped[i], ZEROREGSHOST_PAGE, PROT_READ | PROT_WRITE);
+    }
+    for (uint8_t i = 0; i < ZEROREGSHOST_REGIONS; i++) {
+        memset((void*)ZeroRegsHost_regions[i].addr, 0, ZeroRegsHost_regions[i].size);
+    }
+    for (uint8_t i = 0; i < ZEROREGSHOST_BANKS; i++) {
+        // an unconfigured one still reads back its ID
+        for (uint8_t id = 0; id < 64; id++) {
+            ZeroRegsHost_banks[i].value[id] = id & ZeroRegsHost_banks[i].idMask;
+        }
+    }
+    memset(ZeroRegsHost_dmacChannels, 0, sizeof(ZeroRegsHost_dmacChannels));
+    ZeroRegsHost_crc = 0;
+    ZeroRegsHost_syncBusy = 0;
+    // NVMCTRL is always ready for the next command
+    NVMCTRL->INTFLAG.bit.READY = 1;
+    for (uint8_t i = 0; i < ZEROREGSHOST_TRAPPED; i++) {
+        mprotect((void*)ZeroRegsHost_trapped[i], ZEROREGSHOST_PAGE, PROT_NONE);
+    }
+}
@@ -0,0 +1,47 @@
+// vim: ts=4 sts=4 sw=4 et si ai
+/*
+ZeroRegsHost.h - Simulated SAM D21 register file, so ZeroRegs runs on a host.
+
+The peripheral macros from the CMSIS-Atmel headers (GCLK, PORT, SERCOM0, and
+so on) are fixed addresses.  This maps memory at those same addresses, so the
+library (and test code) can use the peripherals unchanged.
+
+Most registers are plain memory, and any synchronization finishes instantly
+(SYNCBUSY and friends always read 0).  The registers which are accessed
+indirectly are modelled more carefully, since the library depends on them:
+    GCLK    CLKCTRL, GENCTRL, GENDIV -- an 8-bit write of the ID selects
+            which one is read, a full write configures it.  After any write,
+            STATUS.SYNCBUSY reads 1 for ZeroRegsHost_syncReads reads.
+    EVSYS   CHANNEL, USER -- same as GCLK (without the SYNCBUSY)
+    DMAC    CHID selects which channel's CHCTRLA, CHCTRLB, CHINTENCLR,
+            CHINTENSET, CHINTFLAG, and CHSTATUS are seen.  The CRC engine
+            takes CRC-32 bytes written to CRCDATAIN (as the CPU would, not
+            from a channel), and CRCCHKSUM reads the CRC so far.
+    NVMCTRL CTRLA erases the row ADDR points into, and INTFLAG.READY
+            always reads 1.  Flash from 64k up is plain memory (erased to
+            0xFF when mapped, and kept across ZeroRegsHost_reset()), so
+            writes land there directly instead of in the page buffer.
+    TC      writing CTRLA.SWRST puts that TC's registers back to 0.
+    SysTick VAL counts down from LOAD once each millisecond of real time
+            (the way the Arduino core sets it up), so CPU cycles can be
+            timed.
+This is done by protecting the pages with those peripherals and trapping
+each access, so it only works on x86-64 Linux.
+*/
+
+#ifndef ZERO_REGS_HOST_H
+#define ZERO_REGS_HOST_H
+#include <Arduino.h>
+
+
+// Maps the register file and sets up the traps.  Call this before touching
+// any peripheral.  Returns false (after printing why to stderr) if it fails.
+bool ZeroRegsHost_begin();
+
+// Puts all registers (including the banked ones) back to zero.
+void ZeroRegsHost_reset();
+
+// How many reads of GCLK STATUS show SYNCBUSY after a write to GCLK.
+extern uint8_t ZeroRegsHost_syncReads;
+
+#endif // ZERO_REGS_HOST_H
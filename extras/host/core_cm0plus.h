@@ -0,0 +1,140 @@
+// vim: ts=4 sts=4 sw=4 et si ai
+/*
+core_cm0plus.h - Stands in for the CMSIS Cortex-M0+ core header on a host.
+
+The real one has ARM inline assembly.  This has the same register layouts
+(at the same addresses, which the host register file maps) and plain C
+versions of the intrinsics which ZeroRegs uses.
+*/
+
+#ifndef ZERO_REGS_HOST_CORE_CM0PLUS_H
+#define ZERO_REGS_HOST_CORE_CM0PLUS_H
+#include <stdint.h>
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __STATIC_INLINE static inline
+
+
+// [4.3 ARMv6-M ARM] System Control Block
+typedef struct {
+    __I  uint32_t CPUID;
+    __IO uint32_t ICSR;
+    __IO uint32_t VTOR;
+    __IO uint32_t AIRCR;
+    __IO uint32_t SCR;
+    __I  uint32_t CCR;
+         uint32_t RESERVED1;
+    __IO uint32_t SHP[2];
+    __IO uint32_t SHCSR;
+} SCB_Type;
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __I  uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct {
+    __IO uint32_t ISER[1];
+         uint32_t RESERVED0[31];
+    __IO uint32_t ICER[1];
+         uint32_t RSERVED1[31];
+    __IO uint32_t ISPR[1];
+         uint32_t RESERVED2[31];
+    __IO uint32_t ICPR[1];
+         uint32_t RESERVED3[31];
+         uint32_t RESERVED4[64];
+    __IO uint32_t IP[8];
+} NVIC_Type;
+
+#define SCS_BASE        (0xE000E000UL)
+#define SysTick_BASE    (SCS_BASE + 0x0010UL)
+#define NVIC_BASE       (SCS_BASE + 0x0100UL)
+#define SCB_BASE        (SCS_BASE + 0x0D00UL)
+#define SCB             ((SCB_Type *) SCB_BASE)
+#define SysTick         ((SysTick_Type *) SysTick_BASE)
+#define NVIC            ((NVIC_Type *) NVIC_BASE)
+
+#define SCB_CPUID_IMPLEMENTER_Pos   24
+#define SCB_CPUID_IMPLEMENTER_Msk   (0xFFUL << SCB_CPUID_IMPLEMENTER_Pos)
+#define SCB_CPUID_VARIANT_Pos       20
+#define SCB_CPUID_VARIANT_Msk       (0xFUL << SCB_CPUID_VARIANT_Pos)
+#define SCB_CPUID_ARCHITECTURE_Pos  16
+#define SCB_CPUID_ARCHITECTURE_Msk  (0xFUL << SCB_CPUID_ARCHITECTURE_Pos)
+#define SCB_CPUID_PARTNO_Pos        4
+#define SCB_CPUID_PARTNO_Msk        (0xFFFUL << SCB_CPUID_PARTNO_Pos)
+#define SCB_CPUID_REVISION_Pos      0
+#define SCB_CPUID_REVISION_Msk      (0xFUL << SCB_CPUID_REVISION_Pos)
+
+#define SCB_ICSR_PENDSTSET_Pos      26
+#define SCB_ICSR_PENDSTSET_Msk      (1UL << SCB_ICSR_PENDSTSET_Pos)
+
+#define SysTick_CTRL_COUNTFLAG_Pos  16
+#define SysTick_CTRL_COUNTFLAG_Msk  (1UL << SysTick_CTRL_COUNTFLAG_Pos)
+#define SysTick_CTRL_CLKSOURCE_Pos  2
+#define SysTick_CTRL_CLKSOURCE_Msk  (1UL << SysTick_CTRL_CLKSOURCE_Pos)
+#define SysTick_CTRL_TICKINT_Pos    1
+#define SysTick_CTRL_TICKINT_Msk    (1UL << SysTick_CTRL_TICKINT_Pos)
+#define SysTick_CTRL_ENABLE_Pos     0
+#define SysTick_CTRL_ENABLE_Msk     (1UL << SysTick_CTRL_ENABLE_Pos)
+#define SysTick_LOAD_RELOAD_Pos     0
+#define SysTick_LOAD_RELOAD_Msk     (0xFFFFFFUL << SysTick_LOAD_RELOAD_Pos)
+#define SysTick_VAL_CURRENT_Pos     0
+#define SysTick_VAL_CURRENT_Msk     (0xFFFFFFUL << SysTick_VAL_CURRENT_Pos)
+#define SysTick_CALIB_NOREF_Pos     31
+#define SysTick_CALIB_NOREF_Msk     (1UL << SysTick_CALIB_NOREF_Pos)
+#define SysTick_CALIB_SKEW_Pos      30
+#define SysTick_CALIB_SKEW_Msk      (1UL << SysTick_CALIB_SKEW_Pos)
+#define SysTick_CALIB_TENMS_Pos     0
+#define SysTick_CALIB_TENMS_Msk     (0xFFFFFFUL << SysTick_CALIB_TENMS_Pos)
+
+
+#define _BIT_SHIFT(IRQn)    ( ((((uint32_t)(int32_t)(IRQn))) & 0x03UL) * 8UL)
+#define _SHP_IDX(IRQn)      ( (((((uint32_t)(int32_t)(IRQn)) & 0x0FUL)-8UL) >> 2UL) )
+#define _IP_IDX(IRQn)       ( (((uint32_t)(int32_t)(IRQn)) >> 2UL) )
+
+__STATIC_INLINE void NVIC_EnableIRQ(IRQn_Type IRQn) {
+    NVIC->ISER[0] |= (1UL << (((uint32_t)(int32_t)IRQn) & 0x1FUL));
+}
+__STATIC_INLINE void NVIC_DisableIRQ(IRQn_Type IRQn) {
+    NVIC->ISER[0] &= ~(1UL << (((uint32_t)(int32_t)IRQn) & 0x1FUL));
+}
+__STATIC_INLINE void NVIC_SetPendingIRQ(IRQn_Type IRQn) {
+    NVIC->ISPR[0] |= (1UL << (((uint32_t)(int32_t)IRQn) & 0x1FUL));
+}
+__STATIC_INLINE void NVIC_ClearPendingIRQ(IRQn_Type IRQn) {
+    NVIC->ISPR[0] &= ~(1UL << (((uint32_t)(int32_t)IRQn) & 0x1FUL));
+}
+__STATIC_INLINE void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) {
+    if ((int32_t)(IRQn) < 0) {
+        SCB->SHP[_SHP_IDX(IRQn)] = (SCB->SHP[_SHP_IDX(IRQn)] & ~(0xFFUL << _BIT_SHIFT(IRQn))) |
+            (((priority << (8U - __NVIC_PRIO_BITS)) & 0xFFUL) << _BIT_SHIFT(IRQn));
+        return;
+    }
+    NVIC->IP[_IP_IDX(IRQn)] = (NVIC->IP[_IP_IDX(IRQn)] & ~(0xFFUL << _BIT_SHIFT(IRQn))) |
+        (((priority << (8U - __NVIC_PRIO_BITS)) & 0xFFUL) << _BIT_SHIFT(IRQn));
+}
+__STATIC_INLINE uint32_t NVIC_GetPriority(IRQn_Type IRQn) {
+    if ((int32_t)(IRQn) < 0) {
+        return ((SCB->SHP[_SHP_IDX(IRQn)] >> _BIT_SHIFT(IRQn)) & 0xFFUL) >> (8U - __NVIC_PRIO_BITS);
+    }
+    return ((NVIC->IP[_IP_IDX(IRQn)] >> _BIT_SHIFT(IRQn)) & 0xFFUL) >> (8U - __NVIC_PRIO_BITS);
+}
+
+
+// there are no interrupts on the host, but keep track of PRIMASK anyway so
+// that code which saves and restores it behaves the same
+extern uint32_t ZeroRegsHost_PRIMASK;
+__STATIC_INLINE uint32_t __get_PRIMASK(void) { return ZeroRegsHost_PRIMASK; }
+__STATIC_INLINE void __set_PRIMASK(uint32_t priMask) { ZeroRegsHost_PRIMASK = priMask & 1; }
+__STATIC_INLINE void __disable_irq(void) { ZeroRegsHost_PRIMASK = 1; }
+__STATIC_INLINE void __enable_irq(void) { ZeroRegsHost_PRIMASK = 0; }
+__STATIC_INLINE void __DSB(void) { __sync_synchronize(); }
+__STATIC_INLINE void __DMB(void) { __sync_synchronize(); }
+__STATIC_INLINE void __ISB(void) { __sync_synchronize(); }
+__STATIC_INLINE void __NOP(void) {}
+
+#endif // ZERO_REGS_HOST_CORE_CM0PLUS_H
@@ -0,0 +1,83 @@
+// vim: ts=4 sts=4 sw=4 et si ai
+/*
+decode.cpp - Prints the frames written by writeZeroRegs().
+
+    zeroregs-decode [-d] [-j | -D] [file]
+
+Reads the file (or stdin) and prints each frame found in it the same way
+printZeroRegs() would have on the board.  Anything between frames (such as
+other output from the sketch) is skipped.  `-d` also shows disabled things,
+and `-j` prints JSON instead of text.  `-D` prints each frame after the first
+as just the differences from the one before it (see printZeroRegsDiff()).
+
+This needs to be built for the same DEVICE as the board, and the ARDUINO PINS
+section uses this directory's pin table (which is the Arduino Zero's).
+*/
+
+#include <Arduino.h>
+#include <ZeroRegs.h>
+#include <stdlib.h>
+#include <vector>
+
+
+int main(int argc, char** argv) {
+    bool showDisabled = false;
+    bool json = false;
+    bool diff = false;
+    const char* path = NULL;
+    for (int a = 1; a < argc; a++) {
+        if (0 == strcmp(argv[a], "-d")) {
+            showDisabled = true;
+        } else if (0 == strcmp(argv[a], "-j")) {
+            json = true;
+        } else if (0 == strcmp(argv[a], "-D")) {
+            diff = true;
+        } else {
+            path = argv[a];
+        }
+    }
+
+    FILE* in = path ? fopen(path, "rb") : stdin;
+    if (!in) {
+        perror(path);
+        return 1;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t got;
+    while ((got = fread(buf, 1, sizeof(buf), in)) > 0) {
+        data.insert(data.end(), buf, buf + got);
+    }
+    if (path) {
+        fclose(in);
+    }
+
+    HostPrint out(stdout);
+    ZeroRegOptions opts = { out, showDisabled, json };
+    ZeroRegSnapshot* snap = (ZeroRegSnapshot*)malloc(sizeof(ZeroRegSnapshot));
+    ZeroRegSnapshot* prev = (ZeroRegSnapshot*)malloc(sizeof(ZeroRegSnapshot));
+    size_t frames = 0;
+    size_t pos = 0;
+    while (pos + ZEROREGS_FRAME_SIZE <= data.size()) {
+        if (data[pos] == 'Z' && data[pos + 1] == 'R' && readZeroRegs(&data[pos], ZEROREGS_FRAME_SIZE, *snap)) {
+            if (diff && frames) {
+                printZeroRegsDiff(opts, *prev, *snap);
+            } else {
+                printZeroRegs(opts, *snap);
+            }
+            memcpy(prev, snap, sizeof(ZeroRegSnapshot));
+            frames++;
+            pos += ZEROREGS_FRAME_SIZE;
+        } else {
+            pos++;
+        }
+    }
+    out.flush();
+    free(snap);
+    free(prev);
+    if (!frames) {
+        fprintf(stderr, "no version %d frames found (%d bytes each)\n", ZEROREGS_FRAME_VERSION, (int)ZEROREGS_FRAME_SIZE);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,353 @@
+// vim: ts=4 sts=4 sw=4 et si ai
+/*
+main.cpp - Runs ZeroRegs on a host, against the simulated register file.
+
+    zeroregs-host [-d] [-j | -b | -t | -e | -w | -l | -p | -f]
+
+Sets up the registers roughly the way an Arduino Zero sketch would have them
+and prints them to stdout.  `-d` also shows disabled things.  `-j` prints
+JSON instead of text, `-b` writes a binary frame (see writeZeroRegs()),
+`-t` adds how long each section took (see printZeroRegsTimed()), `-e`
+prints the event routes as Graphviz DOT (see printZeroRegEVSYSDot()), and
+`-w` watches SERCOM0 and TC4 while the baud rate changes (see
+printZeroRegsWatch()).  There are no interrupts on the host, so the TC4
+interrupt handler is called by hand.  `-l` watches a few status registers
+while they're changed by hand (see printZeroRegsWatchlist()).  `-p` saves a
+post-mortem from the WDT early warning, resets, and prints it (see
+printZeroRegsPostMortem()).  `-f` prints the configuration fingerprints
+(see printZeroRegsFingerprints()), and follows `-j`.
+*/
+
+#include <Arduino.h>
+#include <ZeroRegs.h>
+#include "ZeroRegsHost.h"
+
+
+static void setGCLK(uint8_t genid, uint8_t src, uint16_t div, bool idc) {
+    GCLK_GENDIV_Type gendiv;
+    gendiv.reg = 0;
+    gendiv.bit.ID = genid;
+    gendiv.bit.DIV = div;
+    GCLK->GENDIV.reg = gendiv.reg;
+
+    GCLK_GENCTRL_Type genctrl;
+    genctrl.reg = 0;
+    genctrl.bit.ID = genid;
+    genctrl.bit.SRC = src;
+    genctrl.bit.GENEN = 1;
+    genctrl.bit.IDC = idc;
+    GCLK->GENCTRL.reg = genctrl.reg;
+}
+
+static void setCLKCTRL(uint8_t gclkid, uint8_t genid) {
+    GCLK_CLKCTRL_Type clkctrl;
+    clkctrl.reg = 0;
+    clkctrl.bit.ID = gclkid;
+    clkctrl.bit.GEN = genid;
+    clkctrl.bit.CLKEN = 1;
+    GCLK->CLKCTRL.reg = clkctrl.reg;
+}
+
+static void setPMUX(uint8_t gid, uint8_t pid, uint8_t pmux) {
+    if (pid % 2) {
+        PORT->Group[gid].PMUX[pid / 2].bit.PMUXO = pmux;
+    } else {
+        PORT->Group[gid].PMUX[pid / 2].bit.PMUXE = pmux;
+    }
+    PORT->Group[gid].PINCFG[pid].bit.PMUXEN = 1;
+}
+
+
+// roughly what the Arduino SAMD core's startup.c and a simple sketch do
+static void setupLikeArduinoZero() {
+    // [10.3 DSrevF] NVM user row, software calibration, and serial number
+    *(volatile uint32_t*)(NVMCTRL_USER + 0) = 0xD8E0C7FA;
+    *(volatile uint32_t*)(NVMCTRL_USER + 4) = 0xFFFFFC5D;
+    *(volatile uint32_t*)(NVMCTRL_OTP4 + 0) = 0xDD2F8A24;
+    *(volatile uint32_t*)(NVMCTRL_OTP4 + 4) = 0x2B80D2C5;
+    *(volatile uint32_t*)0x0080A00C = 0x5A8DB4E5;
+    *(volatile uint32_t*)0x0080A040 = 0x50533050;
+    *(volatile uint32_t*)0x0080A044 = 0x312E3120;
+    *(volatile uint32_t*)0x0080A048 = 0xFF0E1A0D;
+    NVMCTRL->CTRLB.bit.RWS = 1;
+    NVMCTRL->PARAM.bit.NVMP = 4096;
+    NVMCTRL->PARAM.bit.PSZ = 3;
+    NVMCTRL->LOCK.reg = 0xFFFF;
+
+    // Cortex-M0+ r0p1
+    *(volatile uint32_t*)&SCB->CPUID = 0x410CC601;
+    SysTick->LOAD = 47999;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+    *(volatile uint32_t*)&SysTick->CALIB = 0x40000000;
+    NVIC_SetPriority(SERCOM0_IRQn, 3);
+    NVIC_SetPriority(USB_IRQn, 0);
+    // the Arduino core puts SysTick just above the lowest priority
+    NVIC_SetPriority(SysTick_IRQn, 2);
+    NVIC_SetPriority(TC3_IRQn, 1);
+    NVIC_SetPriority(DMAC_IRQn, 3);
+    NVIC_EnableIRQ(USB_IRQn);
+    NVIC_EnableIRQ(SERCOM0_IRQn);
+    NVIC_EnableIRQ(TC3_IRQn);
+    NVIC_EnableIRQ(DMAC_IRQn);
+    NVIC_SetPendingIRQ(SERCOM0_IRQn);
+
+    // clocks
+    SYSCTRL->XOSC32K.bit.STARTUP = 6;
+    SYSCTRL->XOSC32K.bit.XTALEN = 1;
+    SYSCTRL->XOSC32K.bit.EN32K = 1;
+    SYSCTRL->XOSC32K.bit.ENABLE = 1;
+    setGCLK(1, GCLK_SOURCE_XOSC32K, 0, false);
+    setCLKCTRL(GCLK_CLKCTRL_ID_DFLL48_Val, 1);
+    SYSCTRL->DFLLMUL.bit.CSTEP = 31;
+    SYSCTRL->DFLLMUL.bit.FSTEP = 511;
+    SYSCTRL->DFLLMUL.bit.MUL = 1465;    // 48MHz / 32768Hz
+    SYSCTRL->DFLLCTRL.bit.MODE = 1;
+    SYSCTRL->DFLLCTRL.bit.WAITLOCK = 1;
+    SYSCTRL->DFLLCTRL.bit.QLDIS = 1;
+    SYSCTRL->DFLLCTRL.bit.ENABLE = 1;
+    setGCLK(0, GCLK_SOURCE_DFLL48M, 0, true);
+    SYSCTRL->OSC8M.bit.PRESC = 0;
+    SYSCTRL->OSC8M.bit.ENABLE = 1;
+    setGCLK(3, GCLK_SOURCE_OSC8M, 0, false);
+    SYSCTRL->OSCULP32K.bit.CALIB = 0x10;
+
+    PM->AHBMASK.reg = 0x7F;
+    PM->APBAMASK.reg = 0x7F;
+    PM->APBBMASK.reg = 0x1F;
+    PM->APBCMASK.reg = PM_APBCMASK_SERCOM0 | PM_APBCMASK_TCC0 | PM_APBCMASK_ADC | PM_APBCMASK_EVSYS;
+
+    // Serial1 on SERCOM0, 115200 baud
+    setCLKCTRL(GCLK_CLKCTRL_ID_SERCOM0_CORE_Val, 0);
+    SERCOM0->USART.CTRLA.bit.MODE = 1;
+    SERCOM0->USART.CTRLA.bit.RXPO = 3;
+    SERCOM0->USART.CTRLA.bit.TXPO = 1;
+    SERCOM0->USART.CTRLA.bit.DORD = 1;
+    SERCOM0->USART.CTRLB.bit.TXEN = 1;
+    SERCOM0->USART.CTRLB.bit.RXEN = 1;
+    SERCOM0->USART.BAUD.reg = 63019;
+    SERCOM0->USART.CTRLA.bit.ENABLE = 1;
+    setPMUX(0, 10, 2);
+    setPMUX(0, 11, 2);
+
+    // LED on D13, a button with a pullup on D2
+    // (DIRSET and friends are plain memory here, so set DIR and OUT directly)
+    PORT->Group[0].DIR.reg |= 1 << 17;
+    PORT->Group[0].PINCFG[17].bit.INEN = 1;
+    PORT->Group[0].PINCFG[14].bit.INEN = 1;
+    PORT->Group[0].PINCFG[14].bit.PULLEN = 1;
+    PORT->Group[0].OUT.reg |= 1 << 14;
+
+    // analogWrite() on D11
+    setCLKCTRL(GCLK_CLKCTRL_ID_TCC0_TCC1_Val, 0);
+    TCC0->WAVE.bit.WAVEGEN = 2;
+    TCC0->PER.reg = 0xFF;
+    TCC0->CC[0].reg = 0x80;
+    TCC0->CTRLA.bit.ENABLE = 1;
+    setPMUX(0, 16, 5);
+
+    // analogRead()
+    setCLKCTRL(GCLK_CLKCTRL_ID_ADC_Val, 0);
+    ADC->CTRLB.bit.PRESCALER = 3;
+    ADC->CTRLB.bit.RESSEL = 2;
+    ADC->SAMPCTRL.bit.SAMPLEN = 0x3F;
+    ADC->INPUTCTRL.bit.MUXNEG = 0x18;
+    ADC->INPUTCTRL.bit.GAIN = 0xF;
+    ADC->REFCTRL.bit.REFSEL = 2;
+    ADC->CTRLA.bit.ENABLE = 1;
+
+    // an event channel into the DMAC, and a DMAC channel fed by Serial1
+    EVSYS_CHANNEL_Type channel;
+    channel.reg = 0;
+    channel.bit.CHANNEL = 0;
+    channel.bit.EVGEN = 0x2C;
+    channel.bit.PATH = 2;
+    EVSYS->CHANNEL.reg = channel.reg;
+    EVSYS_USER_Type user;
+    user.reg = 0;
+    user.bit.USER = 0;
+    user.bit.CHANNEL = 1;
+    EVSYS->USER.reg = user.reg;
+    DMAC->BASEADDR.reg = HMCRAMC0_ADDR;
+    DMAC->WRBADDR.reg = HMCRAMC0_ADDR + 0x100;
+    DMAC->CTRL.bit.LVLEN0 = 1;
+    DMAC->CTRL.bit.DMAENABLE = 1;
+    DMAC->CHID.reg = 2;
+    DMAC->CHCTRLB.bit.TRIGSRC = 0x01;
+    DMAC->CHCTRLB.bit.TRIGACT = 2;
+    DMAC->CHCTRLA.bit.ENABLE = 1;
+    DMAC->CHID.reg = 0;
+    // which fills two 64-byte buffers in turn, forever, and is part way
+    // through the first
+    DmacDescriptor* base = (DmacDescriptor*)(uintptr_t)DMAC->BASEADDR.reg;
+    DmacDescriptor* wrb = (DmacDescriptor*)(uintptr_t)DMAC->WRBADDR.reg;
+    DmacDescriptor* second = (DmacDescriptor*)(uintptr_t)(HMCRAMC0_ADDR + 0x1C0);
+    base[2].BTCTRL.bit.VALID = 1;
+    base[2].BTCTRL.bit.DSTINC = 1;
+    base[2].BTCNT.reg = 64;
+    base[2].SRCADDR.reg = (uintptr_t)&SERCOM0->USART.DATA;
+    base[2].DSTADDR.reg = HMCRAMC0_ADDR + 0x600 + 64;
+    base[2].DESCADDR.reg = (uintptr_t)second;
+    memcpy((void*)second, (void*)&base[2], sizeof(DmacDescriptor));
+    second->DSTADDR.reg = HMCRAMC0_ADDR + 0x640 + 64;
+    second->DESCADDR.reg = (uintptr_t)&base[2];
+    memcpy((void*)&wrb[2], (void*)&base[2], sizeof(DmacDescriptor));
+    wrb[2].BTCNT.reg = 23;
+
+    // USB device, with the control endpoint set up
+    USB->DEVICE.DESCADD.reg = HMCRAMC0_ADDR + 0x200;
+    UsbDeviceDescriptor* desc = (UsbDeviceDescriptor*)(uintptr_t)USB->DEVICE.DESCADD.reg;
+    desc[0].DeviceDescBank[0].ADDR.reg = HMCRAMC0_ADDR + 0x400;
+    desc[0].DeviceDescBank[0].PCKSIZE.bit.SIZE = 3;
+    desc[0].DeviceDescBank[1].ADDR.reg = HMCRAMC0_ADDR + 0x440;
+    desc[0].DeviceDescBank[1].PCKSIZE.bit.SIZE = 3;
+    USB->DEVICE.DeviceEndpoint[0].EPCFG.bit.EPTYPE0 = 1;
+    USB->DEVICE.DeviceEndpoint[0].EPCFG.bit.EPTYPE1 = 1;
+    USB->DEVICE.DADD.bit.DADD = 5;
+    USB->DEVICE.DADD.bit.ADDEN = 1;
+    USB->DEVICE.PADCAL.bit.TRANSN = 0x9;
+    USB->DEVICE.PADCAL.bit.TRANSP = 0x19;
+    USB->DEVICE.PADCAL.bit.TRIM = 0x6;
+    USB->DEVICE.CTRLA.bit.ENABLE = 1;
+}
+
+
+static ZeroRegWatchState watchState;
+void TC4_Handler() {
+    sampleZeroRegsWatch(watchState);
+}
+
+// room for three samples, so the first of four is dropped
+static void watchBaudChange(ZeroRegOptions &opts) {
+    static uint8_t buffer[3 * 40];
+    if (!beginZeroRegsWatch(watchState, TC4, 4, 10, "SERCOM0 TC4", buffer, sizeof(buffer))) {
+        opts.out.println("beginZeroRegsWatch() failed");
+        return;
+    }
+    TC4_Handler();
+    SERCOM0->USART.BAUD.reg = 65326;    // 9600 baud
+    TC4_Handler();
+    TC4_Handler();
+    endZeroRegsWatch(watchState);
+    printZeroRegsWatch(opts, watchState);
+}
+
+
+static void watchStatus(ZeroRegOptions &opts) {
+    static const ZeroRegWatchItem items[] = {
+        ZEROREGS_WATCH_ITEM(TCC0->STATUS.reg, 0),
+        ZEROREGS_WATCH_ITEM(SERCOM0->USART.STATUS.reg, 0),
+        ZEROREGS_WATCH_ITEM(DMAC->ACTIVE.reg, DMAC_ACTIVE_ABUSY | DMAC_ACTIVE_ID_Msk),
+    };
+    static ZeroRegWatchlist list;
+    static ZeroRegWatchChange changes[8];
+    if (!beginZeroRegsWatchlist(list, items, 3, changes, 8)) {
+        opts.out.println("beginZeroRegsWatchlist() failed");
+        return;
+    }
+    sampleZeroRegsWatchlist(list, 1000);
+    // a transfer on channel 2 starts, and the USART overflows
+    *(volatile uint32_t*)&DMAC->ACTIVE.reg = DMAC_ACTIVE_ABUSY | DMAC_ACTIVE_ID(2) | DMAC_ACTIVE_BTCNT(16);
+    SERCOM0->USART.STATUS.reg = SERCOM_USART_STATUS_BUFOVF;
+    sampleZeroRegsWatchlist(list, 1000);
+    // it finishes, and TCC0 stops
+    *(volatile uint32_t*)&DMAC->ACTIVE.reg = DMAC_ACTIVE_BTCNT(0);
+    TCC0->STATUS.reg = TCC_STATUS_STOP;
+    sampleZeroRegsWatchlist(list, 1000);
+    printZeroRegsWatchlist(opts, list);
+}
+
+
+static ZeroRegPostMortem postMortem;
+void WDT_Handler() {
+    saveZeroRegsPostMortem(postMortem);
+}
+
+// the last two rows of a 256k part
+#define POSTMORTEM_ADDR 0x3FE00
+static void postMortemWDT(ZeroRegOptions &opts) {
+    // the WDT from OSCULP32K/32, resetting after 4s with the early warning
+    // after 2s
+    setGCLK(2, GCLK_SOURCE_OSCULP32K, 32, false);
+    setCLKCTRL(GCLK_CLKCTRL_ID_WDT_Val, 2);
+    WDT->CONFIG.bit.PER = 0x9;
+    WDT->EWCTRL.bit.EWOFFSET = 0x8;
+    WDT->INTENSET.bit.EW = 1;
+    WDT->CTRL.bit.ENABLE = 1;
+    if (!beginZeroRegsPostMortem(postMortem, POSTMORTEM_ADDR, 512, "SYSCTRL GCLK PM WDT NVMCTRL SERCOM0 TCC0")) {
+        opts.out.println("beginZeroRegsPostMortem() failed");
+        return;
+    }
+    opts.out.print("post-mortem: ");
+    opts.out.print(postMortem.size);
+    opts.out.print(" bytes, write ");
+    opts.out.print(postMortem.writeUS);
+    opts.out.print("us of ");
+    opts.out.print(postMortem.windowUS);
+    opts.out.println("us");
+    // the sketch hangs, the early warning fires, then the WDT resets
+    // everything but flash
+    WDT_Handler();
+    ZeroRegsHost_reset();
+    PM->RCAUSE.reg = PM_RCAUSE_WDT;
+    printZeroRegsPostMortem(opts, POSTMORTEM_ADDR);
+}
+
+
+int main(int argc, char** argv) {
+    if (!ZeroRegsHost_begin()) {
+        return 1;
+    }
+    setupLikeArduinoZero();
+
+    HostPrint out(stdout);
+    // the control loop matters most, then the DMA feeding it
+    static const IRQn_Type critical[] = { TC3_IRQn, DMAC_IRQn };
+    ZeroRegOptions opts = { out, false, false, 0, critical, 2 };
+    bool binary = false;
+    bool timed = false;
+    bool dot = false;
+    bool watch = false;
+    bool watchlist = false;
+    bool postmortem = false;
+    bool fingerprints = false;
+    for (int a = 1; a < argc; a++) {
+        if (0 == strcmp(argv[a], "-d")) {
+            opts.showDisabled = true;
+        } else if (0 == strcmp(argv[a], "-j")) {
+            opts.json = true;
+        } else if (0 == strcmp(argv[a], "-b")) {
+            binary = true;
+        } else if (0 == strcmp(argv[a], "-t")) {
+            timed = true;
+        } else if (0 == strcmp(argv[a], "-e")) {
+            dot = true;
+        } else if (0 == strcmp(argv[a], "-w")) {
+            watch = true;
+        } else if (0 == strcmp(argv[a], "-l")) {
+            watchlist = true;
+        } else if (0 == strcmp(argv[a], "-p")) {
+            postmortem = true;
+        } else if (0 == strcmp(argv[a], "-f")) {
+            fingerprints = true;
+        }
+    }
+    if (binary) {
+        writeZeroRegs(out);
+    } else if (timed) {
+        printZeroRegsTimed(opts);
+    } else if (dot) {
+        printZeroRegEVSYSDot(opts);
+    } else if (watch) {
+        watchBaudChange(opts);
+    } else if (watchlist) {
+        watchStatus(opts);
+    } else if (postmortem) {
+        postMortemWDT(opts);
+    } else if (fingerprints) {
+        printZeroRegsFingerprints(opts);
+    } else {
+        printZeroRegs(opts);
+    }
+    out.flush();
+    return 0;
+}
@@ -35,301 +35,757 @@ DSrevF:  Refers to SAM D21/DA1 Family datasheet revision F (March 2020).
 #include <samd.h>
 
 
-static const char* ZeroRegs__DISABLED = "--disabled--";
-static const char* ZeroRegs__RESERVED = "--reserved--";
-static const char* ZeroRegs__UNKNOWN = "--unknown--";
-static const char* ZeroRegs__i2c_scl = "i2c:scl";
-static const char* ZeroRegs__i2c_sclout = "i2c:sclout";
-static const char* ZeroRegs__i2c_sda = "i2c:sda";
-static const char* ZeroRegs__i2c_sdaout = "i2c:sdaout";
-static const char* ZeroRegs__spi_miso = "spi:miso";
-static const char* ZeroRegs__spi_mosi = "spi:mosi";
-static const char* ZeroRegs__spi_sck = "spi:sck";
-static const char* ZeroRegs__spi_ss = "spi:ss";
-static const char* ZeroRegs__usart_cts = "usart:cts";
-static const char* ZeroRegs__usart_rts = "usart:rts";
-static const char* ZeroRegs__usart_rx = "usart:rx";
-static const char* ZeroRegs__usart_tx = "usart:tx";
-static const char* ZeroRegs__usart_xck = "usart:xck";
-static const char* ZeroRegs__empty = "";
+static const char ZeroRegs__DISABLED[] = "--disabled--";
+static const char ZeroRegs__RESERVED[] = "--reserved--";
+static const char ZeroRegs__UNKNOWN[] = "--unknown--";
+static const char ZeroRegs__i2c_scl[] = "i2c:scl";
+static const char ZeroRegs__i2c_sclout[] = "i2c:sclout";
+static const char ZeroRegs__i2c_sda[] = "i2c:sda";
+static const char ZeroRegs__i2c_sdaout[] = "i2c:sdaout";
+static const char ZeroRegs__spi_miso[] = "spi:miso";
+static const char ZeroRegs__spi_mosi[] = "spi:mosi";
+static const char ZeroRegs__spi_sck[] = "spi:sck";
+static const char ZeroRegs__spi_ss[] = "spi:ss";
+static const char ZeroRegs__usart_cts[] = "usart:cts";
+static const char ZeroRegs__usart_rts[] = "usart:rts";
+static const char ZeroRegs__usart_rx[] = "usart:rx";
+static const char ZeroRegs__usart_tx[] = "usart:tx";
+static const char ZeroRegs__usart_xck[] = "usart:xck";
+static const char ZeroRegs__empty[] = "";
 #define PRINTFLAG(x,y) do { if (x.bit.y) { opts.out.print(" " #y); } } while(0)
+#define PRINTHZ(x) ZeroRegs__printRate(opts.out, x, "Hz")
 #define PRINTHEX(x) do { opts.out.print("0x"); opts.out.print(x, HEX); } while(0)
+#define PRINTNAME(names,x,other) opts.out.print(LOOKUPNAME(names,x,other))
 #define PRINTNL() opts.out.println(ZeroRegs__empty)
 #define PRINTPAD2(x) do { if (x < 10) { opts.out.print("0"); } opts.out.print(x, DEC); } while(0)
 #define PRINTSCALE(x) (opts.out.print(1 << (x)))
-#define READ2FUSES(x,y,o) ( ((*((uint32_t *) x##_FUSES_##y##_0_ADDR) & x##_FUSES_##y##_0_Msk) >> x##_FUSES_##y##_0_Pos) | (((*((uint32_t *) x##_FUSES_##y##_1_ADDR) & x##_FUSES_##y##_1_Msk) >> x##_FUSES_##y##_1_Pos) << o))
+#define LOOKUPNAME(names,x,other) ZeroRegs__lookupName(names, sizeof(names) / sizeof(names[0]), x, other)
+#define READ2FUSES(row,x,y,o) ( ((row[(x##_FUSES_##y##_0_ADDR - NVMCTRL_USER) / 4] & x##_FUSES_##y##_0_Msk) >> x##_FUSES_##y##_0_Pos) | (((row[(x##_FUSES_##y##_1_ADDR - NVMCTRL_USER) / 4] & x##_FUSES_##y##_1_Msk) >> x##_FUSES_##y##_1_Pos) << o))
 #define READADDR32(x) (*((uint32_t*)(x)))
-#define READFUSE(x,y) ((*((uint32_t *) x##_FUSES_##y##_ADDR) & x##_FUSES_##y##_Msk) >> x##_FUSES_##y##_Pos)
+#define READFUSE(row,x,y) ((row[(x##_FUSES_##y##_ADDR - NVMCTRL_USER) / 4] & x##_FUSES_##y##_Msk) >> x##_FUSES_##y##_Pos)
 #define READSCS(val,name) ( (val & (name##_Msk)) >> (name##_Pos) )
-#define WRITE8(x,y) *((uint8_t*)&(x)) = uint8_t(y)
-void printZeroRegSERCOM_pinhint(ZeroRegOptions &opts, const char* pmux);
+void printZeroRegSERCOM_pinhint(ZeroRegOptions &opts, const ZeroRegSnapshot_PORT &port, const char* pmux);
 
 
-void printZeroReg_QOS(ZeroRegOptions &opts, uint8_t qos) {
-    switch (qos) {
-        case 0x0: opts.out.print("DISABLE"); break;
-        case 0x1: opts.out.print("LOW"); break;
-        case 0x2: opts.out.print("MEDIUM"); break;
-        case 0x3: opts.out.print("HIGH"); break;
+// Most enumerated fields are decoded with a table of names indexed by the
+// field value.  Values past the end of the table (or gaps in it) decode as
+// `other`, which is usually ZeroRegs__RESERVED.
+static const char* ZeroRegs__lookupName(const char* const names[], uint8_t count, uint8_t val, const char* other) {
+    return val < count ? names[val] : other;
+}
+
+// Prints `val` divided by `scale` (a power of 10), with only as many decimals
+// as it needs, such as "32.768" for 32768/1000.
+static void ZeroRegs__printDecimal(Print &out, uint32_t val, uint32_t scale) {
+    out.print(val / scale);
+    uint32_t frac = val % scale;
+    if (frac) {
+        out.print(".");
+        for (scale /= 10; frac; scale /= 10) {
+            out.print(frac / scale);
+            frac %= scale;
+        }
+    }
+}
+
+// Prints a rate as short as it can be without losing any digits, such as
+// "48MHz" or "32.768kHz".  0 means it isn't known (or isn't running).
+static void ZeroRegs__printRate(Print &out, uint32_t val, const char* unit) {
+    if (!val) {
+        out.print(ZeroRegs__UNKNOWN);
+        return;
     }
+    if (val >= 1000000) {
+        ZeroRegs__printDecimal(out, val, 1000000);
+        out.print("M");
+    } else if (val >= 1000) {
+        ZeroRegs__printDecimal(out, val, 1000);
+        out.print("k");
+    } else {
+        out.print(val);
+    }
+    out.print(unit);
 }
 
+// Prints a time given in nanoseconds, such as "86.805us" or "333ns".
+static void ZeroRegs__printNS(Print &out, uint32_t ns) {
+    if (ns >= 1000000) {
+        ZeroRegs__printDecimal(out, ns, 1000000);
+        out.print("ms");
+    } else if (ns >= 1000) {
+        ZeroRegs__printDecimal(out, ns, 1000);
+        out.print("us");
+    } else {
+        out.print(ns);
+        out.print("ns");
+    }
+}
 
-void printZeroRegAC(ZeroRegOptions &opts) {
+// Prints hundredths of a percent, such as "50.19%" (or "+0.02%" with `sign`).
+static void ZeroRegs__printPercent(Print &out, int32_t hundredths, bool sign) {
+    if (hundredths < 0) {
+        out.print("-");
+        hundredths = -hundredths;
+    } else if (sign) {
+        out.print("+");
+    }
+    out.print(hundredths / 100);
+    out.print(".");
+    if (hundredths % 100 < 10) {
+        out.print("0");
+    }
+    out.print(hundredths % 100);
+    out.print("%");
+}
+
+// How many whole bits it takes to count `count` steps.
+static uint8_t ZeroRegs__bits(uint64_t count) {
+    uint8_t bits = 0;
+    while ((2ULL << bits) <= count) {
+        bits++;
+    }
+    return bits;
+}
+
+// CRC-32 (the same one as zlib and Ethernet).  Bitwise instead of with a
+// table, since it only sees a couple of kilobytes and flash is tight.
+// Start with crc = 0, and pass the result back in to continue.
+static uint32_t ZeroRegs__crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+
+// How many times to read back an indirectly-accessed register before giving
+// up on it.  Each read is a few cycles (more if the peripheral has to
+// synchronize) so this is way more than is needed.
+#ifndef ZEROREGS_SYNC_POLLS
+#define ZEROREGS_SYNC_POLLS 1000
+#endif
+
+// Some registers are read by first writing an ID to their low byte (using an
+// 8-bit write) and then reading the whole register.  This does the write then
+// polls until the peripheral isn't busy and the register reads back with that
+// ID, instead of waiting a fixed amount of time.  Returns false if that didn't
+// happen in ZEROREGS_SYNC_POLLS reads, in which case the callers record the
+// register as just its ID (which decodes as disabled).
+// [15.6.4.1 DSrevF] GCLK Indirect Access
+// [24.6.2.3 DSrevF] [24.6.2.4 DSrevF] EVSYS USER and CHANNEL
+// [20.8.15 DSrevF] DMAC CHID
+static bool ZeroRegs__select(volatile void* reg, uint8_t id, uint8_t idMask, const volatile uint8_t* busy, uint8_t busyMask) {
+    volatile uint8_t* sel = (volatile uint8_t*)reg;
+    *sel = id;
+    for (uint16_t n = 0; n < ZEROREGS_SYNC_POLLS; n++) {
+        if (busy && (*busy & busyMask)) {
+            continue;
+        }
+        if ((*sel & idMask) == (id & idMask)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void ZeroRegLineWriter::flushLine() {
+    if (len) {
+        out.write(buf, len);
+        len = 0;
+    }
+}
+
+size_t ZeroRegLineWriter::write(uint8_t c) {
+    buf[len++] = c;
+    if (c == '\n' || len == sizeof(buf)) {
+        flushLine();
+    }
+    return 1;
+}
+
+size_t ZeroRegLineWriter::write(const uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        write(buffer[i]);
+    }
+    return size;
+}
+
+void ZeroRegLineWriter::flush() {
+    flushLine();
+    out.flush();
+}
+
+
+size_t ZeroRegJSONWriter::write(uint8_t c) {
+    if (c == '\n') {
+        line();
+        len = 0;
+        cut = false;
+    } else if (c != '\r') {
+        if (len < sizeof(buf)) {
+            buf[len++] = c;
+        } else {
+            cut = true;
+        }
+    }
+    return 1;
+}
+
+size_t ZeroRegJSONWriter::write(const uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        write(buffer[i]);
+    }
+    return size;
+}
+
+void ZeroRegJSONWriter::flush() {
+    out.flush();
+}
+
+void ZeroRegJSONWriter::end() {
+    if (len) {
+        line();
+        len = 0;
+        cut = false;
+    }
+    if (!started) {
+        return;
+    }
+    if (inRegister) {
+        out.write('}');
+    }
+    if (inSection) {
+        out.write('}');
+    }
+    out.write("\n}\n");
+    started = inSection = inRegister = false;
+}
+
+// writes the characters of a JSON string (without the quotes)
+void ZeroRegJSONWriter::chars(const char* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (s[i] == '"' || s[i] == '\\') {
+            out.write('\\');
+        }
+        if ((uint8_t)s[i] >= 0x20) {
+            out.write(s[i]);
+        }
+    }
+}
+
+// starts a member of the innermost object
+void ZeroRegJSONWriter::member(const char* name, size_t n, bool newline) {
+    if (!first) {
+        out.write(',');
+    }
+    if (newline) {
+        out.write('\n');
+    }
+    out.write('"');
+    chars(name, n);
+    out.write("\": ");
+    first = false;
+}
+
+// Finds the next token in s[pos..n).  Tokens are separated by spaces, except
+// that a (parenthesized comment) is all one token.
+static bool ZeroRegs__token(const char* s, size_t n, size_t &pos, size_t &start) {
+    while (pos < n && s[pos] == ' ') {
+        pos++;
+    }
+    if (pos == n) {
+        return false;
+    }
+    start = pos;
+    uint8_t depth = 0;
+    while (pos < n && (depth || s[pos] != ' ')) {
+        if (s[pos] == '(') {
+            depth++;
+        } else if (s[pos] == ')' && depth) {
+            depth--;
+        }
+        pos++;
+    }
+    return true;
+}
+
+// 0 for a flag or name=value, 1 for a bare value, 2 for a comment
+static uint8_t ZeroRegs__tokenKind(const char* t, size_t n) {
+    if (t[0] == '(') {
+        return 2;
+    }
+    if ((t[0] >= '0' && t[0] <= '9') || t[0] == '+' || t[0] == '-' || t[0] == '/') {
+        return memchr(t, '=', n) ? 0 : 1;
+    }
+    return 0;
+}
+
+void ZeroRegJSONWriter::fields(const char* s, size_t n) {
+    size_t pos = 0, start;
+    while (ZeroRegs__token(s, n, pos, start)) {
+        const char* t = s + start;
+        size_t tn = pos - start;
+        if (ZeroRegs__tokenKind(t, tn)) {
+            continue;
+        }
+        const char* eq = (const char*)memchr(t, '=', tn);
+        if (eq && eq != t) {
+            member(t, eq - t, false);
+            out.write('"');
+            chars(eq + 1, tn - (eq - t) - 1);
+            out.write('"');
+        } else {
+            member(t, tn, false);
+            out.write("true");
+        }
+    }
+    // bare values, then comments, each joined with spaces
+    for (uint8_t kind = 1; kind <= 2; kind++) {
+        bool any = false;
+        pos = 0;
+        while (ZeroRegs__token(s, n, pos, start)) {
+            const char* t = s + start;
+            size_t tn = pos - start;
+            if (ZeroRegs__tokenKind(t, tn) != kind) {
+                continue;
+            }
+            if (any) {
+                out.write(' ');
+            } else {
+                member(kind == 1 ? "value" : "note", kind == 1 ? 5 : 4, false);
+                out.write('"');
+                any = true;
+            }
+            if (kind == 2 && tn >= 2 && t[tn - 1] == ')') {
+                chars(t + 1, tn - 2);
+            } else {
+                chars(t, tn);
+            }
+        }
+        if (any) {
+            out.write('"');
+        }
+    }
+    if (cut) {
+        member("truncated", 9, false);
+        out.write("true");
+    }
+}
+
+void ZeroRegJSONWriter::line() {
+    const char* s = buf;
+    size_t n = len;
+    while (n && s[n - 1] == ' ') {
+        n--;
+    }
+    size_t indent = 0;
+    while (indent < n && s[indent] == ' ') {
+        indent++;
+    }
+    if (indent == n) {
+        return;
+    }
+    if (!started) {
+        out.write('{');
+        started = true;
+        first = true;
+    }
+
+    // section header, such as "--------------------------- GCLK"
+    if (n > 4 && 0 == memcmp(s, "----", 4)) {
+        size_t i = 0;
+        while (i < n && (s[i] == '-' || s[i] == ' ')) {
+            i++;
+        }
+        if (inRegister) {
+            out.write('}');
+            inRegister = false;
+            first = false;
+        }
+        if (inSection) {
+            out.write('}');
+            first = false;
+        }
+        member(s + i, n - i, true);
+        out.write('{');
+        first = true;
+        inSection = true;
+        return;
+    }
+
+    // register, such as "NAME:  FLAG name=value"
+    const char* colon = (const char*)memchr(s + indent, ':', n - indent);
+    size_t nameEnd = colon ? colon - s : n;
+    if (indent && inRegister) {
+        // indented lines go inside the register above them
+        member(s + indent, nameEnd - indent, false);
+        out.write('{');
+        first = true;
+        fields(s + nameEnd + 1, colon ? n - nameEnd - 1 : 0);
+        out.write('}');
+        first = false;
+        return;
+    }
+    if (inRegister) {
+        out.write('}');
+        inRegister = false;
+        first = false;
+    }
+    member(s + indent, nameEnd - indent, true);
+    out.write('{');
+    first = true;
+    inRegister = true;
+    fields(s + nameEnd + 1, colon ? n - nameEnd - 1 : 0);
+}
+
+
+static const char* const ZeroRegs__QOSs[] = {
+    "DISABLE", "LOW", "MEDIUM", "HIGH",
+};
+void printZeroReg_QOS(ZeroRegOptions &opts, uint8_t qos) {
+    PRINTNAME(ZeroRegs__QOSs, qos, ZeroRegs__empty);
+}
+
+
+void captureZeroRegAC(ZeroRegSnapshot_AC &ac) {
     while (AC->CTRLA.bit.SWRST || AC->STATUSB.bit.SYNCBUSY) {}
-    if (!AC->CTRLA.bit.ENABLE && !opts.showDisabled) {
+    ac.CTRLA.reg = AC->CTRLA.reg;
+    ac.EVCTRL.reg = AC->EVCTRL.reg;
+    ac.WINCTRL.reg = AC->WINCTRL.reg;
+    ac.COMPCTRL[0].reg = AC->COMPCTRL[0].reg;
+    ac.COMPCTRL[1].reg = AC->COMPCTRL[1].reg;
+    ac.SCALER[0].reg = AC->SCALER[0].reg;
+    ac.SCALER[1].reg = AC->SCALER[1].reg;
+}
+
+static const char* const ZeroRegsAC_SPEEDs[] = {
+    "LOW", "HIGHT",
+};
+static const char* const ZeroRegsAC_INTSELs[] = {
+    "TOGGLE", "RISING", "FALLING", "EOC",
+};
+static const char* const ZeroRegsAC_MUXNEGs[] = {
+    "PIN0", "PIN1", "PIN2", "PIN3", "GND", "VSCALE", "BANDGAP", "DAC",
+};
+static const char* const ZeroRegsAC_MUXPOSs[] = {
+    "PIN0", "PIN1", "PIN2", "PIN3",
+};
+static const char* const ZeroRegsAC_OUTs[] = {
+    "OFF", "ASYNC", "SYNC",
+};
+static const char* const ZeroRegsAC_FLENs[] = {
+    "OFF", "MAJ3", "MAJ5",
+};
+void printZeroRegAC(ZeroRegOptions &opts, const ZeroRegSnapshot_AC &ac) {
+    if (!ac.CTRLA.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- AC");
 
     opts.out.print("CTRLA: ");
-    PRINTFLAG(AC->CTRLA, ENABLE);
-    PRINTFLAG(AC->CTRLA, RUNSTDBY);
-    PRINTFLAG(AC->CTRLA, LPMUX);
+    PRINTFLAG(ac.CTRLA, ENABLE);
+    PRINTFLAG(ac.CTRLA, RUNSTDBY);
+    PRINTFLAG(ac.CTRLA, LPMUX);
     PRINTNL();
 
     opts.out.print("EVCTRL: ");
-    PRINTFLAG(AC->EVCTRL, COMPEO0);
-    PRINTFLAG(AC->EVCTRL, COMPEO1);
-    PRINTFLAG(AC->EVCTRL, WINEO0);
-    PRINTFLAG(AC->EVCTRL, COMPEI0);
-    PRINTFLAG(AC->EVCTRL, COMPEI1);
+    PRINTFLAG(ac.EVCTRL, COMPEO0);
+    PRINTFLAG(ac.EVCTRL, COMPEO1);
+    PRINTFLAG(ac.EVCTRL, WINEO0);
+    PRINTFLAG(ac.EVCTRL, COMPEI0);
+    PRINTFLAG(ac.EVCTRL, COMPEI1);
     PRINTNL();
 
     opts.out.print("WINCTRL: ");
-    PRINTFLAG(AC->WINCTRL, WEN0);
+    PRINTFLAG(ac.WINCTRL, WEN0);
     opts.out.print(" WINTSEL0=");
-    PRINTHEX(AC->WINCTRL.bit.WINTSEL0);
+    PRINTHEX(ac.WINCTRL.bit.WINTSEL0);
     PRINTNL();
 
     for (uint8_t id = 0; id < 2; id++) {
         opts.out.print("COMPCTRL");
         opts.out.print(id);
         opts.out.print(": ");
-        PRINTFLAG(AC->COMPCTRL[id], ENABLE);
-        PRINTFLAG(AC->COMPCTRL[id], SINGLE);
+        PRINTFLAG(ac.COMPCTRL[id], ENABLE);
+        PRINTFLAG(ac.COMPCTRL[id], SINGLE);
         opts.out.print(" speed=");
-        switch (AC->COMPCTRL[id].bit.SPEED) {
-            case 0x0: opts.out.print("LOW"); break;
-            case 0x1: opts.out.print("HIGHT"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        PRINTNAME(ZeroRegsAC_SPEEDs, ac.COMPCTRL[id].bit.SPEED, ZeroRegs__RESERVED);
         opts.out.print(" intsel=");
-        switch (AC->COMPCTRL[id].bit.INTSEL) {
-            case 0x0: opts.out.print("TOGGLE"); break;
-            case 0x1: opts.out.print("RISING"); break;
-            case 0x2: opts.out.print("FALLING"); break;
-            case 0x3: opts.out.print("EOC"); break;
-        }
+        PRINTNAME(ZeroRegsAC_INTSELs, ac.COMPCTRL[id].bit.INTSEL, ZeroRegs__empty);
         opts.out.print(" muxneg=");
-        switch (AC->COMPCTRL[id].bit.MUXNEG) {
-            case 0x0: opts.out.print("PIN0"); break;
-            case 0x1: opts.out.print("PIN1"); break;
-            case 0x2: opts.out.print("PIN2"); break;
-            case 0x3: opts.out.print("PIN3"); break;
-            case 0x4: opts.out.print("GND"); break;
-            case 0x5: opts.out.print("VSCALE"); break;
-            case 0x6: opts.out.print("BANDGAP"); break;
-            case 0x7: opts.out.print("DAC"); break;
-        }
+        PRINTNAME(ZeroRegsAC_MUXNEGs, ac.COMPCTRL[id].bit.MUXNEG, ZeroRegs__empty);
         opts.out.print(" muxpos=");
-        switch (AC->COMPCTRL[id].bit.MUXPOS) {
-            case 0x0: opts.out.print("PIN0"); break;
-            case 0x1: opts.out.print("PIN1"); break;
-            case 0x2: opts.out.print("PIN2"); break;
-            case 0x3: opts.out.print("PIN3"); break;
-        }
-        PRINTFLAG(AC->COMPCTRL[id], SWAP);
+        PRINTNAME(ZeroRegsAC_MUXPOSs, ac.COMPCTRL[id].bit.MUXPOS, ZeroRegs__empty);
+        PRINTFLAG(ac.COMPCTRL[id], SWAP);
         opts.out.print(" out=");
-        switch (AC->COMPCTRL[id].bit.OUT) {
-            case 0x0: opts.out.print("OFF"); break;
-            case 0x1: opts.out.print("ASYNC"); break;
-            case 0x2: opts.out.print("SYNC"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
-        PRINTFLAG(AC->COMPCTRL[id], HYST);
+        PRINTNAME(ZeroRegsAC_OUTs, ac.COMPCTRL[id].bit.OUT, ZeroRegs__RESERVED);
+        PRINTFLAG(ac.COMPCTRL[id], HYST);
         opts.out.print(" flen=");
-        switch (AC->COMPCTRL[id].bit.FLEN) {
-            case 0x0: opts.out.print("OFF"); break;
-            case 0x1: opts.out.print("MAJ3"); break;
-            case 0x2: opts.out.print("MAJ5"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        PRINTNAME(ZeroRegsAC_FLENs, ac.COMPCTRL[id].bit.FLEN, ZeroRegs__RESERVED);
         PRINTNL();
     }
 
     opts.out.print("SCALER0:  ");
-    opts.out.print(AC->SCALER[0].bit.VALUE);
+    opts.out.print(ac.SCALER[0].bit.VALUE);
     PRINTNL();
     opts.out.print("SCALER1:  ");
-    opts.out.print(AC->SCALER[1].bit.VALUE);
+    opts.out.print(ac.SCALER[1].bit.VALUE);
     PRINTNL();
 }
 
+void printZeroRegAC(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_AC ac;
+    captureZeroRegAC(ac);
+    printZeroRegAC(opts, ac);
+}
+
 
-void printZeroRegADC(ZeroRegOptions &opts) {
+void captureZeroRegADC(ZeroRegSnapshot_ADC &adc) {
     while (ADC->CTRLA.bit.SWRST || ADC->STATUS.bit.SYNCBUSY) {}
-    if (!ADC->CTRLA.bit.ENABLE && !opts.showDisabled) {
+    adc.CTRLA.reg = ADC->CTRLA.reg;
+    adc.REFCTRL.reg = ADC->REFCTRL.reg;
+    adc.AVGCTRL.reg = ADC->AVGCTRL.reg;
+    adc.SAMPCTRL.reg = ADC->SAMPCTRL.reg;
+    adc.CTRLB.reg = ADC->CTRLB.reg;
+    adc.WINCTRL.reg = ADC->WINCTRL.reg;
+    adc.INPUTCTRL.reg = ADC->INPUTCTRL.reg;
+    adc.EVCTRL.reg = ADC->EVCTRL.reg;
+    adc.WINLT.reg = ADC->WINLT.reg;
+    adc.WINUT.reg = ADC->WINUT.reg;
+    adc.GAINCORR.reg = ADC->GAINCORR.reg;
+    adc.OFFSETCORR.reg = ADC->OFFSETCORR.reg;
+    adc.CALIB.reg = ADC->CALIB.reg;
+}
+
+static const char* const ZeroRegsADC_RESSELs[] = {
+    "12BIT", "16BIT", "10BIT", "8BIT",
+};
+static const char* const ZeroRegsADC_REFSELs[] = {
+    "INTV1", "INTVCC0", "INTVCC1", "VREFA", "VREFB",
+};
+// the internal inputs, from 0x18
+static const char* const ZeroRegsADC_MUXPOSs[] = {
+    "TEMP", "BANDGAP", "SCALEDCOREVCC", "SCALEDIOVCC", "DAC",
+};
+// the internal inputs, from 0x18
+static const char* const ZeroRegsADC_MUXNEGs[] = {
+    "GND", "IOGND",
+};
+static const char* const ZeroRegsADC_GAINs[] = {
+    "1x", "2x", "4x", "8x", "16x", ZeroRegs__RESERVED, ZeroRegs__RESERVED, ZeroRegs__RESERVED,
+    ZeroRegs__RESERVED, ZeroRegs__RESERVED, ZeroRegs__RESERVED, ZeroRegs__RESERVED,
+    ZeroRegs__RESERVED, ZeroRegs__RESERVED, ZeroRegs__RESERVED, "x/2",
+};
+// [33.6.5 DSrevF] extra half CLK_ADC cycles the gain stage takes, for 1x,
+// 2x, 4x, 8x, 16x, and 1/2x (the first six single-ended, the rest
+// differential)
+static const uint8_t ZeroRegsADC_DELAYGAINs[] = {
+    0, 2, 2, 3, 3, 1,
+    0, 0, 1, 1, 2, 0,
+};
+
+// Prints how long the ADC takes to sample and convert, and how many results a
+// second that gives.  Times are worked out in half CLK_ADC cycles, since
+// that's what SAMPLEN counts in.  [33.6.5 DSrevF] A single conversion (as
+// started by the START event or by SWTRIG) takes one more cycle than a
+// free-running one, and averaging does SAMPLENUM conversions per result.
+static void ZeroRegs__printADCTiming(ZeroRegOptions &opts, const ZeroRegSnapshot_ADC &adc, uint32_t coreHz) {
+    uint32_t clk = coreHz >> (adc.CTRLB.bit.PRESCALER + 2);
+    // the 16-bit mode is 12-bit conversions averaged
+    uint8_t bits = 12;
+    switch (adc.CTRLB.bit.RESSEL) {
+        case 0x2: bits = 10; break;
+        case 0x3: bits = 8; break;
+    }
+    uint8_t gain = adc.INPUTCTRL.bit.GAIN <= 0x4 ? adc.INPUTCTRL.bit.GAIN : 0x5;
+    uint32_t sample = adc.SAMPCTRL.bit.SAMPLEN + 1;
+    uint32_t conversion = sample + bits + ZeroRegsADC_DELAYGAINs[(adc.CTRLB.bit.DIFFMODE ? 6 : 0) + gain];
+    uint32_t count = 1 << (adc.AVGCTRL.bit.SAMPLENUM <= 0xA ? adc.AVGCTRL.bit.SAMPLENUM : 0);
+    uint32_t freerun = conversion * count;
+    uint32_t single = freerun + 2;
+    uint64_t halfHz = 2 * (uint64_t)clk;
+
+    opts.out.print("conversion:  clk=");
+    PRINTHZ(clk);
+    if (clk) {
+        opts.out.print(" sample=");
+        ZeroRegs__printNS(opts.out, (uint32_t)(sample * 1000000000ULL / halfHz));
+        opts.out.print(" result=");
+        ZeroRegs__printNS(opts.out, (uint32_t)(single * 1000000000ULL / halfHz));
+        opts.out.print(" freerun=");
+        ZeroRegs__printRate(opts.out, (uint32_t)(halfHz / freerun), "/s");
+        opts.out.print(" triggered=");
+        ZeroRegs__printRate(opts.out, (uint32_t)(halfHz / single), "/s");
+    }
+    PRINTNL();
+}
+
+void printZeroRegADC(ZeroRegOptions &opts, const ZeroRegSnapshot_ADC &adc) {
+    printZeroRegADC(opts, adc, 0);
+}
+
+void printZeroRegADC(ZeroRegOptions &opts, const ZeroRegSnapshot_ADC &adc, uint32_t coreHz) {
+    if (!adc.CTRLA.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- ADC");
 
     opts.out.print("CTRLA: ");
-    PRINTFLAG(ADC->CTRLA, ENABLE);
-    PRINTFLAG(ADC->CTRLA, RUNSTDBY);
+    PRINTFLAG(adc.CTRLA, ENABLE);
+    PRINTFLAG(adc.CTRLA, RUNSTDBY);
     PRINTNL();
 
     opts.out.print("CTRLB: ");
-    PRINTFLAG(ADC->CTRLB, DIFFMODE);
-    PRINTFLAG(ADC->CTRLB, LEFTADJ);
-    PRINTFLAG(ADC->CTRLB, FREERUN);
-    PRINTFLAG(ADC->CTRLB, CORREN);
+    PRINTFLAG(adc.CTRLB, DIFFMODE);
+    PRINTFLAG(adc.CTRLB, LEFTADJ);
+    PRINTFLAG(adc.CTRLB, FREERUN);
+    PRINTFLAG(adc.CTRLB, CORREN);
     opts.out.print(" ressel=");
-    switch (ADC->CTRLB.bit.RESSEL) {
-        case 0x0: opts.out.print("12BIT"); break;
-        case 0x1: opts.out.print("16BIT"); break;
-        case 0x2: opts.out.print("10BIT"); break;
-        case 0x3: opts.out.print("8BIT"); break;
-    }
+    PRINTNAME(ZeroRegsADC_RESSELs, adc.CTRLB.bit.RESSEL, ZeroRegs__empty);
     opts.out.print(" PRESCALER=");
-    PRINTHEX(ADC->CTRLB.bit.PRESCALER);
+    PRINTHEX(adc.CTRLB.bit.PRESCALER);
     PRINTNL();
 
     opts.out.print("REFCTRL:  refsel=");
-    switch (ADC->REFCTRL.bit.REFSEL) {
-        case 0x0: opts.out.print("INTV1"); break;
-        case 0x1: opts.out.print("INTVCC0"); break;
-        case 0x2: opts.out.print("INTVCC1"); break;
-        case 0x3: opts.out.print("VREFA"); break;
-        case 0x4: opts.out.print("VREFB"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
-    PRINTFLAG(ADC->REFCTRL, REFCOMP);
+    PRINTNAME(ZeroRegsADC_REFSELs, adc.REFCTRL.bit.REFSEL, ZeroRegs__RESERVED);
+    PRINTFLAG(adc.REFCTRL, REFCOMP);
     PRINTNL();
 
     opts.out.print("AVGCTRL:  samplenum=");
-    PRINTSCALE(ADC->AVGCTRL.bit.SAMPLENUM);
+    PRINTSCALE(adc.AVGCTRL.bit.SAMPLENUM);
     opts.out.print("samples ADJRES=");
-    PRINTHEX(ADC->AVGCTRL.bit.ADJRES);
+    PRINTHEX(adc.AVGCTRL.bit.ADJRES);
     PRINTNL();
 
     opts.out.print("SAMPCTRL:  SAMPLEN=");
-    PRINTHEX(ADC->SAMPCTRL.bit.SAMPLEN);
+    PRINTHEX(adc.SAMPCTRL.bit.SAMPLEN);
     PRINTNL();
 
     opts.out.print("WINCTRL:  WINMODE=");
-    PRINTHEX(ADC->WINCTRL.bit.WINMODE);
+    PRINTHEX(adc.WINCTRL.bit.WINMODE);
     PRINTNL();
 
     opts.out.print("INPUTCTRL: ");
     opts.out.print(" muxpos=");
-    if (ADC->INPUTCTRL.bit.MUXPOS <= 0x13) {
+    if (adc.INPUTCTRL.bit.MUXPOS <= 0x13) {
         opts.out.print("AIN");
-        opts.out.print(ADC->INPUTCTRL.bit.MUXPOS);
+        opts.out.print(adc.INPUTCTRL.bit.MUXPOS);
     } else {
-        switch (ADC->INPUTCTRL.bit.MUXPOS) {
-            case 0x18: opts.out.print("TEMP"); break;
-            case 0x19: opts.out.print("BANDGAP"); break;
-            case 0x1A: opts.out.print("SCALEDCOREVCC"); break;
-            case 0x1B: opts.out.print("SCALEDIOVCC"); break;
-            case 0x1C: opts.out.print("DAC"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        // what's under 0x18 wraps around past the end
+        PRINTNAME(ZeroRegsADC_MUXPOSs, adc.INPUTCTRL.bit.MUXPOS - 0x18, ZeroRegs__RESERVED);
     }
     opts.out.print(" muxneg=");
-    if (ADC->INPUTCTRL.bit.MUXNEG <= 0x7) {
+    if (adc.INPUTCTRL.bit.MUXNEG <= 0x7) {
         opts.out.print("AIN");
-        opts.out.print(ADC->INPUTCTRL.bit.MUXNEG);
+        opts.out.print(adc.INPUTCTRL.bit.MUXNEG);
     } else {
-        switch (ADC->INPUTCTRL.bit.MUXNEG) {
-            case 0x18: opts.out.print("GND"); break;
-            case 0x19: opts.out.print("IOGND"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        PRINTNAME(ZeroRegsADC_MUXNEGs, adc.INPUTCTRL.bit.MUXNEG - 0x18, ZeroRegs__RESERVED);
     }
     opts.out.print(" INPUTSCAN=");
-    opts.out.print(ADC->INPUTCTRL.bit.INPUTSCAN);
+    opts.out.print(adc.INPUTCTRL.bit.INPUTSCAN);
     opts.out.print(" INPUTOFFSET=");
-    opts.out.print(ADC->INPUTCTRL.bit.INPUTOFFSET);
+    opts.out.print(adc.INPUTCTRL.bit.INPUTOFFSET);
     opts.out.print(" gain=");
-    switch (ADC->INPUTCTRL.bit.GAIN) {
-        case 0x0: opts.out.print("1x"); break;
-        case 0x1: opts.out.print("2x"); break;
-        case 0x2: opts.out.print("4x"); break;
-        case 0x3: opts.out.print("8x"); break;
-        case 0x4: opts.out.print("16x"); break;
-        /*...*/
-        case 0xF: opts.out.print("x/2"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsADC_GAINs, adc.INPUTCTRL.bit.GAIN, ZeroRegs__RESERVED);
     PRINTNL();
 
+    if (coreHz) {
+        ZeroRegs__printADCTiming(opts, adc, coreHz);
+    }
+
     opts.out.print("EVCTRL: ");
-    PRINTFLAG(ADC->EVCTRL, STARTEI);
-    PRINTFLAG(ADC->EVCTRL, SYNCEI);
-    PRINTFLAG(ADC->EVCTRL, RESRDYEO);
-    PRINTFLAG(ADC->EVCTRL, WINMONEO);
+    PRINTFLAG(adc.EVCTRL, STARTEI);
+    PRINTFLAG(adc.EVCTRL, SYNCEI);
+    PRINTFLAG(adc.EVCTRL, RESRDYEO);
+    PRINTFLAG(adc.EVCTRL, WINMONEO);
     PRINTNL();
 
     opts.out.print("WINLT:  ");
-    opts.out.print(ADC->WINLT.bit.WINLT);
+    opts.out.print(adc.WINLT.bit.WINLT);
     PRINTNL();
 
     opts.out.print("WINUT:  ");
-    opts.out.print(ADC->WINUT.bit.WINUT);
+    opts.out.print(adc.WINUT.bit.WINUT);
     PRINTNL();
 
-    if (ADC->CTRLB.bit.CORREN) {
+    if (adc.CTRLB.bit.CORREN) {
         opts.out.print("GAINCORR:  ");
-        PRINTHEX(ADC->GAINCORR.bit.GAINCORR);
+        PRINTHEX(adc.GAINCORR.bit.GAINCORR);
         PRINTNL();
 
         opts.out.print("OFFSETCORR:  ");
-        PRINTHEX(ADC->OFFSETCORR.bit.OFFSETCORR);
+        PRINTHEX(adc.OFFSETCORR.bit.OFFSETCORR);
         PRINTNL();
     }
 
     opts.out.print("CALIB:  LINEARITY_CAL=");
-    PRINTHEX(ADC->CALIB.bit.LINEARITY_CAL);
+    PRINTHEX(adc.CALIB.bit.LINEARITY_CAL);
     opts.out.print(" BIAS_CAL=");
-    PRINTHEX(ADC->CALIB.bit.BIAS_CAL);
+    PRINTHEX(adc.CALIB.bit.BIAS_CAL);
     PRINTNL();
 }
 
+void printZeroRegADC(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_SYSCTRL sysctrl;
+    ZeroRegSnapshot_GCLK gclk;
+    ZeroRegClocks clocks;
+    ZeroRegSnapshot_ADC adc;
+    captureZeroRegSYSCTRL(sysctrl);
+    captureZeroRegGCLK(gclk);
+    computeZeroRegClocks(clocks, sysctrl, gclk, opts.xoscHz);
+    captureZeroRegADC(adc);
+    printZeroRegADC(opts, adc, clocks.CLKCTRL[GCLK_CLKCTRL_ID_ADC_Val]);
+}
 
-void printZeroRegDAC(ZeroRegOptions &opts) {
+
+void captureZeroRegDAC(ZeroRegSnapshot_DAC &dac) {
     while (DAC->CTRLA.bit.SWRST || DAC->STATUS.bit.SYNCBUSY) {}
-    if (!DAC->CTRLA.bit.ENABLE && !opts.showDisabled) {
+    dac.CTRLA.reg = DAC->CTRLA.reg;
+    dac.CTRLB.reg = DAC->CTRLB.reg;
+    dac.EVCTRL.reg = DAC->EVCTRL.reg;
+}
+
+static const char* const ZeroRegsDAC_REFSELs[] = {
+    "INTREF", "VDDANA", "VREFA",
+};
+void printZeroRegDAC(ZeroRegOptions &opts, const ZeroRegSnapshot_DAC &dac) {
+    if (!dac.CTRLA.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- DAC");
 
     opts.out.print("CTRLA: ");
-    PRINTFLAG(DAC->CTRLA, ENABLE);
-    PRINTFLAG(DAC->CTRLA, RUNSTDBY);
+    PRINTFLAG(dac.CTRLA, ENABLE);
+    PRINTFLAG(dac.CTRLA, RUNSTDBY);
     PRINTNL();
 
     opts.out.print("CTRLB: ");
-    PRINTFLAG(DAC->CTRLB, EOEN);
-    PRINTFLAG(DAC->CTRLB, IOEN);
-    PRINTFLAG(DAC->CTRLB, LEFTADJ);
-    PRINTFLAG(DAC->CTRLB, VPD);
-    PRINTFLAG(DAC->CTRLB, BDWP);
+    PRINTFLAG(dac.CTRLB, EOEN);
+    PRINTFLAG(dac.CTRLB, IOEN);
+    PRINTFLAG(dac.CTRLB, LEFTADJ);
+    PRINTFLAG(dac.CTRLB, VPD);
+    PRINTFLAG(dac.CTRLB, BDWP);
     opts.out.print(" refsel=");
-    switch (DAC->CTRLB.bit.REFSEL) {
-        case 0x0: opts.out.print("INTREF"); break;
-        case 0x1: opts.out.print("VDDANA"); break;
-        case 0x2: opts.out.print("VREFA"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsDAC_REFSELs, dac.CTRLB.bit.REFSEL, ZeroRegs__RESERVED);
     PRINTNL();
 
     opts.out.print("EVCTRL: ");
-    PRINTFLAG(DAC->EVCTRL, STARTEI);
-    PRINTFLAG(DAC->EVCTRL, EMPTYEO);
+    PRINTFLAG(dac.EVCTRL, STARTEI);
+    PRINTFLAG(dac.EVCTRL, EMPTYEO);
     PRINTNL();
 }
 
+void printZeroRegDAC(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_DAC dac;
+    captureZeroRegDAC(dac);
+    printZeroRegDAC(opts, dac);
+}
+
 
 typedef union {
     struct {
@@ -339,42 +795,285 @@ typedef union {
     } bit;
     uint8_t reg;
 } ZeroRegsDMAC_PRILVL;
-void printZeroRegDMAC(ZeroRegOptions &opts) {
+// Returns the descriptor at `addr`, or NULL if it's not somewhere a descriptor
+// could be.  [20.6.2.3 DSrevF] They're 128-bit aligned, and (since these
+// pointers come from the sketch) only SRAM is trusted.
+static const DmacDescriptor* ZeroRegs__dmacDescriptor(uint32_t addr) {
+    if (addr < HMCRAMC0_ADDR || addr > HMCRAMC0_ADDR + HMCRAMC0_SIZE - sizeof(DmacDescriptor) || (addr & 0xF)) {
+        return NULL;
+    }
+    return (const DmacDescriptor*)(uintptr_t)addr;
+}
+
+static const DmacDescriptor* ZeroRegs__dmacNext(const DmacDescriptor* desc) {
+    return desc ? ZeroRegs__dmacDescriptor(desc->DESCADDR.reg) : NULL;
+}
+
+static void ZeroRegs__captureDmacDescriptor(ZeroRegSnapshot_DMAC_Descriptor &snap, const DmacDescriptor* desc) {
+    if (!desc) {
+        memset(&snap, 0, sizeof(snap));
+        return;
+    }
+    snap.BTCTRL.reg = desc->BTCTRL.reg;
+    snap.BTCNT.reg = desc->BTCNT.reg;
+    snap.SRCADDR.reg = desc->SRCADDR.reg;
+    snap.DSTADDR.reg = desc->DSTADDR.reg;
+    snap.DESCADDR.reg = desc->DESCADDR.reg;
+}
+
+// Follows the DESCADDR links from the channel's first descriptor, counting
+// the descriptors and the bytes they move.  A sketch can link them in a
+// circle (to run forever), so this uses Floyd's cycle finding, which doesn't
+// need any memory to remember where it's been.
+static void ZeroRegs__captureDmacChain(ZeroRegSnapshot_DMAC &dmac, uint8_t id, const DmacDescriptor* head) {
+    uint16_t links = 0;
+    uint32_t bytes = 0;
+    const DmacDescriptor* slow = head;
+    const DmacDescriptor* fast = head;
+    const DmacDescriptor* start = NULL;
+    while (fast) {
+        slow = ZeroRegs__dmacNext(slow);
+        fast = ZeroRegs__dmacNext(ZeroRegs__dmacNext(fast));
+        if (fast && fast == slow) {
+            // the loop starts as far from the head as the head is from here
+            start = head;
+            while (start != slow) {
+                start = ZeroRegs__dmacNext(start);
+                slow = ZeroRegs__dmacNext(slow);
+            }
+            break;
+        }
+    }
+    // once through every descriptor, stopping when back at the loop's start
+    bool looped = false;
+    for (const DmacDescriptor* desc = head; desc; desc = ZeroRegs__dmacNext(desc)) {
+        if (desc == start) {
+            if (looped) {
+                break;
+            }
+            looped = true;
+        }
+        links++;
+        bytes += (uint32_t)desc->BTCNT.reg << desc->BTCTRL.bit.BEATSIZE;
+    }
+    dmac.LINKS[id] = links;
+    dmac.BYTES[id] = bytes;
+    if (start) {
+        dmac.LOOPS |= 1 << id;
+    }
+}
+
+void captureZeroRegDMAC(ZeroRegSnapshot_DMAC &dmac) {
     while (DMAC->CTRL.bit.SWRST) {}
-    if (!DMAC->CTRL.bit.DMAENABLE && !opts.showDisabled) {
+    dmac.CTRL.reg = DMAC->CTRL.reg;
+    dmac.CRCCTRL.reg = DMAC->CRCCTRL.reg;
+    dmac.QOSCTRL.reg = DMAC->QOSCTRL.reg;
+    dmac.PRICTRL0.reg = DMAC->PRICTRL0.reg;
+    dmac.BASEADDR.reg = DMAC->BASEADDR.reg;
+    dmac.WRBADDR.reg = DMAC->WRBADDR.reg;
+
+    // [20.6.2.3 DSrevF] each channel's first descriptor and write-back
+    // descriptor are at BASEADDR and WRBADDR, indexed by the channel number
+    dmac.LOOPS = 0;
+    for (uint8_t id = 0; id < 12; id++) {
+        const DmacDescriptor* head = ZeroRegs__dmacDescriptor(dmac.BASEADDR.reg + id * sizeof(DmacDescriptor));
+        ZeroRegs__captureDmacDescriptor(dmac.DESC[id], head);
+        ZeroRegs__captureDmacDescriptor(dmac.WRB[id], ZeroRegs__dmacDescriptor(dmac.WRBADDR.reg + id * sizeof(DmacDescriptor)));
+        ZeroRegs__captureDmacChain(dmac, id, head);
+    }
+
+    // CHID is also used by the sketch (and its interrupt handlers) so put it
+    // back once we're done
+    // (and keep its interrupt handlers from changing it underneath us)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint8_t chid = DMAC->CHID.reg;
+    //FUTURE -- find macro for number of channels
+    // (though all configurations in [table 2-1 DSrevF] have 12)
+    for (uint8_t id = 0; id < 12; id++) {
+        if (!ZeroRegs__select(&DMAC->CHID.reg, id, DMAC_CHID_ID_Msk, NULL, 0)) {
+            dmac.CHCTRLA[id].reg = 0;
+            dmac.CHCTRLB[id].reg = 0;
+            continue;
+        }
+        while (DMAC->CHCTRLA.bit.SWRST) {}
+        dmac.CHCTRLA[id].reg = DMAC->CHCTRLA.reg;
+        dmac.CHCTRLB[id].reg = DMAC->CHCTRLB.reg;
+    }
+    DMAC->CHID.reg = chid;
+    __set_PRIMASK(primask);
+}
+
+static const char* const ZeroRegsDMAC_EVACTs[] = {
+    "NOACT", "TRIG", "CTRIG", "CBLOCK", "SUSPEND", "RESUME", "SSKIP",
+};
+static const char* const ZeroRegsDMAC_TRIGSRCs[] = {
+    "DISABLE",             // 0x00
+    "SERCOM0:RX",          // 0x01
+    "SERCOM0:TX",          // 0x02
+    "SERCOM1:RX",          // 0x03
+    "SERCOM1:TX",          // 0x04
+    "SERCOM2:RX",          // 0x05
+    "SERCOM2:TX",          // 0x06
+    "SERCOM3:RX",          // 0x07
+    "SERCOM3:TX",          // 0x08
+    "SERCOM4:RX",          // 0x09
+    "SERCOM4:TX",          // 0x0A
+    "SERCOM5:RX",          // 0x0B
+    "SERCOM5:TX",          // 0x0C
+    "TCC0:OVF",            // 0x0D
+    "TCC0:MC0",            // 0x0E
+    "TCC0:MC1",            // 0x0F
+    "TCC0:MC2",            // 0x10
+    "TCC0:MC3",            // 0x11
+    "TCC1:OVF",            // 0x12
+    "TCC1:MC0",            // 0x13
+    "TCC1:MC1",            // 0x14
+    "TCC2:OVF",            // 0x15
+    "TCC2:MC0",            // 0x16
+    "TCC2:MC1",            // 0x17
+    "TC3:OVF",             // 0x18
+    "TC3:MC0",             // 0x19
+    "TC3:MC1",             // 0x1A
+    "TC4:OVF",             // 0x1B
+    "TC4:MC0",             // 0x1C
+    "TC4:MC1",             // 0x1D
+    "TC5:OVF",             // 0x1E
+    "TC5:MC0",             // 0x1F
+    "TC5:MC1",             // 0x20
+    "TC6:OVF",             // 0x21
+    "TC6:MC0",             // 0x22
+    "TC6:MC1",             // 0x23
+    "TC7:OVF",             // 0x24
+    "TC7:MC0",             // 0x25
+    "TC7:MC1",             // 0x26
+    "ADC:RESRDY",          // 0x27
+    "DAC:EMPTY",           // 0x28
+    "I2S:RX0",             // 0x29
+    "I2S:RX1",             // 0x2A
+    "I2S:TX0",             // 0x2B
+    "I2S:TX1",             // 0x2C
+    "TCC3:OVF",            // 0x2D
+    "TCC3:MC0",            // 0x2E
+    "TCC3:MC1",            // 0x2F
+    "TCC3:MC2",            // 0x30
+    "TCC3:MC3",            // 0x31
+};
+static const char* const ZeroRegsDMAC_EVOSELs[] = {
+    "DISABLE", "BLOCK", ZeroRegs__RESERVED, "BEAT",
+};
+static const char* const ZeroRegsDMAC_BLOCKACTs[] = {
+    "NOACT", "INT", "SUSPEND", "BOTH",
+};
+static const char* const ZeroRegsDMAC_BEATSIZEs[] = {
+    "BYTE", "HWORD", "WORD",
+};
+static const char* const ZeroRegsDMAC_TRIGACTs[] = {
+    "BLOCK", ZeroRegs__RESERVED, "BURST", "TRANS",
+};
+static const char* const ZeroRegsDMAC_STEPSIZEs[] = {
+    "X1", "X2", "X4", "X8", "X16", "X32", "X64", "X128",
+};
+static void ZeroRegs__printDmacDescriptor(ZeroRegOptions &opts, const ZeroRegSnapshot_DMAC_Descriptor &desc) {
+    PRINTFLAG(desc.BTCTRL, VALID);
+    opts.out.print(" evosel=");
+    PRINTNAME(ZeroRegsDMAC_EVOSELs, desc.BTCTRL.bit.EVOSEL, ZeroRegs__RESERVED);
+    opts.out.print(" blockact=");
+    PRINTNAME(ZeroRegsDMAC_BLOCKACTs, desc.BTCTRL.bit.BLOCKACT, ZeroRegs__RESERVED);
+    opts.out.print(" beatsize=");
+    PRINTNAME(ZeroRegsDMAC_BEATSIZEs, desc.BTCTRL.bit.BEATSIZE, ZeroRegs__RESERVED);
+    PRINTFLAG(desc.BTCTRL, SRCINC);
+    PRINTFLAG(desc.BTCTRL, DSTINC);
+    if (desc.BTCTRL.bit.SRCINC || desc.BTCTRL.bit.DSTINC) {
+        opts.out.print(" stepsel=");
+        opts.out.print(desc.BTCTRL.bit.STEPSEL ? "SRC" : "DST");
+        opts.out.print(" stepsize=");
+        PRINTNAME(ZeroRegsDMAC_STEPSIZEs, desc.BTCTRL.bit.STEPSIZE, ZeroRegs__RESERVED);
+    }
+    opts.out.print(" BTCNT=");
+    opts.out.print(desc.BTCNT.reg);
+    opts.out.print(" SRCADDR=");
+    PRINTHEX(desc.SRCADDR.reg);
+    opts.out.print(" DSTADDR=");
+    PRINTHEX(desc.DSTADDR.reg);
+    opts.out.print(" DESCADDR=");
+    PRINTHEX(desc.DESCADDR.reg);
+}
+
+// Prints how many bytes move on each trigger, in all (once through the
+// descriptors), and how many are left according to the write-back
+// descriptor.
+static void ZeroRegs__printDmacTransfer(ZeroRegOptions &opts, const ZeroRegSnapshot_DMAC &dmac, uint8_t id) {
+    const ZeroRegSnapshot_DMAC_Descriptor &desc = dmac.DESC[id];
+    uint32_t beat = 1 << desc.BTCTRL.bit.BEATSIZE;
+    opts.out.print("transfer");
+    PRINTPAD2(id);
+    opts.out.print(":  trigger=");
+    switch (dmac.CHCTRLB[id].bit.TRIGACT) {
+        case 0x0: opts.out.print((uint32_t)desc.BTCNT.reg * beat); break;
+        case 0x2: opts.out.print(beat); break;
+        case 0x3: opts.out.print(dmac.BYTES[id]); break;
+        default: opts.out.print(ZeroRegs__UNKNOWN); break;
+    }
+    opts.out.print("bytes total=");
+    opts.out.print(dmac.BYTES[id]);
+    opts.out.print("bytes links=");
+    opts.out.print(dmac.LINKS[id]);
+    if (dmac.LOOPS & (1 << id)) {
+        opts.out.print(" (loops)");
+    }
+    // the write-back descriptor is only written once the channel has started
+    if (dmac.WRB[id].BTCTRL.bit.VALID) {
+        opts.out.print(" remaining=");
+        opts.out.print((uint32_t)dmac.WRB[id].BTCNT.reg << dmac.WRB[id].BTCTRL.bit.BEATSIZE);
+        opts.out.print("bytes");
+    }
+    PRINTNL();
+}
+
+void printZeroRegDMAC(ZeroRegOptions &opts, const ZeroRegSnapshot_DMAC &dmac) {
+    if (!dmac.CTRL.bit.DMAENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- DMAC");
 
     opts.out.print("CTRL: ");
-    PRINTFLAG(DMAC->CTRL, DMAENABLE);
-    PRINTFLAG(DMAC->CTRL, CRCENABLE);
-    PRINTFLAG(DMAC->CTRL, LVLEN0);
-    PRINTFLAG(DMAC->CTRL, LVLEN1);
-    PRINTFLAG(DMAC->CTRL, LVLEN2);
-    PRINTFLAG(DMAC->CTRL, LVLEN3);
+    PRINTFLAG(dmac.CTRL, DMAENABLE);
+    PRINTFLAG(dmac.CTRL, CRCENABLE);
+    PRINTFLAG(dmac.CTRL, LVLEN0);
+    PRINTFLAG(dmac.CTRL, LVLEN1);
+    PRINTFLAG(dmac.CTRL, LVLEN2);
+    PRINTFLAG(dmac.CTRL, LVLEN3);
     PRINTNL();
 
     opts.out.print("CRCCTRL:  CRCBEATSIZE=");
-    PRINTHEX(DMAC->CRCCTRL.bit.CRCBEATSIZE);
+    PRINTHEX(dmac.CRCCTRL.bit.CRCBEATSIZE);
     opts.out.print(" CRCPOLY=");
-    PRINTHEX(DMAC->CRCCTRL.bit.CRCPOLY);
+    PRINTHEX(dmac.CRCCTRL.bit.CRCPOLY);
     opts.out.print(" CRCSRC=");
-    PRINTHEX(DMAC->CRCCTRL.bit.CRCSRC);
+    PRINTHEX(dmac.CRCCTRL.bit.CRCSRC);
     PRINTNL();
 
     opts.out.print("QOSCTRL:  wrbqos=");
-    printZeroReg_QOS(opts, DMAC->QOSCTRL.bit.WRBQOS);
+    printZeroReg_QOS(opts, dmac.QOSCTRL.bit.WRBQOS);
     opts.out.print(" fqos=");
-    printZeroReg_QOS(opts, DMAC->QOSCTRL.bit.FQOS);
+    printZeroReg_QOS(opts, dmac.QOSCTRL.bit.FQOS);
     opts.out.print(" dqos=");
-    printZeroReg_QOS(opts, DMAC->QOSCTRL.bit.DQOS);
+    printZeroReg_QOS(opts, dmac.QOSCTRL.bit.DQOS);
+    PRINTNL();
+
+    opts.out.print("BASEADDR:  ");
+    PRINTHEX(dmac.BASEADDR.reg);
+    PRINTNL();
+
+    opts.out.print("WRBADDR:  ");
+    PRINTHEX(dmac.WRBADDR.reg);
     PRINTNL();
 
     opts.out.print("PRICTRL0: ");
     for (uint8_t lvl = 0; lvl < 4; lvl++) {
         ZeroRegsDMAC_PRILVL pri;
-        pri.reg = (DMAC->PRICTRL0.reg >> (8 * lvl)) & 0xFF;
+        pri.reg = (dmac.PRICTRL0.reg >> (8 * lvl)) & 0xFF;
         opts.out.print(" lvl");
         opts.out.print(lvl);
         opts.out.print(":");
@@ -384,128 +1083,74 @@ void printZeroRegDMAC(ZeroRegOptions &opts) {
     }
     PRINTNL();
 
-    //FUTURE -- find macro for number of channels
-    // (though all configurations in [table 2-1 DSrevF] have 12)
     for (uint8_t id = 0; id < 12; id++) {
-        DMAC->CHID.bit.ID = id;
-        //FUTURE -- DSrevF suggests that no delay is necessary
-        delay(1);
-        while (DMAC->CHCTRLA.bit.SWRST) {}
-        if (!DMAC->CHCTRLA.bit.ENABLE && !opts.showDisabled) {
+        if (!dmac.CHCTRLA[id].bit.ENABLE && !opts.showDisabled) {
             continue;
         }
         opts.out.print("CHANNEL");
         PRINTPAD2(id);
         opts.out.print(": ");
-        PRINTFLAG(DMAC->CHCTRLA, ENABLE);
-        if (DMAC->CHCTRLB.bit.EVIE) {
+        PRINTFLAG(dmac.CHCTRLA[id], ENABLE);
+        if (dmac.CHCTRLB[id].bit.EVIE) {
             opts.out.print(" EVIE evact=");
-            switch (DMAC->CHCTRLB.bit.EVACT) {
-                case 0x0: opts.out.print("NOACT"); break;
-                case 0x1: opts.out.print("TRIG"); break;
-                case 0x2: opts.out.print("CTRIG"); break;
-                case 0x3: opts.out.print("CBLOCK"); break;
-                case 0x4: opts.out.print("SUSPEND"); break;
-                case 0x5: opts.out.print("RESUME"); break;
-                case 0x6: opts.out.print("SSKIP"); break;
-                default: opts.out.print(ZeroRegs__RESERVED); break;
-            }
+            PRINTNAME(ZeroRegsDMAC_EVACTs, dmac.CHCTRLB[id].bit.EVACT, ZeroRegs__RESERVED);
         }
 
-        PRINTFLAG(DMAC->CHCTRLB, EVOE);
+        PRINTFLAG(dmac.CHCTRLB[id], EVOE);
         opts.out.print(" lvl=LVL");
-        opts.out.print(DMAC->CHCTRLB.bit.LVL);
+        opts.out.print(dmac.CHCTRLB[id].bit.LVL);
         opts.out.print(" trigsrc=");
-        switch (DMAC->CHCTRLB.bit.TRIGSRC) {
-            case 0x00: opts.out.print("DISABLE"); break;
-            case 0x01: opts.out.print("SERCOM0:RX"); break;
-            case 0x02: opts.out.print("SERCOM0:TX"); break;
-            case 0x03: opts.out.print("SERCOM1:RX"); break;
-            case 0x04: opts.out.print("SERCOM1:TX"); break;
-            case 0x05: opts.out.print("SERCOM2:RX"); break;
-            case 0x06: opts.out.print("SERCOM2:TX"); break;
-            case 0x07: opts.out.print("SERCOM3:RX"); break;
-            case 0x08: opts.out.print("SERCOM3:TX"); break;
-            case 0x09: opts.out.print("SERCOM4:RX"); break;
-            case 0x0A: opts.out.print("SERCOM4:TX"); break;
-            case 0x0B: opts.out.print("SERCOM5:RX"); break;
-            case 0x0C: opts.out.print("SERCOM5:TX"); break;
-            case 0x0D: opts.out.print("TCC0:OVF"); break;
-            case 0x0E: opts.out.print("TCC0:MC0"); break;
-            case 0x0F: opts.out.print("TCC0:MC1"); break;
-            case 0x10: opts.out.print("TCC0:MC2"); break;
-            case 0x11: opts.out.print("TCC0:MC3"); break;
-            case 0x12: opts.out.print("TCC1:OVF"); break;
-            case 0x13: opts.out.print("TCC1:MC0"); break;
-            case 0x14: opts.out.print("TCC1:MC0"); break;
-            case 0x15: opts.out.print("TCC2:OVF"); break;
-            case 0x16: opts.out.print("TCC2:MC0"); break;
-            case 0x17: opts.out.print("TCC2:MC1"); break;
-            case 0x18: opts.out.print("TC3:OVF"); break;
-            case 0x19: opts.out.print("TC3:MC0"); break;
-            case 0x1A: opts.out.print("TC3:MC1"); break;
-            case 0x1B: opts.out.print("TC4:OVF"); break;
-            case 0x1C: opts.out.print("TC4:MC0"); break;
-            case 0x1D: opts.out.print("TC4:MC1"); break;
-            case 0x1E: opts.out.print("TC5:OVF"); break;
-            case 0x1F: opts.out.print("TC5:MC0"); break;
-            case 0x20: opts.out.print("TC5:MC1"); break;
-            case 0x21: opts.out.print("TC6:OVF"); break;
-            case 0x22: opts.out.print("TC6:MC0"); break;
-            case 0x23: opts.out.print("TC6:MC1"); break;
-            case 0x24: opts.out.print("TC7:OVF"); break;
-            case 0x25: opts.out.print("TC7:MC0"); break;
-            case 0x26: opts.out.print("TC7:MC1"); break;
-            case 0x27: opts.out.print("ADC:RESRDY"); break;
-            case 0x28: opts.out.print("DAC:EMPTY"); break;
-            case 0x29: opts.out.print("I2S:RX0"); break;
-            case 0x2A: opts.out.print("I2S:RX1"); break;
-            case 0x2B: opts.out.print("I2S:TX0"); break;
-            case 0x2C: opts.out.print("I2S:TX1"); break;
-            case 0x2D: opts.out.print("TCC3:OVF"); break;
-            case 0x2E: opts.out.print("TCC3:MC0"); break;
-            case 0x2F: opts.out.print("TCC3:MC1"); break;
-            case 0x30: opts.out.print("TCC3:MC2"); break;
-            case 0x31: opts.out.print("TCC3:MC3"); break;
-            default: opts.out.print(ZeroRegs__UNKNOWN); break;
-        }
+        PRINTNAME(ZeroRegsDMAC_TRIGSRCs, dmac.CHCTRLB[id].bit.TRIGSRC, ZeroRegs__UNKNOWN);
         opts.out.print(" trigact=");
-        switch (DMAC->CHCTRLB.bit.TRIGACT) {
-            case 0x0: opts.out.print("BLOCK"); break;
-            /*case 0x1*/
-            case 0x2: opts.out.print("BURST"); break;
-            case 0x3: opts.out.print("TRANS"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
+        PRINTNAME(ZeroRegsDMAC_TRIGACTs, dmac.CHCTRLB[id].bit.TRIGACT, ZeroRegs__RESERVED);
+        PRINTNL();
+
+        if (!dmac.LINKS[id]) {
+            continue;
         }
+        opts.out.print("DESC");
+        PRINTPAD2(id);
+        opts.out.print(": ");
+        ZeroRegs__printDmacDescriptor(opts, dmac.DESC[id]);
         PRINTNL();
+        ZeroRegs__printDmacTransfer(opts, dmac, id);
     }
+}
 
-    //FUTURE -- show DmacDescriptors?
+void printZeroRegDMAC(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_DMAC dmac;
+    captureZeroRegDMAC(dmac);
+    printZeroRegDMAC(opts, dmac);
 }
 
 
+static const char* const ZeroRegsEIC_SENSEs[] = {
+    "none", "RISE", "FALL", "BOTH", "HIGH", "LOW",
+};
 void printZeroRegEIC_SENSE(ZeroRegOptions &opts, uint8_t sense) {
-    switch (sense) {
-        case 0x0: opts.out.print("none"); break;
-        case 0x1: opts.out.print("RISE"); break;
-        case 0x2: opts.out.print("FALL"); break;
-        case 0x3: opts.out.print("BOTH"); break;
-        case 0x4: opts.out.print("HIGH"); break;
-        case 0x5: opts.out.print("LOW"); break;
-    }
+    PRINTNAME(ZeroRegsEIC_SENSEs, sense, ZeroRegs__empty);
 }
 
-void printZeroRegEIC(ZeroRegOptions &opts) {
+void captureZeroRegEIC(ZeroRegSnapshot_EIC &eic) {
     while (EIC->CTRL.bit.SWRST || EIC->STATUS.bit.SYNCBUSY) {}
-    if (!EIC->CTRL.bit.ENABLE && !opts.showDisabled) {
+    eic.CTRL.reg = EIC->CTRL.reg;
+    eic.NMICTRL.reg = EIC->NMICTRL.reg;
+    eic.EVCTRL.reg = EIC->EVCTRL.reg;
+    eic.WAKEUP.reg = EIC->WAKEUP.reg;
+    eic.CONFIG[0].reg = EIC->CONFIG[0].reg;
+    eic.CONFIG[1].reg = EIC->CONFIG[1].reg;
+}
+
+void printZeroRegEIC(ZeroRegOptions &opts, const ZeroRegSnapshot_EIC &eic) {
+    if (!eic.CTRL.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- EIC");
 
-    if (EIC->NMICTRL.bit.NMISENSE) {
+    if (eic.NMICTRL.bit.NMISENSE) {
         opts.out.print("NMI:  sense=");
-        printZeroRegEIC_SENSE(opts, EIC->NMICTRL.bit.NMISENSE);
-        if (EIC->NMICTRL.bit.NMIFILTEN) {
+        printZeroRegEIC_SENSE(opts, eic.NMICTRL.bit.NMISENSE);
+        if (eic.NMICTRL.bit.NMIFILTEN) {
             opts.out.print(" FILTEN");
         }
         PRINTNL();
@@ -518,7 +1163,7 @@ void printZeroRegEIC(ZeroRegOptions &opts) {
     for (uint8_t extint = 0; extint < 18; extint++) {
         uint8_t cfg = extint / 8;
         uint8_t pos = (extint % 8) * 4;
-        uint32_t entry = 0xF & (EIC->CONFIG[cfg].reg >> pos);
+        uint32_t entry = 0xF & (eic.CONFIG[cfg].reg >> pos);
         if (!opts.showDisabled && (entry & 0x7) == 0) {
             continue;
         }
@@ -529,203 +1174,249 @@ void printZeroRegEIC(ZeroRegOptions &opts) {
         if (entry & 0x8) {
             opts.out.print(" FILTEN");
         }
-        if (EIC->EVCTRL.vec.EXTINTEO & (1 << extint)) {
+        if (eic.EVCTRL.vec.EXTINTEO & (1 << extint)) {
             opts.out.print(" EXTINTEO");
         }
-        if (EIC->WAKEUP.vec.WAKEUPEN & (1 << extint)) {
+        if (eic.WAKEUP.vec.WAKEUPEN & (1 << extint)) {
             opts.out.print(" WAKEUP");
         }
         PRINTNL();
     }
 }
 
+void printZeroRegEIC(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_EIC eic;
+    captureZeroRegEIC(eic);
+    printZeroRegEIC(opts, eic);
+}
 
-static const char* ZeroRegsEVSYS_EVGEN00 = "NONE";
-static const char* ZeroRegsEVSYS_EVGEN01 = "RTC:CMP0";
-static const char* ZeroRegsEVSYS_EVGEN02 = "RTC:CMP1";
-static const char* ZeroRegsEVSYS_EVGEN03 = "RTC:OVF";
-static const char* ZeroRegsEVSYS_EVGEN04 = "RTC:PER0";
-static const char* ZeroRegsEVSYS_EVGEN05 = "RTC:PER1";
-static const char* ZeroRegsEVSYS_EVGEN06 = "RTC:PER2";
-static const char* ZeroRegsEVSYS_EVGEN07 = "RTC:PER3";
-static const char* ZeroRegsEVSYS_EVGEN08 = "RTC:PER4";
-static const char* ZeroRegsEVSYS_EVGEN09 = "RTC:PER5";
-static const char* ZeroRegsEVSYS_EVGEN0A = "RTC:PER6";
-static const char* ZeroRegsEVSYS_EVGEN0B = "RTC:PER7";
-static const char* ZeroRegsEVSYS_EVGEN0C = "EIC:0";
-static const char* ZeroRegsEVSYS_EVGEN0D = "EIC:1";
-static const char* ZeroRegsEVSYS_EVGEN0E = "EIC:2";
-static const char* ZeroRegsEVSYS_EVGEN0F = "EIC:3";
-static const char* ZeroRegsEVSYS_EVGEN10 = "EIC:4";
-static const char* ZeroRegsEVSYS_EVGEN11 = "EIC:5";
-static const char* ZeroRegsEVSYS_EVGEN12 = "EIC:6";
-static const char* ZeroRegsEVSYS_EVGEN13 = "EIC:7";
-static const char* ZeroRegsEVSYS_EVGEN14 = "EIC:8";
-static const char* ZeroRegsEVSYS_EVGEN15 = "EIC:9";
-static const char* ZeroRegsEVSYS_EVGEN16 = "EIC:10";
-static const char* ZeroRegsEVSYS_EVGEN17 = "EIC:11";
-static const char* ZeroRegsEVSYS_EVGEN18 = "EIC:12";
-static const char* ZeroRegsEVSYS_EVGEN19 = "EIC:13";
-static const char* ZeroRegsEVSYS_EVGEN1A = "EIC:14";
-static const char* ZeroRegsEVSYS_EVGEN1B = "EIC:15";
-static const char* ZeroRegsEVSYS_EVGEN1C = ZeroRegs__RESERVED;
-static const char* ZeroRegsEVSYS_EVGEN1D = ZeroRegs__RESERVED;
-static const char* ZeroRegsEVSYS_EVGEN1E = "DMAC:0";
-static const char* ZeroRegsEVSYS_EVGEN1F = "DMAC:1";
-static const char* ZeroRegsEVSYS_EVGEN20 = "DMAC:2";
-static const char* ZeroRegsEVSYS_EVGEN21 = "DMAC:3";
-static const char* ZeroRegsEVSYS_EVGEN22 = "TCC0:OVF";
-static const char* ZeroRegsEVSYS_EVGEN23 = "TCC0:TRG";
-static const char* ZeroRegsEVSYS_EVGEN24 = "TCC0:CNT";
-static const char* ZeroRegsEVSYS_EVGEN25 = "TCC0:MC0";
-static const char* ZeroRegsEVSYS_EVGEN26 = "TCC0:MC1";
-static const char* ZeroRegsEVSYS_EVGEN27 = "TCC0:MC2";
-static const char* ZeroRegsEVSYS_EVGEN28 = "TCC0:MC3";
-static const char* ZeroRegsEVSYS_EVGEN29 = "TCC1:OVF";
-static const char* ZeroRegsEVSYS_EVGEN2A = "TCC1:TRG";
-static const char* ZeroRegsEVSYS_EVGEN2B = "TCC1:CNT";
-static const char* ZeroRegsEVSYS_EVGEN2C = "TCC1:MC0";
-static const char* ZeroRegsEVSYS_EVGEN2D = "TCC1:MC1";
-static const char* ZeroRegsEVSYS_EVGEN2E = "TCC2:OVF";
-static const char* ZeroRegsEVSYS_EVGEN2F = "TCC2:TRG";
-static const char* ZeroRegsEVSYS_EVGEN30 = "TCC2:CNT";
-static const char* ZeroRegsEVSYS_EVGEN31 = "TCC2:MC0";
-static const char* ZeroRegsEVSYS_EVGEN32 = "TCC2:MC1";
-static const char* ZeroRegsEVSYS_EVGEN33 = "TC3:OVF";
-static const char* ZeroRegsEVSYS_EVGEN34 = "TC3:MC0";
-static const char* ZeroRegsEVSYS_EVGEN35 = "TC3:MC1";
-static const char* ZeroRegsEVSYS_EVGEN36 = "TC4:OVF";
-static const char* ZeroRegsEVSYS_EVGEN37 = "TC4:MC0";
-static const char* ZeroRegsEVSYS_EVGEN38 = "TC4:MC1";
-static const char* ZeroRegsEVSYS_EVGEN39 = "TC5:OVF";
-static const char* ZeroRegsEVSYS_EVGEN3A = "TC5:MC0";
-static const char* ZeroRegsEVSYS_EVGEN3B = "TC5:MC1";
-static const char* ZeroRegsEVSYS_EVGEN3C = "TC6:OVF";
-static const char* ZeroRegsEVSYS_EVGEN3D = "TC6:MC0";
-static const char* ZeroRegsEVSYS_EVGEN3E = "TC6:MC1";
-static const char* ZeroRegsEVSYS_EVGEN3F = "TC7:OVF";
-static const char* ZeroRegsEVSYS_EVGEN40 = "TC7:MC0";
-static const char* ZeroRegsEVSYS_EVGEN41 = "TC7:MC1";
-static const char* ZeroRegsEVSYS_EVGEN42 = "ADC:RESRDY";
-static const char* ZeroRegsEVSYS_EVGEN43 = "ADC:WINMON";
-static const char* ZeroRegsEVSYS_EVGEN44 = "AC:COMP0";
-static const char* ZeroRegsEVSYS_EVGEN45 = "AC:COMP1";
-static const char* ZeroRegsEVSYS_EVGEN46 = "AC:WIN0";
-static const char* ZeroRegsEVSYS_EVGEN47 = "DAC:EMPTY";
-static const char* ZeroRegsEVSYS_EVGEN48 = "PTC:EOC";
-static const char* ZeroRegsEVSYS_EVGEN49 = "PTC:WCOMP";
-static const char* ZeroRegsEVSYS_EVGEN4A = "AC:COMP2";
-static const char* ZeroRegsEVSYS_EVGEN4B = "AC:COMP3";
-static const char* ZeroRegsEVSYS_EVGEN4C = "AC:WIN1";
-static const char* ZeroRegsEVSYS_EVGEN4D = "TCC3:OVF";
-static const char* ZeroRegsEVSYS_EVGEN4E = "TCC3:TRG";
-static const char* ZeroRegsEVSYS_EVGEN4F = "TCC3:CNT";
-static const char* ZeroRegsEVSYS_EVGEN50 = "TCC3:MC0";
-static const char* ZeroRegsEVSYS_EVGEN51 = "TCC3:MC1";
-static const char* ZeroRegsEVSYS_EVGEN52 = "TCC3:MC2";
-static const char* ZeroRegsEVSYS_EVGEN53 = "TCC3:MC3";
-static const char* ZeroRegsEVSYS_EVGENs[] = {
+
+static const char ZeroRegsEVSYS_EVGEN00[] = "NONE";
+static const char ZeroRegsEVSYS_EVGEN01[] = "RTC:CMP0";
+static const char ZeroRegsEVSYS_EVGEN02[] = "RTC:CMP1";
+static const char ZeroRegsEVSYS_EVGEN03[] = "RTC:OVF";
+static const char ZeroRegsEVSYS_EVGEN04[] = "RTC:PER0";
+static const char ZeroRegsEVSYS_EVGEN05[] = "RTC:PER1";
+static const char ZeroRegsEVSYS_EVGEN06[] = "RTC:PER2";
+static const char ZeroRegsEVSYS_EVGEN07[] = "RTC:PER3";
+static const char ZeroRegsEVSYS_EVGEN08[] = "RTC:PER4";
+static const char ZeroRegsEVSYS_EVGEN09[] = "RTC:PER5";
+static const char ZeroRegsEVSYS_EVGEN0A[] = "RTC:PER6";
+static const char ZeroRegsEVSYS_EVGEN0B[] = "RTC:PER7";
+static const char ZeroRegsEVSYS_EVGEN0C[] = "EIC:0";
+static const char ZeroRegsEVSYS_EVGEN0D[] = "EIC:1";
+static const char ZeroRegsEVSYS_EVGEN0E[] = "EIC:2";
+static const char ZeroRegsEVSYS_EVGEN0F[] = "EIC:3";
+static const char ZeroRegsEVSYS_EVGEN10[] = "EIC:4";
+static const char ZeroRegsEVSYS_EVGEN11[] = "EIC:5";
+static const char ZeroRegsEVSYS_EVGEN12[] = "EIC:6";
+static const char ZeroRegsEVSYS_EVGEN13[] = "EIC:7";
+static const char ZeroRegsEVSYS_EVGEN14[] = "EIC:8";
+static const char ZeroRegsEVSYS_EVGEN15[] = "EIC:9";
+static const char ZeroRegsEVSYS_EVGEN16[] = "EIC:10";
+static const char ZeroRegsEVSYS_EVGEN17[] = "EIC:11";
+static const char ZeroRegsEVSYS_EVGEN18[] = "EIC:12";
+static const char ZeroRegsEVSYS_EVGEN19[] = "EIC:13";
+static const char ZeroRegsEVSYS_EVGEN1A[] = "EIC:14";
+static const char ZeroRegsEVSYS_EVGEN1B[] = "EIC:15";
+static const char ZeroRegsEVSYS_EVGEN1E[] = "DMAC:0";
+static const char ZeroRegsEVSYS_EVGEN1F[] = "DMAC:1";
+static const char ZeroRegsEVSYS_EVGEN20[] = "DMAC:2";
+static const char ZeroRegsEVSYS_EVGEN21[] = "DMAC:3";
+static const char ZeroRegsEVSYS_EVGEN22[] = "TCC0:OVF";
+static const char ZeroRegsEVSYS_EVGEN23[] = "TCC0:TRG";
+static const char ZeroRegsEVSYS_EVGEN24[] = "TCC0:CNT";
+static const char ZeroRegsEVSYS_EVGEN25[] = "TCC0:MC0";
+static const char ZeroRegsEVSYS_EVGEN26[] = "TCC0:MC1";
+static const char ZeroRegsEVSYS_EVGEN27[] = "TCC0:MC2";
+static const char ZeroRegsEVSYS_EVGEN28[] = "TCC0:MC3";
+static const char ZeroRegsEVSYS_EVGEN29[] = "TCC1:OVF";
+static const char ZeroRegsEVSYS_EVGEN2A[] = "TCC1:TRG";
+static const char ZeroRegsEVSYS_EVGEN2B[] = "TCC1:CNT";
+static const char ZeroRegsEVSYS_EVGEN2C[] = "TCC1:MC0";
+static const char ZeroRegsEVSYS_EVGEN2D[] = "TCC1:MC1";
+static const char ZeroRegsEVSYS_EVGEN2E[] = "TCC2:OVF";
+static const char ZeroRegsEVSYS_EVGEN2F[] = "TCC2:TRG";
+static const char ZeroRegsEVSYS_EVGEN30[] = "TCC2:CNT";
+static const char ZeroRegsEVSYS_EVGEN31[] = "TCC2:MC0";
+static const char ZeroRegsEVSYS_EVGEN32[] = "TCC2:MC1";
+static const char ZeroRegsEVSYS_EVGEN33[] = "TC3:OVF";
+static const char ZeroRegsEVSYS_EVGEN34[] = "TC3:MC0";
+static const char ZeroRegsEVSYS_EVGEN35[] = "TC3:MC1";
+static const char ZeroRegsEVSYS_EVGEN36[] = "TC4:OVF";
+static const char ZeroRegsEVSYS_EVGEN37[] = "TC4:MC0";
+static const char ZeroRegsEVSYS_EVGEN38[] = "TC4:MC1";
+static const char ZeroRegsEVSYS_EVGEN39[] = "TC5:OVF";
+static const char ZeroRegsEVSYS_EVGEN3A[] = "TC5:MC0";
+static const char ZeroRegsEVSYS_EVGEN3B[] = "TC5:MC1";
+static const char ZeroRegsEVSYS_EVGEN3C[] = "TC6:OVF";
+static const char ZeroRegsEVSYS_EVGEN3D[] = "TC6:MC0";
+static const char ZeroRegsEVSYS_EVGEN3E[] = "TC6:MC1";
+static const char ZeroRegsEVSYS_EVGEN3F[] = "TC7:OVF";
+static const char ZeroRegsEVSYS_EVGEN40[] = "TC7:MC0";
+static const char ZeroRegsEVSYS_EVGEN41[] = "TC7:MC1";
+static const char ZeroRegsEVSYS_EVGEN42[] = "ADC:RESRDY";
+static const char ZeroRegsEVSYS_EVGEN43[] = "ADC:WINMON";
+static const char ZeroRegsEVSYS_EVGEN44[] = "AC:COMP0";
+static const char ZeroRegsEVSYS_EVGEN45[] = "AC:COMP1";
+static const char ZeroRegsEVSYS_EVGEN46[] = "AC:WIN0";
+static const char ZeroRegsEVSYS_EVGEN47[] = "DAC:EMPTY";
+static const char ZeroRegsEVSYS_EVGEN48[] = "PTC:EOC";
+static const char ZeroRegsEVSYS_EVGEN49[] = "PTC:WCOMP";
+static const char ZeroRegsEVSYS_EVGEN4A[] = "AC:COMP2";
+static const char ZeroRegsEVSYS_EVGEN4B[] = "AC:COMP3";
+static const char ZeroRegsEVSYS_EVGEN4C[] = "AC:WIN1";
+static const char ZeroRegsEVSYS_EVGEN4D[] = "TCC3:OVF";
+static const char ZeroRegsEVSYS_EVGEN4E[] = "TCC3:TRG";
+static const char ZeroRegsEVSYS_EVGEN4F[] = "TCC3:CNT";
+static const char ZeroRegsEVSYS_EVGEN50[] = "TCC3:MC0";
+static const char ZeroRegsEVSYS_EVGEN51[] = "TCC3:MC1";
+static const char ZeroRegsEVSYS_EVGEN52[] = "TCC3:MC2";
+static const char ZeroRegsEVSYS_EVGEN53[] = "TCC3:MC3";
+static const char* const ZeroRegsEVSYS_EVGENs[] = {
     ZeroRegsEVSYS_EVGEN00, ZeroRegsEVSYS_EVGEN01, ZeroRegsEVSYS_EVGEN02, ZeroRegsEVSYS_EVGEN03, ZeroRegsEVSYS_EVGEN04, ZeroRegsEVSYS_EVGEN05, ZeroRegsEVSYS_EVGEN06, ZeroRegsEVSYS_EVGEN07, ZeroRegsEVSYS_EVGEN08, ZeroRegsEVSYS_EVGEN09, ZeroRegsEVSYS_EVGEN0A, ZeroRegsEVSYS_EVGEN0B, ZeroRegsEVSYS_EVGEN0C, ZeroRegsEVSYS_EVGEN0D, ZeroRegsEVSYS_EVGEN0E, ZeroRegsEVSYS_EVGEN0F ,
-    ZeroRegsEVSYS_EVGEN10, ZeroRegsEVSYS_EVGEN11, ZeroRegsEVSYS_EVGEN12, ZeroRegsEVSYS_EVGEN13, ZeroRegsEVSYS_EVGEN14, ZeroRegsEVSYS_EVGEN15, ZeroRegsEVSYS_EVGEN16, ZeroRegsEVSYS_EVGEN17, ZeroRegsEVSYS_EVGEN18, ZeroRegsEVSYS_EVGEN19, ZeroRegsEVSYS_EVGEN1A, ZeroRegsEVSYS_EVGEN1B, ZeroRegsEVSYS_EVGEN1C, ZeroRegsEVSYS_EVGEN1D, ZeroRegsEVSYS_EVGEN1E, ZeroRegsEVSYS_EVGEN1F,
+    ZeroRegsEVSYS_EVGEN10, ZeroRegsEVSYS_EVGEN11, ZeroRegsEVSYS_EVGEN12, ZeroRegsEVSYS_EVGEN13, ZeroRegsEVSYS_EVGEN14, ZeroRegsEVSYS_EVGEN15, ZeroRegsEVSYS_EVGEN16, ZeroRegsEVSYS_EVGEN17, ZeroRegsEVSYS_EVGEN18, ZeroRegsEVSYS_EVGEN19, ZeroRegsEVSYS_EVGEN1A, ZeroRegsEVSYS_EVGEN1B, ZeroRegs__RESERVED, ZeroRegs__RESERVED, ZeroRegsEVSYS_EVGEN1E, ZeroRegsEVSYS_EVGEN1F,
     ZeroRegsEVSYS_EVGEN20, ZeroRegsEVSYS_EVGEN21, ZeroRegsEVSYS_EVGEN22, ZeroRegsEVSYS_EVGEN23, ZeroRegsEVSYS_EVGEN24, ZeroRegsEVSYS_EVGEN25, ZeroRegsEVSYS_EVGEN26, ZeroRegsEVSYS_EVGEN27, ZeroRegsEVSYS_EVGEN28, ZeroRegsEVSYS_EVGEN29, ZeroRegsEVSYS_EVGEN2A, ZeroRegsEVSYS_EVGEN2B, ZeroRegsEVSYS_EVGEN2C, ZeroRegsEVSYS_EVGEN2D, ZeroRegsEVSYS_EVGEN2E, ZeroRegsEVSYS_EVGEN2F,
     ZeroRegsEVSYS_EVGEN30, ZeroRegsEVSYS_EVGEN31, ZeroRegsEVSYS_EVGEN32, ZeroRegsEVSYS_EVGEN33, ZeroRegsEVSYS_EVGEN34, ZeroRegsEVSYS_EVGEN35, ZeroRegsEVSYS_EVGEN36, ZeroRegsEVSYS_EVGEN37, ZeroRegsEVSYS_EVGEN38, ZeroRegsEVSYS_EVGEN39, ZeroRegsEVSYS_EVGEN3A, ZeroRegsEVSYS_EVGEN3B, ZeroRegsEVSYS_EVGEN3C, ZeroRegsEVSYS_EVGEN3D, ZeroRegsEVSYS_EVGEN3E, ZeroRegsEVSYS_EVGEN3F,
     ZeroRegsEVSYS_EVGEN40, ZeroRegsEVSYS_EVGEN41, ZeroRegsEVSYS_EVGEN42, ZeroRegsEVSYS_EVGEN43, ZeroRegsEVSYS_EVGEN44, ZeroRegsEVSYS_EVGEN45, ZeroRegsEVSYS_EVGEN46, ZeroRegsEVSYS_EVGEN47, ZeroRegsEVSYS_EVGEN48, ZeroRegsEVSYS_EVGEN49, ZeroRegsEVSYS_EVGEN4A, ZeroRegsEVSYS_EVGEN4B, ZeroRegsEVSYS_EVGEN4C, ZeroRegsEVSYS_EVGEN4D, ZeroRegsEVSYS_EVGEN4E, ZeroRegsEVSYS_EVGEN4F,
     ZeroRegsEVSYS_EVGEN50, ZeroRegsEVSYS_EVGEN51, ZeroRegsEVSYS_EVGEN52, ZeroRegsEVSYS_EVGEN53,
 };
-static const char* ZeroRegsEVSYS_USER00 = "DMAC:0";
-static const char* ZeroRegsEVSYS_USER01 = "DMAC:1";
-static const char* ZeroRegsEVSYS_USER02 = "DMAC:2";
-static const char* ZeroRegsEVSYS_USER03 = "DMAC:3";
-static const char* ZeroRegsEVSYS_USER04 = "TCC0:EV0";
-static const char* ZeroRegsEVSYS_USER05 = "TCC0:EV1";
-static const char* ZeroRegsEVSYS_USER06 = "TCC0:MC0";
-static const char* ZeroRegsEVSYS_USER07 = "TCC0:MC1";
-static const char* ZeroRegsEVSYS_USER08 = "TCC0:MC2";
-static const char* ZeroRegsEVSYS_USER09 = "TCC0:MC3";
-static const char* ZeroRegsEVSYS_USER0A = "TCC1:EV0";
-static const char* ZeroRegsEVSYS_USER0B = "TCC1:EV1";
-static const char* ZeroRegsEVSYS_USER0C = "TCC1:MC0";
-static const char* ZeroRegsEVSYS_USER0D = "TCC1:MC1";
-static const char* ZeroRegsEVSYS_USER0E = "TCC2:EV0";
-static const char* ZeroRegsEVSYS_USER0F = "TCC2:EV1";
-static const char* ZeroRegsEVSYS_USER10 = "TCC2:MC0";
-static const char* ZeroRegsEVSYS_USER11 = "TCC2:MC1";
-static const char* ZeroRegsEVSYS_USER12 = "TC3";
-static const char* ZeroRegsEVSYS_USER13 = "TC4";
-static const char* ZeroRegsEVSYS_USER14 = "TC5";
-static const char* ZeroRegsEVSYS_USER15 = "TC6";
-static const char* ZeroRegsEVSYS_USER16 = "TC7";
-static const char* ZeroRegsEVSYS_USER17 = "ADC:START";
-static const char* ZeroRegsEVSYS_USER18 = "ADC:SYNC";
-static const char* ZeroRegsEVSYS_USER19 = "AC:COMP0";
-static const char* ZeroRegsEVSYS_USER1A = "AC:COMP1";
-static const char* ZeroRegsEVSYS_USER1B = "DAC:START";
-static const char* ZeroRegsEVSYS_USER1C = "PTC:STCONV";
-static const char* ZeroRegsEVSYS_USER1D = "AC:COMP2";
-static const char* ZeroRegsEVSYS_USER1E = "AC:COMP3";
-static const char* ZeroRegsEVSYS_USER1F = "TCC3:EV0";
-static const char* ZeroRegsEVSYS_USER20 = "TCC3:EV1";
-static const char* ZeroRegsEVSYS_USER21 = "TCC3:MC0";
-static const char* ZeroRegsEVSYS_USER22 = "TCC3:MC1";
-static const char* ZeroRegsEVSYS_USER23 = "TCC3:MC2";
-static const char* ZeroRegsEVSYS_USER24 = "TCC3:MC3";
-static const char* ZeroRegsEVSYS_USERs[] = {
+static const char ZeroRegsEVSYS_USER00[] = "DMAC:0";
+static const char ZeroRegsEVSYS_USER01[] = "DMAC:1";
+static const char ZeroRegsEVSYS_USER02[] = "DMAC:2";
+static const char ZeroRegsEVSYS_USER03[] = "DMAC:3";
+static const char ZeroRegsEVSYS_USER04[] = "TCC0:EV0";
+static const char ZeroRegsEVSYS_USER05[] = "TCC0:EV1";
+static const char ZeroRegsEVSYS_USER06[] = "TCC0:MC0";
+static const char ZeroRegsEVSYS_USER07[] = "TCC0:MC1";
+static const char ZeroRegsEVSYS_USER08[] = "TCC0:MC2";
+static const char ZeroRegsEVSYS_USER09[] = "TCC0:MC3";
+static const char ZeroRegsEVSYS_USER0A[] = "TCC1:EV0";
+static const char ZeroRegsEVSYS_USER0B[] = "TCC1:EV1";
+static const char ZeroRegsEVSYS_USER0C[] = "TCC1:MC0";
+static const char ZeroRegsEVSYS_USER0D[] = "TCC1:MC1";
+static const char ZeroRegsEVSYS_USER0E[] = "TCC2:EV0";
+static const char ZeroRegsEVSYS_USER0F[] = "TCC2:EV1";
+static const char ZeroRegsEVSYS_USER10[] = "TCC2:MC0";
+static const char ZeroRegsEVSYS_USER11[] = "TCC2:MC1";
+static const char ZeroRegsEVSYS_USER12[] = "TC3";
+static const char ZeroRegsEVSYS_USER13[] = "TC4";
+static const char ZeroRegsEVSYS_USER14[] = "TC5";
+static const char ZeroRegsEVSYS_USER15[] = "TC6";
+static const char ZeroRegsEVSYS_USER16[] = "TC7";
+static const char ZeroRegsEVSYS_USER17[] = "ADC:START";
+static const char ZeroRegsEVSYS_USER18[] = "ADC:SYNC";
+static const char ZeroRegsEVSYS_USER19[] = "AC:COMP0";
+static const char ZeroRegsEVSYS_USER1A[] = "AC:COMP1";
+static const char ZeroRegsEVSYS_USER1B[] = "DAC:START";
+static const char ZeroRegsEVSYS_USER1C[] = "PTC:STCONV";
+static const char ZeroRegsEVSYS_USER1D[] = "AC:COMP2";
+static const char ZeroRegsEVSYS_USER1E[] = "AC:COMP3";
+static const char ZeroRegsEVSYS_USER1F[] = "TCC3:EV0";
+static const char ZeroRegsEVSYS_USER20[] = "TCC3:EV1";
+static const char ZeroRegsEVSYS_USER21[] = "TCC3:MC0";
+static const char ZeroRegsEVSYS_USER22[] = "TCC3:MC1";
+static const char ZeroRegsEVSYS_USER23[] = "TCC3:MC2";
+static const char ZeroRegsEVSYS_USER24[] = "TCC3:MC3";
+static const char* const ZeroRegsEVSYS_USERs[] = {
     ZeroRegsEVSYS_USER00, ZeroRegsEVSYS_USER01, ZeroRegsEVSYS_USER02, ZeroRegsEVSYS_USER03, ZeroRegsEVSYS_USER04, ZeroRegsEVSYS_USER05, ZeroRegsEVSYS_USER06, ZeroRegsEVSYS_USER07, ZeroRegsEVSYS_USER08, ZeroRegsEVSYS_USER09, ZeroRegsEVSYS_USER0A, ZeroRegsEVSYS_USER0B, ZeroRegsEVSYS_USER0C, ZeroRegsEVSYS_USER0D, ZeroRegsEVSYS_USER0E, ZeroRegsEVSYS_USER0F ,
     ZeroRegsEVSYS_USER10, ZeroRegsEVSYS_USER11, ZeroRegsEVSYS_USER12, ZeroRegsEVSYS_USER13, ZeroRegsEVSYS_USER14, ZeroRegsEVSYS_USER15, ZeroRegsEVSYS_USER16, ZeroRegsEVSYS_USER17, ZeroRegsEVSYS_USER18, ZeroRegsEVSYS_USER19, ZeroRegsEVSYS_USER1A, ZeroRegsEVSYS_USER1B, ZeroRegsEVSYS_USER1C, ZeroRegsEVSYS_USER1D, ZeroRegsEVSYS_USER1E, ZeroRegsEVSYS_USER1F,
     ZeroRegsEVSYS_USER20, ZeroRegsEVSYS_USER21, ZeroRegsEVSYS_USER22, ZeroRegsEVSYS_USER23, ZeroRegsEVSYS_USER24,
 };
-void printZeroRegEVSYS(ZeroRegOptions &opts) {
+void captureZeroRegEVSYS(ZeroRegSnapshot_EVSYS &evsys) {
     while (EVSYS->CTRL.bit.SWRST) {}
-    opts.out.println("--------------------------- EVSYS");
-
-    opts.out.print("CTRL: ");
-    PRINTFLAG(EVSYS->CTRL, GCLKREQ);
-    PRINTNL();
+    evsys.CTRL.reg = EVSYS->CTRL.reg;
 
+    // keep interrupt handlers from changing the selection underneath us
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
     for (uint8_t chid = 0; chid < 12; chid++) {
         // [24.6.2.4 DSrevF] It is possible to read out the configuration of a
         // channel by first selecting the channel by writing to CHANNEL.CHANNEL
         // using a, 8-bit write, and then performing a read of the CHANNEL
         // register.
-        WRITE8(EVSYS->CHANNEL.reg, chid);
-        //FUTURE -- better way to wait until write has synchronized
-        delay(1);
-        if (!EVSYS->CHANNEL.bit.EVGEN && !opts.showDisabled) {
+        if (ZeroRegs__select(&EVSYS->CHANNEL.reg, chid, EVSYS_CHANNEL_CHANNEL_Msk, NULL, 0)) {
+            evsys.CHANNEL[chid].reg = EVSYS->CHANNEL.reg;
+        } else {
+            evsys.CHANNEL[chid].reg = chid;
+        }
+    }
+
+    for (uint8_t uid = 0; uid <= 0x24; uid++) {
+        // [24.6.2.3 DSrevF] It is possible to read out the configuration of a
+        // user by first selecting the user by writing to USER.USER using an
+        // 8-bit write and then performing a read of the 16-bit USER register.
+        if (ZeroRegs__select(&EVSYS->USER.reg, uid, EVSYS_USER_USER_Msk, NULL, 0)) {
+            evsys.USER[uid].reg = EVSYS->USER.reg;
+        } else {
+            evsys.USER[uid].reg = uid;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+static const char* const ZeroRegsEVSYS_EDGSELs[] = {
+    "NONE", "RISE", "FALL", "BOTH",
+};
+static const char* const ZeroRegsEVSYS_PATHs[] = {
+    "SYNC", "RESYNC", "ASYNC",
+};
+// [24.6.2.6 DSrevF] GCLK_EVSYS_CHANNELx cycles each PATH adds
+static const uint8_t ZeroRegsEVSYS_LATENCYs[] = {
+    1, 3, 0,
+};
+
+uint8_t computeZeroRegEVSYSRoutes(ZeroRegEVSYSRoute (&routes)[12], const ZeroRegSnapshot_EVSYS &evsys) {
+    uint8_t count = 0;
+    for (uint8_t chid = 0; chid < 12; chid++) {
+        ZeroRegEVSYSRoute &route = routes[count];
+        route.CHANNEL = chid;
+        route.EVGEN = evsys.CHANNEL[chid].bit.EVGEN;
+        route.PATH = evsys.CHANNEL[chid].bit.PATH;
+        route.EDGSEL = evsys.CHANNEL[chid].bit.EDGSEL;
+        route.LATENCY = route.PATH < sizeof(ZeroRegsEVSYS_LATENCYs) ? ZeroRegsEVSYS_LATENCYs[route.PATH] : 0;
+        route.USERS = 0;
+        for (uint8_t uid = 0; uid <= 0x24; uid++) {
+            // USER.CHANNEL is the channel number plus one
+            if (evsys.USER[uid].bit.CHANNEL == chid + 1) {
+                route.USERS |= 1ULL << uid;
+            }
+        }
+        if (route.EVGEN || route.USERS) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void printZeroRegEVSYS(ZeroRegOptions &opts, const ZeroRegSnapshot_EVSYS &evsys) {
+    opts.out.println("--------------------------- EVSYS");
+
+    opts.out.print("CTRL: ");
+    PRINTFLAG(evsys.CTRL, GCLKREQ);
+    PRINTNL();
+
+    for (uint8_t chid = 0; chid < 12; chid++) {
+        if (!evsys.CHANNEL[chid].bit.EVGEN && !opts.showDisabled) {
             continue;
         }
-        if (ZeroRegsEVSYS_EVGENs[EVSYS->CHANNEL.bit.EVGEN] == ZeroRegs__RESERVED) {
+        if (LOOKUPNAME(ZeroRegsEVSYS_EVGENs, evsys.CHANNEL[chid].bit.EVGEN, ZeroRegs__RESERVED) == ZeroRegs__RESERVED) {
             continue;
         }
         opts.out.print("CHANNEL");
         PRINTPAD2(chid);
         opts.out.print(": ");
         opts.out.print(" path=");
-        switch (EVSYS->CHANNEL.bit.PATH) {
-            case 0x0: opts.out.print("SYNC"); break;
-            case 0x1: opts.out.print("RESYNC"); break;
-            case 0x2: opts.out.print("ASYNC"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
-        opts.out.print(" edgsel");
-        switch (EVSYS->CHANNEL.bit.EDGSEL) {
-            case 0x0: opts.out.print("NONE"); break;
-            case 0x1: opts.out.print("RISE"); break;
-            case 0x2: opts.out.print("FALL"); break;
-            case 0x3: opts.out.print("BOTH"); break;
-        }
+        PRINTNAME(ZeroRegsEVSYS_PATHs, evsys.CHANNEL[chid].bit.PATH, ZeroRegs__RESERVED);
+        opts.out.print(" edgsel=");
+        PRINTNAME(ZeroRegsEVSYS_EDGSELs, evsys.CHANNEL[chid].bit.EDGSEL, ZeroRegs__empty);
         opts.out.print(" evgen=");
-        opts.out.print(ZeroRegsEVSYS_EVGENs[EVSYS->CHANNEL.bit.EVGEN]);
+        PRINTNAME(ZeroRegsEVSYS_EVGENs, evsys.CHANNEL[chid].bit.EVGEN, ZeroRegs__RESERVED);
         PRINTNL();
     }
 
     for (uint8_t uid = 0; uid <= 0x24; uid++) {
-        // [24.6.2.3 DSrevF] It is possible to read out the configuration of a
-        // user by first selecting the user by writing to USER.USER using an
-        // 8-bit write and then performing a read of the 16-bit USER register.
-        WRITE8(EVSYS->USER.reg, uid);
-        //FUTURE -- better way to wait until write has synchronized
-        delay(1);
-        if (!EVSYS->USER.bit.CHANNEL && !opts.showDisabled) {
+        if (!evsys.USER[uid].bit.CHANNEL && !opts.showDisabled) {
             continue;
         }
         opts.out.print("USER");
@@ -736,15 +1427,89 @@ void printZeroRegEVSYS(ZeroRegOptions &opts) {
             PRINTNL();
             continue;
         }
-        if (EVSYS->USER.bit.CHANNEL == 0) {
+        if (evsys.USER[uid].bit.CHANNEL == 0) {
             opts.out.print(" ");
             opts.out.println(ZeroRegs__DISABLED);
         } else {
             opts.out.print(" CHANNEL=");
-            PRINTPAD2(EVSYS->USER.bit.CHANNEL - 1);
+            PRINTPAD2(evsys.USER[uid].bit.CHANNEL - 1);
             PRINTNL();
         }
     }
+
+    ZeroRegEVSYSRoute routes[12];
+    uint8_t count = computeZeroRegEVSYSRoutes(routes, evsys);
+    for (uint8_t r = 0; r < count; r++) {
+        opts.out.print("route");
+        PRINTPAD2(routes[r].CHANNEL);
+        opts.out.print(":  ");
+        PRINTNAME(ZeroRegsEVSYS_EVGENs, routes[r].EVGEN, ZeroRegs__RESERVED);
+        opts.out.print(" ->");
+        for (uint8_t uid = 0; uid <= 0x24; uid++) {
+            if (routes[r].USERS & (1ULL << uid)) {
+                opts.out.print(" ");
+                opts.out.print(ZeroRegsEVSYS_USERs[uid]);
+            }
+        }
+        opts.out.print(" latency=");
+        opts.out.print(routes[r].LATENCY);
+        opts.out.print("cycles");
+        // [24.6.2.6 DSrevF] the asynchronous path can't detect edges, and
+        // the others pass nothing without EDGSEL
+        if (routes[r].PATH == 0x2 && routes[r].EDGSEL) {
+            opts.out.print(" (edgsel ignored)");
+        } else if (routes[r].PATH != 0x2 && !routes[r].EDGSEL) {
+            opts.out.print(" (no events out)");
+        }
+        if (!routes[r].USERS) {
+            opts.out.print(" (no users)");
+        }
+        PRINTNL();
+    }
+}
+
+void printZeroRegEVSYS(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_EVSYS evsys;
+    captureZeroRegEVSYS(evsys);
+    printZeroRegEVSYS(opts, evsys);
+}
+
+void printZeroRegEVSYSDot(ZeroRegOptions &opts, const ZeroRegSnapshot_EVSYS &evsys) {
+    ZeroRegEVSYSRoute routes[12];
+    uint8_t count = computeZeroRegEVSYSRoutes(routes, evsys);
+    opts.out.println("digraph EVSYS {");
+    opts.out.println("    rankdir=LR;");
+    for (uint8_t r = 0; r < count; r++) {
+        const ZeroRegEVSYSRoute &route = routes[r];
+        opts.out.print("    \"");
+        PRINTNAME(ZeroRegsEVSYS_EVGENs, route.EVGEN, ZeroRegs__RESERVED);
+        opts.out.print("\" -> \"CHANNEL");
+        PRINTPAD2(route.CHANNEL);
+        opts.out.print("\" [label=\"");
+        PRINTNAME(ZeroRegsEVSYS_PATHs, route.PATH, ZeroRegs__RESERVED);
+        opts.out.print(" ");
+        PRINTNAME(ZeroRegsEVSYS_EDGSELs, route.EDGSEL, ZeroRegs__empty);
+        opts.out.print("\\n");
+        opts.out.print(route.LATENCY);
+        opts.out.println(" cycles\"];");
+        for (uint8_t uid = 0; uid <= 0x24; uid++) {
+            if (!(route.USERS & (1ULL << uid))) {
+                continue;
+            }
+            opts.out.print("    \"CHANNEL");
+            PRINTPAD2(route.CHANNEL);
+            opts.out.print("\" -> \"");
+            opts.out.print(ZeroRegsEVSYS_USERs[uid]);
+            opts.out.println("\";");
+        }
+    }
+    opts.out.println("}");
+}
+
+void printZeroRegEVSYSDot(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_EVSYS evsys;
+    captureZeroRegEVSYS(evsys);
+    printZeroRegEVSYSDot(opts, evsys);
 }
 
 
@@ -793,213 +1558,319 @@ static const char* const ZeroRegsGCLK_NAMEs[] = {
     ZeroRegsGCLK_NAME18, ZeroRegsGCLK_NAME19, ZeroRegsGCLK_NAME1A, ZeroRegsGCLK_NAME1B, ZeroRegsGCLK_NAME1C, ZeroRegsGCLK_NAME1D, ZeroRegsGCLK_NAME1E, ZeroRegsGCLK_NAME1F,
     ZeroRegsGCLK_NAME20, ZeroRegsGCLK_NAME21, ZeroRegsGCLK_NAME22, ZeroRegsGCLK_NAME23, ZeroRegsGCLK_NAME24, ZeroRegsGCLK_NAME25,
 };
-void printZeroRegGCLK(ZeroRegOptions &opts) {
+void captureZeroRegGCLK(ZeroRegSnapshot_GCLK &gclk) {
     while (GCLK->CTRL.bit.SWRST || GCLK->STATUS.bit.SYNCBUSY) {}
+    // keep interrupt handlers from changing the selection underneath us
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint8_t genid = 0; genid < 0x9; genid++) {
+        // [15.6.4.1 DSrevF] Indirect Access
+        if (ZeroRegs__select(&GCLK->GENCTRL.reg, genid, GCLK_GENCTRL_ID_Msk, &GCLK->STATUS.reg, GCLK_STATUS_SYNCBUSY)) {
+            gclk.GENCTRL[genid].reg = GCLK->GENCTRL.reg;
+        } else {
+            gclk.GENCTRL[genid].reg = genid;
+        }
+        if (ZeroRegs__select(&GCLK->GENDIV.reg, genid, GCLK_GENDIV_ID_Msk, &GCLK->STATUS.reg, GCLK_STATUS_SYNCBUSY)) {
+            gclk.GENDIV[genid].reg = GCLK->GENDIV.reg;
+        } else {
+            gclk.GENDIV[genid].reg = genid;
+        }
+    }
+    for (uint8_t gclkid = 0; gclkid < ZEROREGS_GCLK_CHANNELS; gclkid++) {
+        if (ZeroRegs__select(&GCLK->CLKCTRL.reg, gclkid, GCLK_CLKCTRL_ID_Msk, &GCLK->STATUS.reg, GCLK_STATUS_SYNCBUSY)) {
+            gclk.CLKCTRL[gclkid].reg = GCLK->CLKCTRL.reg;
+        } else {
+            gclk.CLKCTRL[gclkid].reg = gclkid;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+static const char* const ZeroRegsGCLK_SRCs[] = {
+    "XOSC", "GCLKIN", "GEN01", "OSCULP32K", "OSC32K", "XOSC32K", "OSC8M", "DFLL48M", "FDPLL96M",
+};
+void printZeroRegGCLK(ZeroRegOptions &opts, const ZeroRegSnapshot_GCLK &gclk, const ZeroRegClocks *clocks) {
     opts.out.println("--------------------------- GCLK");
 
     for (uint8_t genid = 0; genid < 0x9; genid++) {
-        // [15.6.4.1 DSrevF] Indirect Access
-        WRITE8(GCLK->GENCTRL.reg, genid);
-        //FUTURE -- better way to wait until write has synchronized
-        delay(1);
-        if (!GCLK->GENCTRL.bit.GENEN && !opts.showDisabled) {
+        if (!gclk.GENCTRL[genid].bit.GENEN && !opts.showDisabled) {
             continue;
         }
         opts.out.print("GEN");
         PRINTPAD2(genid);
         opts.out.print(": ");
-        PRINTFLAG(GCLK->GENCTRL, GENEN);
+        PRINTFLAG(gclk.GENCTRL[genid], GENEN);
         opts.out.print(" ");
-        switch (GCLK->GENCTRL.bit.SRC) {
-            case 0x0: opts.out.print("XOSC"); break;
-            case 0x1:
-                      //FUTURE -- lookup port pin(s)
-                      opts.out.print("GCLKIN");
-                      break;
-            case 0x2: opts.out.print("GEN01"); break;
-            case 0x3: opts.out.print("OSCULP32K"); break;
-            case 0x4: opts.out.print("OSC32K"); break;
-            case 0x5: opts.out.print("XOSC32K"); break;
-            case 0x6: opts.out.print("OSC8M"); break;
-            case 0x7: opts.out.print("DFLL48M"); break;
-            case 0x8: opts.out.print("FDPLL96M"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
-        // [15.6.4.1 DSrevF] Indirect Access
-        WRITE8(GCLK->GENDIV.reg, genid);
-        //FUTURE -- better way to wait until write has synchronized
-        delay(1);
-        if (GCLK->GENCTRL.bit.DIVSEL) {
+        //FUTURE -- lookup port pin(s) for GCLKIN
+        PRINTNAME(ZeroRegsGCLK_SRCs, gclk.GENCTRL[genid].bit.SRC, ZeroRegs__RESERVED);
+        if (gclk.GENCTRL[genid].bit.DIVSEL) {
             opts.out.print("/");
-            PRINTSCALE(GCLK->GENDIV.bit.DIV + 1);
+            PRINTSCALE(gclk.GENDIV[genid].bit.DIV + 1);
         } else {
-            if (GCLK->GENDIV.bit.DIV > 1) {
+            if (gclk.GENDIV[genid].bit.DIV > 1) {
                 opts.out.print("/");
-                opts.out.print(GCLK->GENDIV.bit.DIV);
+                opts.out.print(gclk.GENDIV[genid].bit.DIV);
             }
         }
-        PRINTFLAG(GCLK->GENCTRL, IDC);
-        if (GCLK->GENCTRL.bit.SRC != 1) {
-            PRINTFLAG(GCLK->GENCTRL, OE);   //FUTURE -- lookup port pin(s)
-            if (GCLK->GENCTRL.bit.OE) {
+        PRINTFLAG(gclk.GENCTRL[genid], IDC);
+        if (gclk.GENCTRL[genid].bit.SRC != 1) {
+            PRINTFLAG(gclk.GENCTRL[genid], OE);   //FUTURE -- lookup port pin(s)
+            if (gclk.GENCTRL[genid].bit.OE) {
                 opts.out.print(" OOV=");
-                opts.out.print(GCLK->GENCTRL.bit.OOV);
+                opts.out.print(gclk.GENCTRL[genid].bit.OOV);
             }
         }
-        PRINTFLAG(GCLK->GENCTRL, RUNSTDBY);
+        PRINTFLAG(gclk.GENCTRL[genid], RUNSTDBY);
+        if (clocks && gclk.GENCTRL[genid].bit.GENEN) {
+            opts.out.print(" freq=");
+            PRINTHZ(clocks->GEN[genid]);
+        }
         PRINTNL();
     }
 
-    opts.out.println("GCLK_MAIN:  GEN00 (always)");
-    for (uint8_t gclkid = 0; gclkid < 37; gclkid++) {
-        // [15.6.4.1 DSrevF] Indirect Access
-        WRITE8(GCLK->CLKCTRL.reg, gclkid);
-        //FUTURE -- better way to wait until write has synchronized
-        delay(1);
-        if (!GCLK->CLKCTRL.bit.CLKEN && !opts.showDisabled) {
+    opts.out.print("GCLK_MAIN:  GEN00 (always)");
+    if (clocks) {
+        opts.out.print(" freq=");
+        PRINTHZ(clocks->GEN[0]);
+    }
+    PRINTNL();
+    for (uint8_t gclkid = 0; gclkid < ZEROREGS_GCLK_CHANNELS; gclkid++) {
+        if (!gclk.CLKCTRL[gclkid].bit.CLKEN && !opts.showDisabled) {
             continue;
         }
         opts.out.print("GCLK_");
         opts.out.print(ZeroRegsGCLK_NAMEs[gclkid]);
         opts.out.print(": ");
-        PRINTFLAG(GCLK->CLKCTRL, CLKEN);
+        PRINTFLAG(gclk.CLKCTRL[gclkid], CLKEN);
         opts.out.print(" GEN");
-        PRINTPAD2(GCLK->CLKCTRL.bit.GEN);
-        PRINTFLAG(GCLK->CLKCTRL, WRTLOCK);
+        PRINTPAD2(gclk.CLKCTRL[gclkid].bit.GEN);
+        PRINTFLAG(gclk.CLKCTRL[gclkid], WRTLOCK);
+        if (clocks && gclk.CLKCTRL[gclkid].bit.CLKEN) {
+            opts.out.print(" freq=");
+            PRINTHZ(clocks->CLKCTRL[gclkid]);
+        }
         PRINTNL();
     }
 }
 
+void printZeroRegGCLK(ZeroRegOptions &opts, const ZeroRegSnapshot_GCLK &gclk) {
+    printZeroRegGCLK(opts, gclk, NULL);
+}
 
-void printZeroRegI2S(ZeroRegOptions &opts) {
+void printZeroRegGCLK(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_SYSCTRL sysctrl;
+    ZeroRegSnapshot_GCLK gclk;
+    ZeroRegClocks clocks;
+    captureZeroRegSYSCTRL(sysctrl);
+    captureZeroRegGCLK(gclk);
+    computeZeroRegClocks(clocks, sysctrl, gclk, opts.xoscHz);
+    printZeroRegGCLK(opts, gclk, &clocks);
+}
+
+
+void computeZeroRegClocks(ZeroRegClocks &clocks, const ZeroRegSnapshot_SYSCTRL &sysctrl, const ZeroRegSnapshot_GCLK &gclk, uint32_t xoscHz) {
+    // [17.6 DSrevF] oscillators
+    clocks.XOSC = sysctrl.XOSC.bit.ENABLE ? xoscHz : 0;
+    clocks.XOSC32K = (sysctrl.XOSC32K.bit.ENABLE && sysctrl.XOSC32K.bit.EN32K) ? 32768 : 0;
+    clocks.OSC32K = (sysctrl.OSC32K.bit.ENABLE && sysctrl.OSC32K.bit.EN32K) ? 32768 : 0;
+    clocks.OSCULP32K = 32768;
+    clocks.OSC8M = sysctrl.OSC8M.bit.ENABLE ? (8000000 >> sysctrl.OSC8M.bit.PRESC) : 0;
+    clocks.DFLL48M = 0;
+    clocks.FDPLL96M = 0;
+    memset(clocks.GEN, 0, sizeof(clocks.GEN));
+    memset(clocks.CLKCTRL, 0, sizeof(clocks.CLKCTRL));
+
+    // The DFLL48M and FDPLL96M can take their reference from a generator,
+    // which can in turn be fed by them (or by GEN01), so go around a few
+    // times until the whole chain is worked out.
+    for (uint8_t pass = 0; pass < 4; pass++) {
+        if (sysctrl.DFLLCTRL.bit.ENABLE) {
+            // [17.6.7 DSrevF] closed-loop is MUL times the reference
+            if (!sysctrl.DFLLCTRL.bit.MODE) {
+                clocks.DFLL48M = 48000000;
+            } else if (sysctrl.DFLLCTRL.bit.USBCRM) {
+                clocks.DFLL48M = 1000 * sysctrl.DFLLMUL.bit.MUL;   // USB start-of-frame
+            } else {
+                clocks.DFLL48M = clocks.CLKCTRL[GCLK_CLKCTRL_ID_DFLL48_Val] * sysctrl.DFLLMUL.bit.MUL;
+            }
+        }
+        if (sysctrl.DPLLCTRLA.bit.ENABLE) {
+            // [17.6.8 DSrevF] out = REFCLK * (LDR + 1 + LDRFRAC/16)
+            uint32_t ref = 0;
+            switch (sysctrl.DPLLCTRLB.bit.REFCLK) {
+                case 0x0: ref = clocks.XOSC32K; break;
+                case 0x1: ref = clocks.XOSC / (2 * (sysctrl.DPLLCTRLB.bit.DIV + 1)); break;
+                case 0x2: ref = clocks.CLKCTRL[GCLK_CLKCTRL_ID_FDPLL_Val]; break;
+            }
+            clocks.FDPLL96M = (uint32_t)(((uint64_t)ref * (16 * (sysctrl.DPLLRATIO.bit.LDR + 1) + sysctrl.DPLLRATIO.bit.LDRFRAC)) / 16);
+        }
+        for (uint8_t genid = 0; genid < 0x9; genid++) {
+            if (!gclk.GENCTRL[genid].bit.GENEN) {
+                clocks.GEN[genid] = 0;
+                continue;
+            }
+            uint32_t hz = 0;
+            switch (gclk.GENCTRL[genid].bit.SRC) {
+                case 0x0: hz = clocks.XOSC; break;
+                case 0x2: hz = clocks.GEN[1]; break;
+                case 0x3: hz = clocks.OSCULP32K; break;
+                case 0x4: hz = clocks.OSC32K; break;
+                case 0x5: hz = clocks.XOSC32K; break;
+                case 0x6: hz = clocks.OSC8M; break;
+                case 0x7: hz = clocks.DFLL48M; break;
+                case 0x8: hz = clocks.FDPLL96M; break;
+            }
+            uint16_t div = gclk.GENDIV[genid].bit.DIV;
+            if (gclk.GENCTRL[genid].bit.DIVSEL) {
+                hz = (div + 1 < 32) ? (hz >> (div + 1)) : 0;
+            } else if (div > 1) {
+                hz /= div;
+            }
+            clocks.GEN[genid] = hz;
+        }
+        for (uint8_t gclkid = 0; gclkid < ZEROREGS_GCLK_CHANNELS; gclkid++) {
+            uint8_t genid = gclk.CLKCTRL[gclkid].bit.GEN;
+            clocks.CLKCTRL[gclkid] = (gclk.CLKCTRL[gclkid].bit.CLKEN && genid < 0x9) ? clocks.GEN[genid] : 0;
+        }
+    }
+}
+
+
+void captureZeroRegI2S(ZeroRegSnapshot_I2S &i2s) {
 #ifdef I2S
     while (I2S->SYNCBUSY.bit.SWRST || I2S->SYNCBUSY.bit.ENABLE) {}
-    if (!I2S->CTRLA.bit.ENABLE && !opts.showDisabled) {
+    while (I2S->SYNCBUSY.bit.CKEN0 || I2S->SYNCBUSY.bit.CKEN1) {}
+    while (I2S->SYNCBUSY.bit.SEREN0 || I2S->SYNCBUSY.bit.SEREN1) {}
+    i2s.CTRLA = I2S->CTRLA.reg;
+    for (uint8_t i = 0; i < 2; i++) {
+        i2s.CLKCTRL[i] = I2S->CLKCTRL[i].reg;
+        i2s.SERCTRL[i] = I2S->SERCTRL[i].reg;
+    }
+#else
+    memset(&i2s, 0, sizeof(i2s));
+#endif
+}
+
+static const char* const ZeroRegsI2S_SLOTSIZEs[] = {
+    "8bit", "16bit", "24bit", "32bit",
+};
+static const char* const ZeroRegsI2S_FSWIDTHs[] = {
+    "SLOT", "HALF", "BIT", "BURST",
+};
+static const char* const ZeroRegsI2S_SERMODEs[] = {
+    "RX", "TX", "PDM2", ZeroRegs__RESERVED,
+};
+static const char* const ZeroRegsI2S_TXDEFAULTs[] = {
+    "ZERO", "ONE", ZeroRegs__RESERVED, "HIZ",
+};
+static const char* const ZeroRegsI2S_DATASIZEs[] = {
+    "32", "24", "20", "18", "16", "16C", "8", "8C",
+};
+static const char* const ZeroRegsI2S_EXTENDs[] = {
+    "ZERO", "ONE", "MSBIT", "LSBIT",
+};
+void printZeroRegI2S(ZeroRegOptions &opts, const ZeroRegSnapshot_I2S &i2s) {
+#ifdef I2S
+    I2S_CTRLA_Type ctrla;
+    ctrla.reg = i2s.CTRLA;
+    if (!ctrla.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- I2S");
 
     opts.out.print("CTRLA: ");
-    PRINTFLAG(I2S->CTRLA, ENABLE);
-    while (I2S->SYNCBUSY.bit.CKEN0) {}
-    PRINTFLAG(I2S->CTRLA, CKEN0);
-    while (I2S->SYNCBUSY.bit.CKEN1) {}
-    PRINTFLAG(I2S->CTRLA, CKEN1);
-    while (I2S->SYNCBUSY.bit.SEREN0) {}
-    PRINTFLAG(I2S->CTRLA, SEREN0);
-    while (I2S->SYNCBUSY.bit.SEREN1) {}
-    PRINTFLAG(I2S->CTRLA, SEREN1);
+    PRINTFLAG(ctrla, ENABLE);
+    PRINTFLAG(ctrla, CKEN0);
+    PRINTFLAG(ctrla, CKEN1);
+    PRINTFLAG(ctrla, SEREN0);
+    PRINTFLAG(ctrla, SEREN1);
     PRINTNL();
 
     for (uint8_t i = 0; i < 2; i++) {
+        I2S_CLKCTRL_Type clkctrl;
+        clkctrl.reg = i2s.CLKCTRL[i];
         opts.out.print("CLKCTRL");
         opts.out.print(i);
         opts.out.print(":  slots=");
-        opts.out.print(I2S->CLKCTRL[i].bit.NBSLOTS + 1);
+        opts.out.print(clkctrl.bit.NBSLOTS + 1);
         opts.out.print("x");
-        switch (I2S->CLKCTRL[i].bit.SLOTSIZE) {
-            case 0x0: opts.out.print("8bit"); break;
-            case 0x1: opts.out.print("16bit"); break;
-            case 0x2: opts.out.print("24bit"); break;
-            case 0x3: opts.out.print("32bit"); break;
-        }
+        PRINTNAME(ZeroRegsI2S_SLOTSIZEs, clkctrl.bit.SLOTSIZE, ZeroRegs__empty);
         opts.out.print(" fswidth=");
-        switch (I2S->CLKCTRL[i].bit.FSWIDTH) {
-            case 0x0: opts.out.print("SLOT"); break;
-            case 0x1: opts.out.print("HALF"); break;
-            case 0x2: opts.out.print("BIT"); break;
-            case 0x3: opts.out.print("BURST"); break;
-        }
+        PRINTNAME(ZeroRegsI2S_FSWIDTHs, clkctrl.bit.FSWIDTH, ZeroRegs__empty);
         opts.out.print(" bitdelay=");
-        opts.out.print(I2S->CLKCTRL[i].bit.BITDELAY ? "I2S" : "LJ");
+        opts.out.print(clkctrl.bit.BITDELAY ? "I2S" : "LJ");
 
         opts.out.print(" mck=");
-        opts.out.print(I2S->CLKCTRL[i].bit.MCKSEL ? "MCKPIN" : "GCLK");
-        if (I2S->CLKCTRL[i].bit.MCKEN) {
+        opts.out.print(clkctrl.bit.MCKSEL ? "MCKPIN" : "GCLK");
+        if (clkctrl.bit.MCKEN) {
             opts.out.print(" mckout=");
-            opts.out.print(I2S->CLKCTRL[i].bit.MCKSEL ? "MCKPIN" : "GCLK");
+            opts.out.print(clkctrl.bit.MCKSEL ? "MCKPIN" : "GCLK");
             opts.out.print("/");
-            opts.out.print(I2S->CLKCTRL[i].bit.MCKOUTDIV + 1);
-            PRINTFLAG(I2S->CLKCTRL[i], MCKOUTINV);
+            opts.out.print(clkctrl.bit.MCKOUTDIV + 1);
+            PRINTFLAG(clkctrl, MCKOUTINV);
         }
 
         opts.out.print(" sck=");
-        opts.out.print(I2S->CLKCTRL[i].bit.SCKSEL ? "SCKPIN" : "MCKDIV");
-        if (I2S->CLKCTRL[i].bit.SCKSEL == 0) {
+        opts.out.print(clkctrl.bit.SCKSEL ? "SCKPIN" : "MCKDIV");
+        if (clkctrl.bit.SCKSEL == 0) {
             opts.out.print("(");
-            opts.out.print(I2S->CLKCTRL[i].bit.MCKSEL ? "MCKPIN" : "GCLK");
+            opts.out.print(clkctrl.bit.MCKSEL ? "MCKPIN" : "GCLK");
             opts.out.print("/");
-            opts.out.print(I2S->CLKCTRL[i].bit.MCKDIV + 1);
+            opts.out.print(clkctrl.bit.MCKDIV + 1);
             opts.out.print(")");
         }
-        PRINTFLAG(I2S->CLKCTRL[i], SCKOUTINV);
+        PRINTFLAG(clkctrl, SCKOUTINV);
 
         opts.out.print(" fs=");
-        opts.out.print(I2S->CLKCTRL[i].bit.FSSEL ? "FSPIN" : "SCKDIV");
-        PRINTFLAG(I2S->CLKCTRL[i], FSINV);
-        PRINTFLAG(I2S->CLKCTRL[i], FSOUTINV);
+        opts.out.print(clkctrl.bit.FSSEL ? "FSPIN" : "SCKDIV");
+        PRINTFLAG(clkctrl, FSINV);
+        PRINTFLAG(clkctrl, FSOUTINV);
 
         PRINTNL();
     }
 
     for (uint8_t i = 0; i < 2; i++) {
+        I2S_SERCTRL_Type serctrl;
+        serctrl.reg = i2s.SERCTRL[i];
         opts.out.print("SERCTRL");
         opts.out.print(i);
         opts.out.print(":  sermode=");
-        switch (I2S->SERCTRL[i].bit.SERMODE) {
-            case 0x0: opts.out.print("RX"); break;
-            case 0x1: opts.out.print("TX"); break;
-            case 0x2: opts.out.print("PDM2"); break;
-            case 0x3: opts.out.print(ZeroRegs__RESERVED); break;
-        }
-        switch (I2S->SERCTRL[i].bit.TXDEFAULT) {
-            case 0x0: opts.out.print("ZERO"); break;
-            case 0x1: opts.out.print("ONE"); break;
-            case 0x2: opts.out.print(ZeroRegs__RESERVED); break;
-            case 0x3: opts.out.print("HIZ"); break;
-        }
-        PRINTFLAG(I2S->SERCTRL[i], TXSAME);
+        PRINTNAME(ZeroRegsI2S_SERMODEs, serctrl.bit.SERMODE, ZeroRegs__empty);
+        PRINTNAME(ZeroRegsI2S_TXDEFAULTs, serctrl.bit.TXDEFAULT, ZeroRegs__empty);
+        PRINTFLAG(serctrl, TXSAME);
         opts.out.print(" clksel=CLK");
-        opts.out.print(I2S->SERCTRL[i].bit.CLKSEL);
+        opts.out.print(serctrl.bit.CLKSEL);
         opts.out.print(" slotadj=");
-        opts.out.print(I2S->SERCTRL[i].bit.SLOTADJ ? "LEFT" : "RIGHT");
+        opts.out.print(serctrl.bit.SLOTADJ ? "LEFT" : "RIGHT");
         opts.out.print(" datasize=");
-        switch (I2S->SERCTRL[i].bit.DATASIZE) {
-            case 0x0: opts.out.print("32"); break;
-            case 0x1: opts.out.print("24"); break;
-            case 0x2: opts.out.print("20"); break;
-            case 0x3: opts.out.print("18"); break;
-            case 0x4: opts.out.print("16"); break;
-            case 0x5: opts.out.print("16C"); break;
-            case 0x6: opts.out.print("8"); break;
-            case 0x7: opts.out.print("8C"); break;
-        }
+        PRINTNAME(ZeroRegsI2S_DATASIZEs, serctrl.bit.DATASIZE, ZeroRegs__empty);
         opts.out.print(" wordadj=");
-        opts.out.print(I2S->SERCTRL[i].bit.WORDADJ ? "LEFT" : "RIGHT");
+        opts.out.print(serctrl.bit.WORDADJ ? "LEFT" : "RIGHT");
         opts.out.print(" extend=");
-        switch (I2S->SERCTRL[i].bit.EXTEND) {
-            case 0x0: opts.out.print("ZERO"); break;
-            case 0x1: opts.out.print("ONE"); break;
-            case 0x2: opts.out.print("MSBIT"); break;
-            case 0x3: opts.out.print("LSBIT"); break;
-        }
+        PRINTNAME(ZeroRegsI2S_EXTENDs, serctrl.bit.EXTEND, ZeroRegs__empty);
         opts.out.print(" bitrev=");
-        opts.out.print(I2S->SERCTRL[i].bit.BITREV ? "LSBIT" : "MSBIT");
+        opts.out.print(serctrl.bit.BITREV ? "LSBIT" : "MSBIT");
         for (uint8_t j = 0; j < 8; j++) {
-            if (I2S->SERCTRL[i].vec.SLOTDIS & (1<<j)) {
+            if (serctrl.vec.SLOTDIS & (1<<j)) {
                 opts.out.print(" SLOTDIS");
                 opts.out.print(j);
             }
         }
-        opts.out.print(I2S->SERCTRL[i].bit.MONO ? " MONO" : " STEREO");
+        opts.out.print(serctrl.bit.MONO ? " MONO" : " STEREO");
         opts.out.print(" dma=");
-        opts.out.print(I2S->SERCTRL[i].bit.DMA ? "MULTIPLE" : "SINGLE");
-        PRINTFLAG(I2S->SERCTRL[i], RXLOOP);
+        opts.out.print(serctrl.bit.DMA ? "MULTIPLE" : "SINGLE");
+        PRINTFLAG(serctrl, RXLOOP);
         PRINTNL();
     }
 #endif
 }
 
+void printZeroRegI2S(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_I2S i2s;
+    captureZeroRegI2S(i2s);
+    printZeroRegI2S(opts, i2s);
+}
+
 
 typedef union {
     struct {
@@ -1014,73 +1885,74 @@ typedef union {
     } bit;
     uint64_t reg;
 } ZeroRegsNVM_OTP4_Type;
-void printZeroRegNVMCTRL(ZeroRegOptions &opts) {
+void captureZeroRegNVMCTRL(ZeroRegSnapshot_NVMCTRL &nvmctrl) {
+    nvmctrl.CTRLB.reg = NVMCTRL->CTRLB.reg;
+    nvmctrl.PARAM.reg = NVMCTRL->PARAM.reg;
+    nvmctrl.LOCK.reg = NVMCTRL->LOCK.reg;
+    // [10.3.1 DSrevF] NVM User Row Mapping
+    nvmctrl.USER[0] = READADDR32(NVMCTRL_USER);
+    nvmctrl.USER[1] = READADDR32(NVMCTRL_USER + 4);
+    // [10.3.2 DSrevF] NVM Software Calibration Area Mapping
+    nvmctrl.OTP4[0] = READADDR32(NVMCTRL_OTP4);
+    nvmctrl.OTP4[1] = READADDR32(NVMCTRL_OTP4 + 4);
+    // [10.3.3 DSrevF] Serial Number
+    nvmctrl.SERIAL[0] = READADDR32(0x0080A00C);
+    nvmctrl.SERIAL[1] = READADDR32(0x0080A040);
+    nvmctrl.SERIAL[2] = READADDR32(0x0080A044);
+    nvmctrl.SERIAL[3] = READADDR32(0x0080A048);
+}
+
+static const char* const ZeroRegsNVMCTRL_SLEEPPRMs[] = {
+    "WAKEONACCESS", "WAKEUPINSTANT", ZeroRegs__RESERVED, "DISABLED",
+};
+static const char* const ZeroRegsNVMCTRL_READMODEs[] = {
+    "NO_MISS_PENALTY", "LOW_POWER", "DETERMINISTIC",
+};
+static const char* const ZeroRegsNVMCTRL_BOOTPROTs[] = {
+    "32k", "16k", "8k", "4k", "2k", "1k", "512", "0",
+};
+static const char* const ZeroRegsNVMCTRL_EEPROM_SIZEs[] = {
+    "16k", "8k", "4k", "2k", "1k", "512", "256", "0",
+};
+void printZeroRegNVMCTRL(ZeroRegOptions &opts, const ZeroRegSnapshot_NVMCTRL &nvmctrl) {
     opts.out.println("--------------------------- NVMCTRL");
 
     opts.out.print("CTRLB: ");
     opts.out.print(" RWS=");
-    opts.out.print(NVMCTRL->CTRLB.bit.RWS);
-    PRINTFLAG(NVMCTRL->CTRLB, MANW);
+    opts.out.print(nvmctrl.CTRLB.bit.RWS);
+    PRINTFLAG(nvmctrl.CTRLB, MANW);
     opts.out.print(" sleepprm=");
-    switch (NVMCTRL->CTRLB.bit.SLEEPPRM) {
-        case 0x0: opts.out.print("WAKEONACCESS"); break;
-        case 0x1: opts.out.print("WAKEUPINSTANT"); break;
-        case 0x2: opts.out.print(ZeroRegs__RESERVED); break;
-        case 0x3: opts.out.print("DISABLED"); break;
-    }
+    PRINTNAME(ZeroRegsNVMCTRL_SLEEPPRMs, nvmctrl.CTRLB.bit.SLEEPPRM, ZeroRegs__empty);
     opts.out.print(" readmode=");
-    switch (NVMCTRL->CTRLB.bit.READMODE) {
-        case 0x0: opts.out.print("NO_MISS_PENALTY"); break;
-        case 0x1: opts.out.print("LOW_POWER"); break;
-        case 0x2: opts.out.print("DETERMINISTIC"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
-    PRINTFLAG(NVMCTRL->CTRLB, CACHEDIS);
+    PRINTNAME(ZeroRegsNVMCTRL_READMODEs, nvmctrl.CTRLB.bit.READMODE, ZeroRegs__RESERVED);
+    PRINTFLAG(nvmctrl.CTRLB, CACHEDIS);
     PRINTNL();
 
     opts.out.print("PARAM:  NVMP=");
-    opts.out.print(NVMCTRL->PARAM.bit.NVMP);
+    opts.out.print(nvmctrl.PARAM.bit.NVMP);
     opts.out.print(" psz=");
-    opts.out.print(1 << (3 + NVMCTRL->PARAM.bit.PSZ));
+    opts.out.print(1 << (3 + nvmctrl.PARAM.bit.PSZ));
     opts.out.print("bytes");
     PRINTNL();
 
     opts.out.print("LOCK:  ");
-    opts.out.println(NVMCTRL->LOCK.reg, BIN);
+    opts.out.println(nvmctrl.LOCK.reg, BIN);
 
     // [10.3.1 DSrevF] NVM User Row Mapping
     // [22.6.5 DSrevF] NVM User Configuration
     opts.out.print("user row: ");
     opts.out.print(" bootprot=");
-    switch (READFUSE(NVMCTRL, BOOTPROT)) {
-        case 0x7: opts.out.print("0"); break;
-        case 0x6: opts.out.print("512"); break;
-        case 0x5: opts.out.print("1k"); break;
-        case 0x4: opts.out.print("2k"); break;
-        case 0x3: opts.out.print("4k"); break;
-        case 0x2: opts.out.print("8k"); break;
-        case 0x1: opts.out.print("16k"); break;
-        case 0x0: opts.out.print("32k"); break;
-    }
+    PRINTNAME(ZeroRegsNVMCTRL_BOOTPROTs, READFUSE(nvmctrl.USER, NVMCTRL, BOOTPROT), ZeroRegs__empty);
     opts.out.print(" eeprom_size=");
-    switch (READFUSE(NVMCTRL, EEPROM_SIZE)) {
-        case 0x7: opts.out.print("0"); break;
-        case 0x6: opts.out.print("256"); break;
-        case 0x5: opts.out.print("512"); break;
-        case 0x4: opts.out.print("1k"); break;
-        case 0x3: opts.out.print("2k"); break;
-        case 0x2: opts.out.print("4k"); break;
-        case 0x1: opts.out.print("8k"); break;
-        case 0x0: opts.out.print("16k"); break;
-    }
+    PRINTNAME(ZeroRegsNVMCTRL_EEPROM_SIZEs, READFUSE(nvmctrl.USER, NVMCTRL, EEPROM_SIZE), ZeroRegs__empty);
     opts.out.print(" region_locks=");
-    opts.out.print(READFUSE(NVMCTRL, REGION_LOCKS), BIN);
+    opts.out.print(READFUSE(nvmctrl.USER, NVMCTRL, REGION_LOCKS), BIN);
     PRINTNL();
 
     // [10.3.2 DSrevF] NVM Software Calibration Area Mapping
     //  0x806020 NVMCTRL_OTP4
     ZeroRegsNVM_OTP4_Type otp4;
-    otp4.reg = ((ZeroRegsNVM_OTP4_Type*)NVMCTRL_OTP4)->reg;
+    otp4.reg = ((uint64_t)nvmctrl.OTP4[1] << 32) | nvmctrl.OTP4[0];
     opts.out.print("software calibration: ");
     opts.out.print(" ADC_LINEARITY=");
     PRINTHEX((uint8_t)otp4.bit.ADC_LINEARITY);
@@ -1100,163 +1972,197 @@ void printZeroRegNVMCTRL(ZeroRegOptions &opts) {
 
     // [10.3.3 DSrevF] Serial Number
     // 0x0080A00C 0x0080A040 0x0080A044 0x0080A048
-    opts.out.print("serial # ");
-    PRINTHEX(READADDR32(0x0080A00C));
+    opts.out.print("serial #:  ");
+    PRINTHEX(nvmctrl.SERIAL[0]);
     opts.out.print(" ");
-    PRINTHEX(READADDR32(0x0080A040));
+    PRINTHEX(nvmctrl.SERIAL[1]);
     opts.out.print(" ");
-    PRINTHEX(READADDR32(0x0080A044));
+    PRINTHEX(nvmctrl.SERIAL[2]);
     opts.out.print(" ");
-    PRINTHEX(READADDR32(0x0080A048));
+    PRINTHEX(nvmctrl.SERIAL[3]);
     PRINTNL();
 }
 
+void printZeroRegNVMCTRL(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_NVMCTRL nvmctrl;
+    captureZeroRegNVMCTRL(nvmctrl);
+    printZeroRegNVMCTRL(opts, nvmctrl);
+}
+
 
-void printZeroRegPAC(ZeroRegOptions &opts) {
-    if (!PAC0->WPSET.reg && !PAC1->WPSET.reg && !PAC2->WPSET.reg && !opts.showDisabled) {
+void captureZeroRegPAC(ZeroRegSnapshot_PAC &pac) {
+    pac.WPSET[0].reg = PAC0->WPSET.reg;
+    pac.WPSET[1].reg = PAC1->WPSET.reg;
+    pac.WPSET[2].reg = PAC2->WPSET.reg;
+}
+
+void printZeroRegPAC(ZeroRegOptions &opts, const ZeroRegSnapshot_PAC &pac) {
+    if (!pac.WPSET[0].reg && !pac.WPSET[1].reg && !pac.WPSET[2].reg && !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- PAC");
 
-    if (PAC0->WPSET.reg || opts.showDisabled) {
+    if (pac.WPSET[0].reg || opts.showDisabled) {
         opts.out.print("PAC0: ");
-        if (bitRead(PAC0->WPSET.reg, 1)) opts.out.print(" PM");
-        if (bitRead(PAC0->WPSET.reg, 2)) opts.out.print(" SYSCTRL");
-        if (bitRead(PAC0->WPSET.reg, 3)) opts.out.print(" GCLK");
-        if (bitRead(PAC0->WPSET.reg, 4)) opts.out.print(" WDT");
-        if (bitRead(PAC0->WPSET.reg, 5)) opts.out.print(" RTC");
-        if (bitRead(PAC0->WPSET.reg, 6)) opts.out.print(" EIC");
+        if (bitRead(pac.WPSET[0].reg, 1)) opts.out.print(" PM");
+        if (bitRead(pac.WPSET[0].reg, 2)) opts.out.print(" SYSCTRL");
+        if (bitRead(pac.WPSET[0].reg, 3)) opts.out.print(" GCLK");
+        if (bitRead(pac.WPSET[0].reg, 4)) opts.out.print(" WDT");
+        if (bitRead(pac.WPSET[0].reg, 5)) opts.out.print(" RTC");
+        if (bitRead(pac.WPSET[0].reg, 6)) opts.out.print(" EIC");
         PRINTNL();
     }
 
-    if (PAC1->WPSET.reg || opts.showDisabled) {
+    if (pac.WPSET[1].reg || opts.showDisabled) {
         opts.out.print("PAC1: ");
-        if (bitRead(PAC1->WPSET.reg, 1)) opts.out.print(" DSU");
-        if (bitRead(PAC1->WPSET.reg, 2)) opts.out.print(" NVMCTRL");
-        if (bitRead(PAC1->WPSET.reg, 3)) opts.out.print(" PORT");
-        if (bitRead(PAC1->WPSET.reg, 4)) opts.out.print(" DMAC");
-        if (bitRead(PAC1->WPSET.reg, 5)) opts.out.print(" USB");
-        if (bitRead(PAC1->WPSET.reg, 6)) opts.out.print(" MTB");
+        if (bitRead(pac.WPSET[1].reg, 1)) opts.out.print(" DSU");
+        if (bitRead(pac.WPSET[1].reg, 2)) opts.out.print(" NVMCTRL");
+        if (bitRead(pac.WPSET[1].reg, 3)) opts.out.print(" PORT");
+        if (bitRead(pac.WPSET[1].reg, 4)) opts.out.print(" DMAC");
+        if (bitRead(pac.WPSET[1].reg, 5)) opts.out.print(" USB");
+        if (bitRead(pac.WPSET[1].reg, 6)) opts.out.print(" MTB");
         PRINTNL();
     }
 
-    if (PAC2->WPSET.reg || opts.showDisabled) {
+    if (pac.WPSET[2].reg || opts.showDisabled) {
         opts.out.print("PAC2: ");
-        if (bitRead(PAC2->WPSET.reg,  1)) opts.out.print(" EVSYS");
-        if (bitRead(PAC2->WPSET.reg,  2)) opts.out.print(" SERCOM0");
-        if (bitRead(PAC2->WPSET.reg,  3)) opts.out.print(" SERCOM1");
-        if (bitRead(PAC2->WPSET.reg,  4)) opts.out.print(" SERCOM2");
-        if (bitRead(PAC2->WPSET.reg,  5)) opts.out.print(" SERCOM3");
-        if (bitRead(PAC2->WPSET.reg,  6)) opts.out.print(" SERCOM4");
-        if (bitRead(PAC2->WPSET.reg,  7)) opts.out.print(" SERCOM5");
-        if (bitRead(PAC2->WPSET.reg,  8)) opts.out.print(" TCC0");
-        if (bitRead(PAC2->WPSET.reg,  9)) opts.out.print(" TCC1");
-        if (bitRead(PAC2->WPSET.reg, 10)) opts.out.print(" TCC2");
-        if (bitRead(PAC2->WPSET.reg, 11)) opts.out.print(" TC3");
-        if (bitRead(PAC2->WPSET.reg, 12)) opts.out.print(" TC4");
-        if (bitRead(PAC2->WPSET.reg, 13)) opts.out.print(" TC5");
-        if (bitRead(PAC2->WPSET.reg, 14)) opts.out.print(" TC6");
-        if (bitRead(PAC2->WPSET.reg, 15)) opts.out.print(" TC7");
-        if (bitRead(PAC2->WPSET.reg, 16)) opts.out.print(" ADC");
-        if (bitRead(PAC2->WPSET.reg, 17)) opts.out.print(" AC");
-        if (bitRead(PAC2->WPSET.reg, 18)) opts.out.print(" DAC");
-        if (bitRead(PAC2->WPSET.reg, 19)) opts.out.print(" PTC");
-        if (bitRead(PAC2->WPSET.reg, 20)) opts.out.print(" I2S");
-        if (bitRead(PAC2->WPSET.reg, 21)) opts.out.print(" AC1");
+        if (bitRead(pac.WPSET[2].reg,  1)) opts.out.print(" EVSYS");
+        if (bitRead(pac.WPSET[2].reg,  2)) opts.out.print(" SERCOM0");
+        if (bitRead(pac.WPSET[2].reg,  3)) opts.out.print(" SERCOM1");
+        if (bitRead(pac.WPSET[2].reg,  4)) opts.out.print(" SERCOM2");
+        if (bitRead(pac.WPSET[2].reg,  5)) opts.out.print(" SERCOM3");
+        if (bitRead(pac.WPSET[2].reg,  6)) opts.out.print(" SERCOM4");
+        if (bitRead(pac.WPSET[2].reg,  7)) opts.out.print(" SERCOM5");
+        if (bitRead(pac.WPSET[2].reg,  8)) opts.out.print(" TCC0");
+        if (bitRead(pac.WPSET[2].reg,  9)) opts.out.print(" TCC1");
+        if (bitRead(pac.WPSET[2].reg, 10)) opts.out.print(" TCC2");
+        if (bitRead(pac.WPSET[2].reg, 11)) opts.out.print(" TC3");
+        if (bitRead(pac.WPSET[2].reg, 12)) opts.out.print(" TC4");
+        if (bitRead(pac.WPSET[2].reg, 13)) opts.out.print(" TC5");
+        if (bitRead(pac.WPSET[2].reg, 14)) opts.out.print(" TC6");
+        if (bitRead(pac.WPSET[2].reg, 15)) opts.out.print(" TC7");
+        if (bitRead(pac.WPSET[2].reg, 16)) opts.out.print(" ADC");
+        if (bitRead(pac.WPSET[2].reg, 17)) opts.out.print(" AC");
+        if (bitRead(pac.WPSET[2].reg, 18)) opts.out.print(" DAC");
+        if (bitRead(pac.WPSET[2].reg, 19)) opts.out.print(" PTC");
+        if (bitRead(pac.WPSET[2].reg, 20)) opts.out.print(" I2S");
+        if (bitRead(pac.WPSET[2].reg, 21)) opts.out.print(" AC1");
         // undefined                 22
         // undefined                 23
-        if (bitRead(PAC2->WPSET.reg, 24)) opts.out.print(" TCC3");
+        if (bitRead(pac.WPSET[2].reg, 24)) opts.out.print(" TCC3");
         PRINTNL();
     }
 }
 
+void printZeroRegPAC(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_PAC pac;
+    captureZeroRegPAC(pac);
+    printZeroRegPAC(opts, pac);
+}
 
-void printZeroRegPM(ZeroRegOptions &opts) {
+
+void captureZeroRegPM(ZeroRegSnapshot_PM &pm) {
+    pm.SLEEP.reg = PM->SLEEP.reg;
+    pm.CPUSEL.reg = PM->CPUSEL.reg;
+    pm.APBASEL.reg = PM->APBASEL.reg;
+    pm.APBBSEL.reg = PM->APBBSEL.reg;
+    pm.APBCSEL.reg = PM->APBCSEL.reg;
+    pm.AHBMASK.reg = PM->AHBMASK.reg;
+    pm.APBAMASK.reg = PM->APBAMASK.reg;
+    pm.APBBMASK.reg = PM->APBBMASK.reg;
+    pm.APBCMASK.reg = PM->APBCMASK.reg;
+}
+
+static const char* const ZeroRegsPM_IDLEs[] = {
+    "CPU", "CPU+AHB", "CPU+AHB+APB",
+};
+void printZeroRegPM(ZeroRegOptions &opts, const ZeroRegSnapshot_PM &pm) {
     opts.out.println("--------------------------- PM");
 
     opts.out.print("SLEEP:  idle=");
-    switch(PM->SLEEP.bit.IDLE) {
-        case 0x0: opts.out.print("CPU"); break;
-        case 0x1: opts.out.print("CPU+AHB"); break;
-        case 0x2: opts.out.print("CPU+AHB+APB"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsPM_IDLEs, pm.SLEEP.bit.IDLE, ZeroRegs__RESERVED);
     PRINTNL();
 
     opts.out.print("CPUSEL:  /");
-    PRINTSCALE(PM->CPUSEL.bit.CPUDIV);
+    PRINTSCALE(pm.CPUSEL.bit.CPUDIV);
     PRINTNL();
 
     opts.out.print("APBASEL:  /");
-    PRINTSCALE(PM->APBASEL.bit.APBADIV);
+    PRINTSCALE(pm.APBASEL.bit.APBADIV);
     PRINTNL();
 
     opts.out.print("APBBSEL:  /");
-    PRINTSCALE(PM->APBBSEL.bit.APBBDIV);
+    PRINTSCALE(pm.APBBSEL.bit.APBBDIV);
     PRINTNL();
 
     opts.out.print("APBCSEL:  /");
-    PRINTSCALE(PM->APBCSEL.bit.APBCDIV);
+    PRINTSCALE(pm.APBCSEL.bit.APBCDIV);
     PRINTNL();
 
     opts.out.print("AHBMASK: ");
-    if (PM->AHBMASK.bit.HPB0_)      { opts.out.print(" CLK_HPBA_AHB"); }
-    if (PM->AHBMASK.bit.HPB1_)      { opts.out.print(" CLK_HPBB_AHB"); }
-    if (PM->AHBMASK.bit.HPB2_)      { opts.out.print(" CLK_HPBC_AHB"); }
-    if (PM->AHBMASK.bit.DSU_)       { opts.out.print(" CLK_DSU_AHB"); }
-    if (PM->AHBMASK.bit.NVMCTRL_)   { opts.out.print(" CLK_NVMCTRL_AHB"); }
-    if (PM->AHBMASK.bit.DMAC_)      { opts.out.print(" CLK_DMAC_AHB"); }
-    if (PM->AHBMASK.bit.USB_)       { opts.out.print(" CLK_USB_AHB"); }
+    if (pm.AHBMASK.bit.HPB0_)      { opts.out.print(" CLK_HPBA_AHB"); }
+    if (pm.AHBMASK.bit.HPB1_)      { opts.out.print(" CLK_HPBB_AHB"); }
+    if (pm.AHBMASK.bit.HPB2_)      { opts.out.print(" CLK_HPBC_AHB"); }
+    if (pm.AHBMASK.bit.DSU_)       { opts.out.print(" CLK_DSU_AHB"); }
+    if (pm.AHBMASK.bit.NVMCTRL_)   { opts.out.print(" CLK_NVMCTRL_AHB"); }
+    if (pm.AHBMASK.bit.DMAC_)      { opts.out.print(" CLK_DMAC_AHB"); }
+    if (pm.AHBMASK.bit.USB_)       { opts.out.print(" CLK_USB_AHB"); }
     PRINTNL();
 
     opts.out.print("APBAMASK: ");
-    if (PM->APBAMASK.bit.PAC0_)     { opts.out.print(" CLK_PAC0_APB"); }
-    if (PM->APBAMASK.bit.PM_)       { opts.out.print(" CLK_PM_APB"); }
-    if (PM->APBAMASK.bit.SYSCTRL_)  { opts.out.print(" CLK_SYSCTRL_APB"); }
-    if (PM->APBAMASK.bit.GCLK_)     { opts.out.print(" CLK_GCLK_APB"); }
-    if (PM->APBAMASK.bit.WDT_)      { opts.out.print(" CLK_WDT_APB"); }
-    if (PM->APBAMASK.bit.RTC_)      { opts.out.print(" CLK_RTC_APB"); }
-    if (PM->APBAMASK.bit.EIC_)      { opts.out.print(" CLK_EIC_APB"); }
+    if (pm.APBAMASK.bit.PAC0_)     { opts.out.print(" CLK_PAC0_APB"); }
+    if (pm.APBAMASK.bit.PM_)       { opts.out.print(" CLK_PM_APB"); }
+    if (pm.APBAMASK.bit.SYSCTRL_)  { opts.out.print(" CLK_SYSCTRL_APB"); }
+    if (pm.APBAMASK.bit.GCLK_)     { opts.out.print(" CLK_GCLK_APB"); }
+    if (pm.APBAMASK.bit.WDT_)      { opts.out.print(" CLK_WDT_APB"); }
+    if (pm.APBAMASK.bit.RTC_)      { opts.out.print(" CLK_RTC_APB"); }
+    if (pm.APBAMASK.bit.EIC_)      { opts.out.print(" CLK_EIC_APB"); }
     PRINTNL();
 
     opts.out.print("APBBMASK: ");
-    if (PM->APBBMASK.bit.PAC1_)     { opts.out.print(" CLK_PAC1_APB"); }
-    if (PM->APBBMASK.bit.DSU_)      { opts.out.print(" CLK_DSU_APB"); }
-    if (PM->APBBMASK.bit.NVMCTRL_)  { opts.out.print(" CLK_NVMCTRL_APB"); }
-    if (PM->APBBMASK.bit.PORT_)     { opts.out.print(" CLK_PORT_APB"); }
-    if (PM->APBBMASK.bit.DMAC_)     { opts.out.print(" CLK_DMAC_APB"); }
-    if (PM->APBBMASK.bit.USB_)      { opts.out.print(" CLK_USB_APB"); }
+    if (pm.APBBMASK.bit.PAC1_)     { opts.out.print(" CLK_PAC1_APB"); }
+    if (pm.APBBMASK.bit.DSU_)      { opts.out.print(" CLK_DSU_APB"); }
+    if (pm.APBBMASK.bit.NVMCTRL_)  { opts.out.print(" CLK_NVMCTRL_APB"); }
+    if (pm.APBBMASK.bit.PORT_)     { opts.out.print(" CLK_PORT_APB"); }
+    if (pm.APBBMASK.bit.DMAC_)     { opts.out.print(" CLK_DMAC_APB"); }
+    if (pm.APBBMASK.bit.USB_)      { opts.out.print(" CLK_USB_APB"); }
     PRINTNL();
 
     opts.out.print("APBCMASK: ");
-    if (PM->APBCMASK.bit.PAC2_)     { opts.out.print(" CLK_PAC2_APB"); }
-    if (PM->APBCMASK.bit.EVSYS_)    { opts.out.print(" CLK_EVSYS_APB"); }
-    if (PM->APBCMASK.bit.SERCOM0_)  { opts.out.print(" CLK_SERCOM0_APB"); }
-    if (PM->APBCMASK.bit.SERCOM1_)  { opts.out.print(" CLK_SERCOM1_APB"); }
-    if (PM->APBCMASK.bit.SERCOM2_)  { opts.out.print(" CLK_SERCOM2_APB"); }
-    if (PM->APBCMASK.bit.SERCOM3_)  { opts.out.print(" CLK_SERCOM3_APB"); }
-    if (PM->APBCMASK.bit.SERCOM4_)  { opts.out.print(" CLK_SERCOM4_APB"); }
-    if (PM->APBCMASK.bit.SERCOM5_)  { opts.out.print(" CLK_SERCOM5_APB"); }
-    if (PM->APBCMASK.bit.TCC0_)     { opts.out.print(" CLK_TCC0_APB"); }
-    if (PM->APBCMASK.bit.TCC1_)     { opts.out.print(" CLK_TCC1_APB"); }
-    if (PM->APBCMASK.bit.TCC2_)     { opts.out.print(" CLK_TCC2_APB"); }
-    if (PM->APBCMASK.bit.TC3_)      { opts.out.print(" CLK_TC3_APB"); }
-    if (PM->APBCMASK.bit.TC4_)      { opts.out.print(" CLK_TC4_APB"); }
-    if (PM->APBCMASK.bit.TC5_)      { opts.out.print(" CLK_TC5_APB"); }
-    if (PM->APBCMASK.bit.TC6_)      { opts.out.print(" CLK_TC6_APB"); }
-    if (PM->APBCMASK.bit.TC7_)      { opts.out.print(" CLK_TC7_APB"); }
-    if (PM->APBCMASK.bit.ADC_)      { opts.out.print(" CLK_ADC_APB"); }
-    if (PM->APBCMASK.bit.AC_)       { opts.out.print(" CLK_AC_APB"); }
-    if (PM->APBCMASK.bit.DAC_)      { opts.out.print(" CLK_DAC_APB"); }
-    if (PM->APBCMASK.bit.PTC_)      { opts.out.print(" CLK_PTC_APB"); }
-    if (PM->APBCMASK.bit.I2S_)      { opts.out.print(" CLK_I2S_APB"); }
-    if (bitRead(PM->APBCMASK.reg, 21)) opts.out.print(" CLK_AC1_APB");
+    if (pm.APBCMASK.bit.PAC2_)     { opts.out.print(" CLK_PAC2_APB"); }
+    if (pm.APBCMASK.bit.EVSYS_)    { opts.out.print(" CLK_EVSYS_APB"); }
+    if (pm.APBCMASK.bit.SERCOM0_)  { opts.out.print(" CLK_SERCOM0_APB"); }
+    if (pm.APBCMASK.bit.SERCOM1_)  { opts.out.print(" CLK_SERCOM1_APB"); }
+    if (pm.APBCMASK.bit.SERCOM2_)  { opts.out.print(" CLK_SERCOM2_APB"); }
+    if (pm.APBCMASK.bit.SERCOM3_)  { opts.out.print(" CLK_SERCOM3_APB"); }
+    if (pm.APBCMASK.bit.SERCOM4_)  { opts.out.print(" CLK_SERCOM4_APB"); }
+    if (pm.APBCMASK.bit.SERCOM5_)  { opts.out.print(" CLK_SERCOM5_APB"); }
+    if (pm.APBCMASK.bit.TCC0_)     { opts.out.print(" CLK_TCC0_APB"); }
+    if (pm.APBCMASK.bit.TCC1_)     { opts.out.print(" CLK_TCC1_APB"); }
+    if (pm.APBCMASK.bit.TCC2_)     { opts.out.print(" CLK_TCC2_APB"); }
+    if (pm.APBCMASK.bit.TC3_)      { opts.out.print(" CLK_TC3_APB"); }
+    if (pm.APBCMASK.bit.TC4_)      { opts.out.print(" CLK_TC4_APB"); }
+    if (pm.APBCMASK.bit.TC5_)      { opts.out.print(" CLK_TC5_APB"); }
+    if (pm.APBCMASK.bit.TC6_)      { opts.out.print(" CLK_TC6_APB"); }
+    if (pm.APBCMASK.bit.TC7_)      { opts.out.print(" CLK_TC7_APB"); }
+    if (pm.APBCMASK.bit.ADC_)      { opts.out.print(" CLK_ADC_APB"); }
+    if (pm.APBCMASK.bit.AC_)       { opts.out.print(" CLK_AC_APB"); }
+    if (pm.APBCMASK.bit.DAC_)      { opts.out.print(" CLK_DAC_APB"); }
+    if (pm.APBCMASK.bit.PTC_)      { opts.out.print(" CLK_PTC_APB"); }
+    if (pm.APBCMASK.bit.I2S_)      { opts.out.print(" CLK_I2S_APB"); }
+    if (bitRead(pm.APBCMASK.reg, 21)) opts.out.print(" CLK_AC1_APB");
     // undefined                  22
     // undefined                  23
-    if (bitRead(PM->APBCMASK.reg, 24)) opts.out.print(" CLK_TCC3_APB");
+    if (bitRead(pm.APBCMASK.reg, 24)) opts.out.print(" CLK_TCC3_APB");
     PRINTNL();
 }
 
+void printZeroRegPM(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_PM pm;
+    captureZeroRegPM(pm);
+    printZeroRegPM(opts, pm);
+}
+
 
 // [table 7-1 DSrevF]
 struct ZeroRegsPORT_PMUX {
@@ -1347,24 +2253,50 @@ static const ZeroRegsPORT_Pin ZeroRegsPORT_pins[2][32] = {
         { "PB31", {  "EIC:15",         NULL,        NULL, "SERCOM5:1", "TCC0:1", "TCC1:3",       NULL,     NULL } },
     },
 };
-void printZeroRegPORT_pin(ZeroRegOptions &opts, uint8_t gid, uint8_t pid) {
-    uint32_t dir = (PORT->Group[gid].DIR.bit.DIR & (1 << pid));
-    uint8_t inen = PORT->Group[gid].PINCFG[pid].bit.INEN;
-    uint8_t pullen = PORT->Group[gid].PINCFG[pid].bit.PULLEN;
-    uint8_t pmuxen = PORT->Group[gid].PINCFG[pid].bit.PMUXEN;
+void captureZeroRegPORT(ZeroRegSnapshot_PORT &port) {
+    for (uint8_t gid = 0; gid < 2; gid++) {
+        port.Group[gid].DIR.reg = PORT->Group[gid].DIR.reg;
+        port.Group[gid].OUT.reg = PORT->Group[gid].OUT.reg;
+        port.Group[gid].CTRL.reg = PORT->Group[gid].CTRL.reg;
+        for (uint8_t i = 0; i < 16; i++) {
+            port.Group[gid].PMUX[i].reg = PORT->Group[gid].PMUX[i].reg;
+        }
+        for (uint8_t pid = 0; pid < 32; pid++) {
+            port.Group[gid].PINCFG[pid].reg = PORT->Group[gid].PINCFG[pid].reg;
+        }
+    }
+    // the pin hints need to know how each SERCOM has its pads arranged
+    Sercom* sercoms[6] = { SERCOM0, SERCOM1, SERCOM2, SERCOM3, NULL, NULL };
+#ifdef SERCOM4
+    sercoms[4] = SERCOM4;
+#endif
+#ifdef SERCOM5
+    sercoms[5] = SERCOM5;
+#endif
+    for (uint8_t x = 0; x < 6; x++) {
+        port.SERCOM_CTRLA[x] = sercoms[x] ? sercoms[x]->SPI.CTRLA.reg : 0;
+        port.SERCOM_CTRLB[x] = sercoms[x] ? sercoms[x]->SPI.CTRLB.reg : 0;
+    }
+}
+
+void printZeroRegPORT_pin(ZeroRegOptions &opts, const ZeroRegSnapshot_PORT &port, uint8_t gid, uint8_t pid) {
+    uint32_t dir = (port.Group[gid].DIR.bit.DIR & (1 << pid));
+    uint8_t inen = port.Group[gid].PINCFG[pid].bit.INEN;
+    uint8_t pullen = port.Group[gid].PINCFG[pid].bit.PULLEN;
+    uint8_t pmuxen = port.Group[gid].PINCFG[pid].bit.PMUXEN;
     if (pmuxen) {
         uint8_t pmux;
         if ((pid%2) == 0) {
-            pmux = PORT->Group[gid].PMUX[pid/2].bit.PMUXE;
+            pmux = port.Group[gid].PMUX[pid/2].bit.PMUXE;
         } else {
-            pmux = PORT->Group[gid].PMUX[pid/2].bit.PMUXO;
+            pmux = port.Group[gid].PMUX[pid/2].bit.PMUXO;
         }
         opts.out.print("pmux=");
         const char *pmuxName = ZeroRegsPORT_pins[gid][pid].pmux[pmux];
         if (pmuxName) {
             opts.out.print(pmuxName);
             if (pmux == 2 || pmux == 3) {
-                printZeroRegSERCOM_pinhint(opts, pmuxName);
+                printZeroRegSERCOM_pinhint(opts, port, pmuxName);
             }
         } else {
             opts.out.print(ZeroRegsPORT_PMUXs[pmux].name);
@@ -1380,26 +2312,26 @@ void printZeroRegPORT_pin(ZeroRegOptions &opts, uint8_t gid, uint8_t pid) {
         if (inen) {
             opts.out.print(" INEN");
         }
-        PRINTFLAG(PORT->Group[gid].PINCFG[pid], DRVSTR);
+        PRINTFLAG(port.Group[gid].PINCFG[pid], DRVSTR);
     } else {
         opts.out.print("input");
         if (inen) {
             opts.out.print(" INEN");
         }
-        if (PORT->Group[gid].CTRL.bit.SAMPLING & (1<<pid)) {
+        if (port.Group[gid].CTRL.bit.SAMPLING & (1<<pid)) {
             opts.out.print(" SAMPLING");
         }
         if (pullen) {
             opts.out.print(" pull=");
             opts.out.print(
-                    PORT->Group[gid].OUT.bit.OUT & (1<<pid) ?
+                    port.Group[gid].OUT.bit.OUT & (1<<pid) ?
                     "UP" : "DOWN"
                     );
         }
     }
 }
 
-void printZeroRegPORT(ZeroRegOptions &opts) {
+void printZeroRegPORT(ZeroRegOptions &opts, const ZeroRegSnapshot_PORT &port) {
     for (uint8_t gid = 0; gid < 2; gid++) {
         opts.out.print("--------------------------- PORT ");
         opts.out.print(char('A' + gid));
@@ -1410,24 +2342,31 @@ void printZeroRegPORT(ZeroRegOptions &opts) {
                 // pin not defined in datasheet [table 7-1 DSrevF]
                 continue;
             }
-            uint32_t dir = (PORT->Group[gid].DIR.bit.DIR & (1 << pid));
-            uint8_t inen = PORT->Group[gid].PINCFG[pid].bit.INEN;
-            uint8_t pullen = PORT->Group[gid].PINCFG[pid].bit.PULLEN;
-            uint8_t pmuxen = PORT->Group[gid].PINCFG[pid].bit.PMUXEN;
+            uint32_t dir = (port.Group[gid].DIR.bit.DIR & (1 << pid));
+            uint8_t inen = port.Group[gid].PINCFG[pid].bit.INEN;
+            uint8_t pullen = port.Group[gid].PINCFG[pid].bit.PULLEN;
+            uint8_t pmuxen = port.Group[gid].PINCFG[pid].bit.PMUXEN;
             bool disabled = !dir && !inen && !pullen && !pmuxen;    // [23.6.3.4 DSrevF] Digital Functionality Disabled
             if (disabled && !opts.showDisabled) {
                 continue;
             }
             opts.out.print(ZeroRegsPORT_pins[gid][pid].name);
             opts.out.print(":  ");
-            printZeroRegPORT_pin(opts, gid, pid);
+            printZeroRegPORT_pin(opts, port, gid, pid);
             PRINTNL();
         }
     }
 }
 
 
-void printZeroRegPORT_Arduino(ZeroRegOptions &opts) {
+void printZeroRegPORT(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_PORT port;
+    captureZeroRegPORT(port);
+    printZeroRegPORT(opts, port);
+}
+
+
+void printZeroRegPORT_Arduino(ZeroRegOptions &opts, const ZeroRegSnapshot_PORT &port) {
     opts.out.println("--------------------------- ARDUINO PINS");
     int8_t aid = -1;
     for (uint8_t did = 0; did < PINS_COUNT; did++) {
@@ -1440,10 +2379,10 @@ void printZeroRegPORT_Arduino(ZeroRegOptions &opts) {
         if (pinDesc.ulPinType == PIO_ANALOG) {
             aid++;
         }
-        uint32_t dir = (PORT->Group[gid].DIR.bit.DIR & (1 << pid));
-        uint8_t inen = PORT->Group[gid].PINCFG[pid].bit.INEN;
-        uint8_t pullen = PORT->Group[gid].PINCFG[pid].bit.PULLEN;
-        uint8_t pmuxen = PORT->Group[gid].PINCFG[pid].bit.PMUXEN;
+        uint32_t dir = (port.Group[gid].DIR.bit.DIR & (1 << pid));
+        uint8_t inen = port.Group[gid].PINCFG[pid].bit.INEN;
+        uint8_t pullen = port.Group[gid].PINCFG[pid].bit.PULLEN;
+        uint8_t pmuxen = port.Group[gid].PINCFG[pid].bit.PMUXEN;
         bool disabled = !dir && !inen && !pullen && !pmuxen;    // [23.6.3.4 DSrevF] Digital Functionality Disabled
         if (disabled && !opts.showDisabled) {
             continue;
@@ -1461,20 +2400,26 @@ void printZeroRegPORT_Arduino(ZeroRegOptions &opts) {
         if (disabled) {
             opts.out.println(ZeroRegs__DISABLED);
         } else {
-            printZeroRegPORT_pin(opts, gid, pid);
+            printZeroRegPORT_pin(opts, port, gid, pid);
             PRINTNL();
         }
     }
 }
 
+void printZeroRegPORT_Arduino(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_PORT port;
+    captureZeroRegPORT(port);
+    printZeroRegPORT_Arduino(opts, port);
+}
+
 
-void printZeroRegRTC_FREQCORR(ZeroRegOptions &opts, volatile RTC_FREQCORR_Type &freqcorr) {
+void printZeroRegRTC_FREQCORR(ZeroRegOptions &opts, RTC_FREQCORR_Type freqcorr) {
     opts.out.print("FREQCORR:  ");
     opts.out.print(freqcorr.bit.SIGN ? '-' : '+');
     opts.out.println(freqcorr.bit.VALUE);
 }
 
-void printZeroRegRTC_MODE0(ZeroRegOptions &opts, RtcMode0 &mode) {
+void printZeroRegRTC_MODE0(ZeroRegOptions &opts, const ZeroRegSnapshot_RTC_MODE0 &mode) {
     opts.out.println("--------------------------- RTC MODE0");
 
     opts.out.print("CTRL: ");
@@ -1507,7 +2452,7 @@ void printZeroRegRTC_MODE0(ZeroRegOptions &opts, RtcMode0 &mode) {
     PRINTNL();
 }
 
-void printZeroRegRTC_MODE1(ZeroRegOptions &opts, RtcMode1 &mode) {
+void printZeroRegRTC_MODE1(ZeroRegOptions &opts, const ZeroRegSnapshot_RTC_MODE1 &mode) {
     opts.out.println("--------------------------- RTC MODE1");
 
     opts.out.print("CTRL: ");
@@ -1548,7 +2493,10 @@ void printZeroRegRTC_MODE1(ZeroRegOptions &opts, RtcMode1 &mode) {
     PRINTNL();
 }
 
-void printZeroRegRTC_MODE2(ZeroRegOptions &opts, RtcMode2 &mode) {
+static const char* const ZeroRegsRTC_MODE2_SELs[] = {
+    "OFF", "SS", "MM:SS", "HH:MM:SS", "DD HH:MM:SS", "MM-DD HH:MM:SS", "YY-MM-DD HH:MM:SS",
+};
+void printZeroRegRTC_MODE2(ZeroRegOptions &opts, const ZeroRegSnapshot_RTC_MODE2 &mode) {
     opts.out.println("--------------------------- RTC MODE2");
 
     opts.out.print("CTRL: ");
@@ -1578,161 +2526,292 @@ void printZeroRegRTC_MODE2(ZeroRegOptions &opts, RtcMode2 &mode) {
     printZeroRegRTC_FREQCORR(opts, mode.FREQCORR);
 
     opts.out.print("ALARM0:  ");
-    PRINTPAD2(mode.Mode2Alarm[0].ALARM.bit.YEAR);
+    PRINTPAD2(mode.ALARM[0].bit.YEAR);
     opts.out.print("-");
-    PRINTPAD2(mode.Mode2Alarm[0].ALARM.bit.MONTH);
+    PRINTPAD2(mode.ALARM[0].bit.MONTH);
     opts.out.print("-");
-    PRINTPAD2(mode.Mode2Alarm[0].ALARM.bit.DAY);
+    PRINTPAD2(mode.ALARM[0].bit.DAY);
     opts.out.print(" ");
-    PRINTPAD2(mode.Mode2Alarm[0].ALARM.bit.HOUR);
+    PRINTPAD2(mode.ALARM[0].bit.HOUR);
     opts.out.print(":");
-    PRINTPAD2(mode.Mode2Alarm[0].ALARM.bit.MINUTE);
+    PRINTPAD2(mode.ALARM[0].bit.MINUTE);
     opts.out.print(":");
-    PRINTPAD2(mode.Mode2Alarm[0].ALARM.bit.SECOND);
+    PRINTPAD2(mode.ALARM[0].bit.SECOND);
     PRINTNL();
 
     opts.out.print("MASK0:  ");
-    switch (mode.Mode2Alarm[0].MASK.bit.SEL) {
-        case 0x0: opts.out.print("OFF"); break;
-        case 0x1: opts.out.print("SS"); break;
-        case 0x2: opts.out.print("MM:SS"); break;
-        case 0x3: opts.out.print("HH:MM:SS"); break;
-        case 0x4: opts.out.print("DD HH:MM:SS"); break;
-        case 0x5: opts.out.print("MM-DD HH:MM:SS"); break;
-        case 0x6: opts.out.print("YY-MM-DD HH:MM:SS"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsRTC_MODE2_SELs, mode.MASK[0].bit.SEL, ZeroRegs__RESERVED);
     PRINTNL();
 }
 
-void printZeroRegRTC(ZeroRegOptions &opts) {
+void captureZeroRegRTC(ZeroRegSnapshot_RTC &rtc) {
     while (RTC->MODE0.CTRL.bit.SWRST || RTC->MODE0.STATUS.bit.SYNCBUSY) {}
-    if (!opts.showDisabled && !RTC->MODE0.CTRL.bit.ENABLE) {
+    // CTRL, EVCTRL, and FREQCORR are at the same place in all modes
+    rtc.MODE0.CTRL.reg = RTC->MODE0.CTRL.reg;
+    rtc.MODE0.EVCTRL.reg = RTC->MODE0.EVCTRL.reg;
+    rtc.MODE0.FREQCORR.reg = RTC->MODE0.FREQCORR.reg;
+    switch (RTC->MODE0.CTRL.bit.MODE) {
+        case 0x0:
+            rtc.MODE0.COMP[0].reg = RTC->MODE0.COMP[0].reg;
+            break;
+        case 0x1:
+            rtc.MODE1.PER.reg = RTC->MODE1.PER.reg;
+            rtc.MODE1.COMP[0].reg = RTC->MODE1.COMP[0].reg;
+            rtc.MODE1.COMP[1].reg = RTC->MODE1.COMP[1].reg;
+            break;
+        case 0x2:
+            rtc.MODE2.ALARM[0].reg = RTC->MODE2.Mode2Alarm[0].ALARM.reg;
+            rtc.MODE2.MASK[0].reg = RTC->MODE2.Mode2Alarm[0].MASK.reg;
+            break;
+    }
+}
+
+void printZeroRegRTC(ZeroRegOptions &opts, const ZeroRegSnapshot_RTC &rtc) {
+    if (!opts.showDisabled && !rtc.MODE0.CTRL.bit.ENABLE) {
         return;
     }
-    switch (RTC->MODE0.CTRL.bit.MODE) {
-        case 0x0: printZeroRegRTC_MODE0(opts, RTC->MODE0); break;
-        case 0x1: printZeroRegRTC_MODE1(opts, RTC->MODE1); break;
-        case 0x2: printZeroRegRTC_MODE2(opts, RTC->MODE2); break;
+    switch (rtc.MODE0.CTRL.bit.MODE) {
+        case 0x0: printZeroRegRTC_MODE0(opts, rtc.MODE0); break;
+        case 0x1: printZeroRegRTC_MODE1(opts, rtc.MODE1); break;
+        case 0x2: printZeroRegRTC_MODE2(opts, rtc.MODE2); break;
     }
 }
 
+void printZeroRegRTC(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_RTC rtc;
+    captureZeroRegRTC(rtc);
+    printZeroRegRTC(opts, rtc);
+}
 
-void printZeroRegSCS(ZeroRegOptions &opts) {
+
+void captureZeroRegSCS(ZeroRegSnapshot_SCS &scs) {
+    scs.CPUID = SCB->CPUID;
+    scs.SysTick_CTRL = SysTick->CTRL;
+    scs.SysTick_LOAD = SysTick->LOAD;
+    scs.SysTick_CALIB = SysTick->CALIB;
+    for (uint8_t i = 0; i < 8; i++) {
+        scs.NVIC_IP[i] = NVIC->IP[i];
+    }
+    scs.NVIC_ISER = NVIC->ISER[0];
+    scs.NVIC_ISPR = NVIC->ISPR[0];
+    scs.SCB_SHPR3 = SCB->SHP[1];
+}
+
+// IRQs are kept in a bitmask like ISER, with SysTick in the unused top bit.
+#define ZEROREGS_IRQ_SYSTICK 31
+static const char* const ZeroRegsSCS_IRQs[] = {
+    "PM", "SYSCTRL", "WDT", "RTC", "EIC", "NVMCTRL", "DMAC", "USB",
+    "EVSYS", "SERCOM0", "SERCOM1", "SERCOM2", "SERCOM3", "SERCOM4", "SERCOM5", "TCC0",
+    "TCC1", "TCC2", "TC3", "TC4", "TC5", "TC6", "TC7", "ADC",
+    "AC", "DAC", "PTC", "I2S",
+};
+
+static void ZeroRegs__printIRQ(ZeroRegOptions &opts, uint8_t bit) {
+    if (bit == ZEROREGS_IRQ_SYSTICK) {
+        opts.out.print("SysTick");
+    } else if (bit < sizeof(ZeroRegsSCS_IRQs) / sizeof(ZeroRegsSCS_IRQs[0])) {
+        opts.out.print(ZeroRegsSCS_IRQs[bit]);
+    } else {
+        PRINTHEX(bit);
+    }
+}
+
+// Prints the IRQs in the bitmask separated by `sep`.
+static void ZeroRegs__printIRQs(ZeroRegOptions &opts, uint32_t irqs, const char* sep) {
+    bool first = true;
+    for (uint8_t bit = 0; bit < 32; bit++) {
+        if (bitRead(irqs, bit)) {
+            if (!first) {
+                opts.out.print(sep);
+            }
+            ZeroRegs__printIRQ(opts, bit);
+            first = false;
+        }
+    }
+}
+
+// same as NVIC_GetPriority() but from the snapshot
+static uint8_t ZeroRegs__irqPriority(const ZeroRegSnapshot_SCS &scs, uint8_t bit) {
+    if (bit == ZEROREGS_IRQ_SYSTICK) {
+        return (scs.SCB_SHPR3 >> (24 + 8 - __NVIC_PRIO_BITS)) & ((1 << __NVIC_PRIO_BITS) - 1);
+    }
+    return (scs.NVIC_IP[bit / 4] >> (((bit % 4) * 8) + (8 - __NVIC_PRIO_BITS))) & ((1 << __NVIC_PRIO_BITS) - 1);
+}
+
+void printZeroRegSCS(ZeroRegOptions &opts, const ZeroRegSnapshot_SCS &scs) {
     opts.out.println("--------------------------- SCS");
 
     opts.out.print("CPUID:  REV=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_REVISION));
+    PRINTHEX(READSCS(scs.CPUID, SCB_CPUID_REVISION));
     opts.out.print(" PARTNO=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_PARTNO));
+    PRINTHEX(READSCS(scs.CPUID, SCB_CPUID_PARTNO));
     opts.out.print(" ARCH=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_ARCHITECTURE));
+    PRINTHEX(READSCS(scs.CPUID, SCB_CPUID_ARCHITECTURE));
     opts.out.print(" VAR=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_VARIANT));
+    PRINTHEX(READSCS(scs.CPUID, SCB_CPUID_VARIANT));
     opts.out.print(" IMPL=");
-    PRINTHEX(READSCS(SCB->CPUID, SCB_CPUID_IMPLEMENTER));
+    PRINTHEX(READSCS(scs.CPUID, SCB_CPUID_IMPLEMENTER));
     PRINTNL();
 
     opts.out.print("SysTick: ");
-    if (READSCS(SysTick->CTRL, SysTick_CTRL_ENABLE)) {
+    if (READSCS(scs.SysTick_CTRL, SysTick_CTRL_ENABLE)) {
         opts.out.print(" ENABLE");
     }
-    if (READSCS(SysTick->CTRL, SysTick_CTRL_TICKINT)) {
+    if (READSCS(scs.SysTick_CTRL, SysTick_CTRL_TICKINT)) {
         opts.out.print(" TICKINT");
     }
     opts.out.print(" clksource=");
-    opts.out.print(READSCS(SysTick->CTRL, SysTick_CTRL_CLKSOURCE) ? "CPU" : "EXT");
+    opts.out.print(READSCS(scs.SysTick_CTRL, SysTick_CTRL_CLKSOURCE) ? "CPU" : "EXT");
     opts.out.print(" RELOAD=");
-    opts.out.print(READSCS(SysTick->LOAD, SysTick_LOAD_RELOAD));
+    opts.out.print(READSCS(scs.SysTick_LOAD, SysTick_LOAD_RELOAD));
     opts.out.print(" TENMS=");
-    opts.out.print(READSCS(SysTick->CALIB, SysTick_CALIB_TENMS));
-    if (READSCS(SysTick->CALIB, SysTick_CALIB_SKEW)) {
+    opts.out.print(READSCS(scs.SysTick_CALIB, SysTick_CALIB_TENMS));
+    if (READSCS(scs.SysTick_CALIB, SysTick_CALIB_SKEW)) {
         opts.out.print(" SKEW");
     }
-    if (READSCS(SysTick->CALIB, SysTick_CALIB_NOREF)) {
+    if (READSCS(scs.SysTick_CALIB, SysTick_CALIB_NOREF)) {
         opts.out.print(" NOREF");
     }
     PRINTNL();
+    uint32_t enabled = scs.NVIC_ISER;
+    if (READSCS(scs.SysTick_CTRL, SysTick_CTRL_ENABLE) && READSCS(scs.SysTick_CTRL, SysTick_CTRL_TICKINT)) {
+        enabled |= 1UL << ZEROREGS_IRQ_SYSTICK;
+    }
+    uint32_t all = ((1UL << PERIPH_COUNT_IRQn) - 1) | (1UL << ZEROREGS_IRQ_SYSTICK);
+    uint8_t depth = 0;
     for (uint8_t pri = 0; pri < 4; pri++) {
         opts.out.print("irq pri");
         opts.out.print(pri);
         opts.out.print(": ");
-        for (uint8_t irq = 0; irq < PERIPH_COUNT_IRQn; irq++) {
-            if (pri == NVIC_GetPriority((IRQn_Type) irq)) {
-                switch (irq) {
-                    case 0: opts.out.print(" PM"); break;
-                    case 1: opts.out.print(" SYSCTRL"); break;
-                    case 2: opts.out.print(" WDT"); break;
-                    case 3: opts.out.print(" RTC"); break;
-                    case 4: opts.out.print(" EIC"); break;
-                    case 5: opts.out.print(" NVMCTRL"); break;
-                    case 6: opts.out.print(" DMAC"); break;
-                    case 7: opts.out.print(" USB"); break;
-                    case 8: opts.out.print(" EVSYS"); break;
-                    case 9: opts.out.print(" SERCOM0"); break;
-                    case 10: opts.out.print(" SERCOM1"); break;
-                    case 11: opts.out.print(" SERCOM2"); break;
-                    case 12: opts.out.print(" SERCOM3"); break;
-                    case 13: opts.out.print(" SERCOM4"); break;
-                    case 14: opts.out.print(" SERCOM5"); break;
-                    case 15: opts.out.print(" TCC0"); break;
-                    case 16: opts.out.print(" TCC1"); break;
-                    case 17: opts.out.print(" TCC2"); break;
-                    case 18: opts.out.print(" TC3"); break;
-                    case 19: opts.out.print(" TC4"); break;
-                    case 20: opts.out.print(" TC5"); break;
-                    case 21: opts.out.print(" TC6"); break;
-                    case 22: opts.out.print(" TC7"); break;
-                    case 23: opts.out.print(" ADC"); break;
-                    case 24: opts.out.print(" AC"); break;
-                    case 25: opts.out.print(" DAC"); break;
-                    case 26: opts.out.print(" PTC"); break;
-                    case 27: opts.out.print(" I2S"); break;
-                    default: PRINTHEX(irq); break;
-                }
+        bool used = false;
+        for (uint8_t bit = 0; bit < 32; bit++) {
+            if (bitRead(all, bit) && pri == ZeroRegs__irqPriority(scs, bit)) {
+                opts.out.print(" ");
+                ZeroRegs__printIRQ(opts, bit);
+                used = used || bitRead(enabled, bit);
+            }
+        }
+        PRINTNL();
+        if (used) {
+            depth++;
+        }
+    }
+
+    opts.out.print("irq enabled: ");
+    if (enabled) {
+        opts.out.print(" ");
+        ZeroRegs__printIRQs(opts, enabled, " ");
+    }
+    PRINTNL();
+    if (scs.NVIC_ISPR) {
+        opts.out.print("irq pending:  ");
+        ZeroRegs__printIRQs(opts, scs.NVIC_ISPR, " ");
+        PRINTNL();
+    }
+
+    // [B1.5.8 ARMv6-M ARM] a handler is only preempted by a more urgent
+    // priority, so handlers nest at most once per priority in use.  Each
+    // nesting stacks eight words, plus one more to keep the stack aligned.
+    opts.out.print("irq nesting:  depth=");
+    opts.out.print(depth);
+    opts.out.print(" frames=");
+    opts.out.print(depth * 36);
+    opts.out.println("bytes");
+
+    // how long each critical IRQ can wait: behind every other enabled IRQ
+    // at the same or a more urgent priority
+    for (uint8_t i = 0; i < opts.irqCriticalCount; i++) {
+        int8_t irq = opts.irqCritical[i];
+        uint8_t bit = irq == SysTick_IRQn ? ZEROREGS_IRQ_SYSTICK : irq;
+        if (irq < 0 && irq != SysTick_IRQn) {
+            continue;
+        }
+        uint8_t pri = ZeroRegs__irqPriority(scs, bit);
+        opts.out.print("irq ");
+        ZeroRegs__printIRQ(opts, bit);
+        opts.out.print(":  pri=");
+        opts.out.print(pri);
+        if (!bitRead(enabled, bit)) {
+            opts.out.println(" (disabled)");
+            continue;
+        }
+        uint32_t waits = 0;
+        for (uint8_t other = 0; other < 32; other++) {
+            if (other != bit && bitRead(enabled, other) && ZeroRegs__irqPriority(scs, other) <= pri) {
+                waits |= 1UL << other;
+            }
+        }
+        // unlisted IRQs are less critical than all listed ones
+        uint32_t inverted = waits;
+        for (uint8_t j = 0; j < i; j++) {
+            int8_t more = opts.irqCritical[j];
+            if (more == SysTick_IRQn) {
+                inverted &= ~(1UL << ZEROREGS_IRQ_SYSTICK);
+            } else if (more >= 0) {
+                inverted &= ~(1UL << more);
             }
         }
+        if (waits) {
+            opts.out.print(" waits=");
+            ZeroRegs__printIRQs(opts, waits, ",");
+        }
+        if (inverted) {
+            opts.out.print(" inverted=");
+            ZeroRegs__printIRQs(opts, inverted, ",");
+            opts.out.print(" (priority inversion)");
+        }
         PRINTNL();
     }
 }
 
+void printZeroRegSCS(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_SCS scs;
+    captureZeroRegSCS(scs);
+    printZeroRegSCS(opts, scs);
+}
+
 
 // `pmux` is a string "SERCOMx:y"
-void printZeroRegSERCOM_pinhint(ZeroRegOptions &opts, const char* pmux) {
+void printZeroRegSERCOM_pinhint(ZeroRegOptions &opts, const ZeroRegSnapshot_PORT &port, const char* pmux) {
     if (!pmux) {
         return;
     }
     uint8_t x = pmux[6] - '0';
     uint8_t y = pmux[8] - '0';
-    Sercom* sercom;
     switch (x) {
-        case 0: sercom = SERCOM0; break;
-        case 1: sercom = SERCOM1; break;
-        case 2: sercom = SERCOM2; break;
-        case 3: sercom = SERCOM3; break;
+        case 0: break;
+        case 1: break;
+        case 2: break;
+        case 3: break;
 #ifdef SERCOM4
-        case 4: sercom = SERCOM4; break;
+        case 4: break;
 #endif
 #ifdef SERCOM5
-        case 5: sercom = SERCOM5; break;
+        case 5: break;
 #endif
         default: return;
     }
+    SERCOM_USART_CTRLA_Type usartCtrla;
+    usartCtrla.reg = port.SERCOM_CTRLA[x];
+    SERCOM_SPI_CTRLA_Type spiCtrla;
+    spiCtrla.reg = port.SERCOM_CTRLA[x];
+    SERCOM_SPI_CTRLB_Type spiCtrlb;
+    spiCtrlb.reg = port.SERCOM_CTRLB[x];
     const char* pads[4];
     pads[0] = NULL;
     pads[1] = NULL;
     pads[2] = NULL;
     pads[3] = NULL;
-    switch (sercom->I2CM.CTRLA.bit.MODE) {
+    switch (usartCtrla.bit.MODE) {
         case 0x0:
             // USART external clock
-            switch (sercom->USART.CTRLA.bit.RXPO) {
+            switch (usartCtrla.bit.RXPO) {
                 case 0x0: pads[0] = ZeroRegs__usart_rx; break;
                 case 0x1: pads[1] = ZeroRegs__usart_rx; break;
                 case 0x2: pads[2] = ZeroRegs__usart_rx; break;
                 case 0x3: pads[3] = ZeroRegs__usart_rx; break;
             }
-            switch (sercom->USART.CTRLA.bit.TXPO) {
+            switch (usartCtrla.bit.TXPO) {
                 case 0x0:
                     pads[0] = ZeroRegs__usart_tx;
                     pads[1] = ZeroRegs__usart_xck;
@@ -1750,13 +2829,13 @@ void printZeroRegSERCOM_pinhint(ZeroRegOptions &opts, const char* pmux) {
             break;
         case 0x1:
             // USART internal clock
-            switch (sercom->USART.CTRLA.bit.RXPO) {
+            switch (usartCtrla.bit.RXPO) {
                 case 0x0: pads[0] = ZeroRegs__usart_rx; break;
                 case 0x1: pads[1] = ZeroRegs__usart_rx; break;
                 case 0x2: pads[2] = ZeroRegs__usart_rx; break;
                 case 0x3: pads[3] = ZeroRegs__usart_rx; break;
             }
-            switch (sercom->USART.CTRLA.bit.TXPO) {
+            switch (usartCtrla.bit.TXPO) {
                 case 0x0:
                     pads[0] = ZeroRegs__usart_tx;
                     break;
@@ -1772,13 +2851,13 @@ void printZeroRegSERCOM_pinhint(ZeroRegOptions &opts, const char* pmux) {
             break;
         case 0x2:
             // SPI slave
-            switch (sercom->SPI.CTRLA.bit.DIPO) {
+            switch (spiCtrla.bit.DIPO) {
                 case 0x0: pads[0] = ZeroRegs__spi_mosi; break;
                 case 0x1: pads[1] = ZeroRegs__spi_mosi; break;
                 case 0x2: pads[2] = ZeroRegs__spi_mosi; break;
                 case 0x3: pads[3] = ZeroRegs__spi_mosi; break;
             }
-            switch (sercom->SPI.CTRLA.bit.DOPO) {
+            switch (spiCtrla.bit.DOPO) {
                 case 0x0:
                     pads[0] = ZeroRegs__spi_miso;
                     pads[1] = ZeroRegs__spi_sck;
@@ -1803,38 +2882,38 @@ void printZeroRegSERCOM_pinhint(ZeroRegOptions &opts, const char* pmux) {
             break;
         case 0x3:
             // SPI master
-            switch (sercom->SPI.CTRLA.bit.DIPO) {
+            switch (spiCtrla.bit.DIPO) {
                 case 0x0: pads[0] = ZeroRegs__spi_miso; break;
                 case 0x1: pads[1] = ZeroRegs__spi_miso; break;
                 case 0x2: pads[2] = ZeroRegs__spi_miso; break;
                 case 0x3: pads[3] = ZeroRegs__spi_miso; break;
             }
-            switch (sercom->SPI.CTRLA.bit.DOPO) {
+            switch (spiCtrla.bit.DOPO) {
                 case 0x0:
                     pads[0] = ZeroRegs__spi_mosi;
                     pads[1] = ZeroRegs__spi_sck;
-                    if (sercom->SPI.CTRLB.bit.MSSEN) {
+                    if (spiCtrlb.bit.MSSEN) {
                         pads[2] = ZeroRegs__spi_ss;
                     }
                     break;
                 case 0x1:
                     pads[2] = ZeroRegs__spi_mosi;
                     pads[3] = ZeroRegs__spi_sck;
-                    if (sercom->SPI.CTRLB.bit.MSSEN) {
+                    if (spiCtrlb.bit.MSSEN) {
                         pads[1] = ZeroRegs__spi_ss;
                     }
                     break;
                 case 0x2:
                     pads[3] = ZeroRegs__spi_mosi;
                     pads[1] = ZeroRegs__spi_sck;
-                    if (sercom->SPI.CTRLB.bit.MSSEN) {
+                    if (spiCtrlb.bit.MSSEN) {
                         pads[2] = ZeroRegs__spi_ss;
                     }
                     break;
                 case 0x3:
                     pads[0] = ZeroRegs__spi_mosi;
                     pads[3] = ZeroRegs__spi_sck;
-                    if (sercom->SPI.CTRLB.bit.MSSEN) {
+                    if (spiCtrlb.bit.MSSEN) {
                         pads[1] = ZeroRegs__spi_ss;
                     }
                     break;
@@ -1858,35 +2937,113 @@ void printZeroRegSERCOM_pinhint(ZeroRegOptions &opts, const char* pmux) {
     }
 }
 
-void printZeroRegSERCOM_I2CM(ZeroRegOptions &opts, SercomI2cm &i2cm) {
-    opts.out.print("CTRLA: ");
-    PRINTFLAG(i2cm.CTRLA, ENABLE);
-    PRINTFLAG(i2cm.CTRLA, RUNSTDBY);
-    PRINTFLAG(i2cm.CTRLA, PINOUT);
-    opts.out.print(" sdahold=");
-    switch (i2cm.CTRLA.bit.SDAHOLD) {
-        case 0x0: opts.out.print("DIS"); break;
-        case 0x1: opts.out.print("75NS"); break;
-        case 0x2: opts.out.print("450NS"); break;
-        case 0x3: opts.out.print("600NS"); break;
+static const char* const ZeroRegsSERCOM_I2CM_SDAHOLDs[] = {
+    "DIS", "75NS", "450NS", "600NS",
+};
+static const char* const ZeroRegsSERCOM_I2CM_INACTOUTs[] = {
+    "DIS", "55NS", "105NS", "205NS",
+};
+// the same for I2C master and slave
+static const char* const ZeroRegsSERCOM_I2C_SPEEDs[] = {
+    "SM<100kHz,FM<400kHz", "FM+<1MHz", "HS<3.4MHz",
+};
+// the same for I2C slave and SPI
+static const char* const ZeroRegsSERCOM_AMODEs[] = {
+    "MASK", "2ADDRS", "RANGE",
+};
+// [28.6.2.4.1 DSrevF] and the I2C spec: the fastest SCL and the shortest SCL
+// low and high times for each SPEED
+struct ZeroRegsSERCOM_I2CM_Mode {
+    const char* name;
+    uint32_t    maxHz;
+    uint16_t    minLowNS;
+    uint16_t    minHighNS;
+};
+static const ZeroRegsSERCOM_I2CM_Mode ZeroRegsSERCOM_I2CM_Modes[] = {
+    { "Sm",     100000,     4700,   4000 },
+    { "Fm",     400000,     1300,   600 },
+    { "Fm+",    1000000,    500,    260 },
+    { "Hs",     3400000,    160,    60 },
+};
+// Prints the SCL timing which BAUD gives, and flags where it falls short of
+// (or goes past) what the SPEED allows.
+static void ZeroRegs__printI2CMTiming(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM_I2CM &i2cm, uint32_t coreHz) {
+    uint32_t high, low, riseNS;
+    if (i2cm.CTRLA.bit.SPEED == 0x2) {
+        // fSCL = fGCLK / (2 + HSBAUD + HSBAUDLOW)
+        high = i2cm.BAUD.bit.HSBAUD + 1;
+        low = (i2cm.BAUD.bit.HSBAUDLOW ? i2cm.BAUD.bit.HSBAUDLOW : i2cm.BAUD.bit.HSBAUD) + 1;
+        riseNS = 0;
+    } else {
+        // fSCL = fGCLK / (10 + BAUD + BAUDLOW + fGCLK * Trise)
+        high = i2cm.BAUD.bit.BAUD + 5;
+        low = (i2cm.BAUD.bit.BAUDLOW ? i2cm.BAUD.bit.BAUDLOW : i2cm.BAUD.bit.BAUD) + 5;
+        riseNS = ZEROREGS_I2C_RISE_NS;
     }
-    PRINTFLAG(i2cm.CTRLA, MEXTTOEN);
-    PRINTFLAG(i2cm.CTRLA, SEXTTOEN);
-    opts.out.print(" speed=");
-    switch (i2cm.CTRLA.bit.SPEED) {
-        case 0x0: opts.out.print("SM<100kHz,FM<400kHz"); break;
-        case 0x1: opts.out.print("FM+<1MHz"); break;
-        case 0x2: opts.out.print("HS<3.4MHz"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
+    uint32_t highNS = (uint32_t)((1000000000ULL * high + coreHz / 2) / coreHz);
+    uint32_t lowNS = (uint32_t)((1000000000ULL * low + coreHz / 2) / coreHz);
+    uint32_t scl = (uint32_t)(1000000000ULL / (highNS + lowNS + riseNS));
+
+    opts.out.print("SCL:  freq=");
+    PRINTHZ(scl);
+    opts.out.print(" high=");
+    ZeroRegs__printNS(opts.out, highNS);
+    opts.out.print(" low=");
+    ZeroRegs__printNS(opts.out, lowNS);
+    if (riseNS) {
+        opts.out.print(" rise=");
+        ZeroRegs__printNS(opts.out, riseNS);
+    }
+    // Reading a register is START, address+W, register, repeated START,
+    // address+R, data, STOP: four 9-bit bytes and about three more clocks.
+    opts.out.print(" regreads/s=");
+    opts.out.print(scl / (4 * 9 + 3));
+
+    uint8_t m = i2cm.CTRLA.bit.SPEED;
+    if (m == 0x0 && scl <= 100000 + 100000 / 50) {
+        m = 0;      // standard mode
+    } else if (m < 0x3) {
+        m++;        // Fm, Fm+, Hs
+    } else {
+        PRINTNL();
+        return;
+    }
+    const ZeroRegsSERCOM_I2CM_Mode &mode = ZeroRegsSERCOM_I2CM_Modes[m];
+    opts.out.print(" mode=");
+    opts.out.print(mode.name);
+    // allow 2% either way for rounding in the divider
+    if (scl > mode.maxHz + mode.maxHz / 50) {
+        opts.out.print(" (faster than ");
+        PRINTHZ(mode.maxHz);
+        opts.out.print(")");
+    } else if (scl < mode.maxHz - mode.maxHz / 50 && m != 0) {
+        opts.out.print(" (slower than the ");
+        PRINTHZ(mode.maxHz);
+        opts.out.print(" this speed allows)");
+    }
+    if (lowNS < mode.minLowNS) {
+        opts.out.print(" (low too short)");
     }
+    if (highNS < mode.minHighNS) {
+        opts.out.print(" (high too short)");
+    }
+    PRINTNL();
+}
+
+void printZeroRegSERCOM_I2CM(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM_I2CM &i2cm, uint32_t coreHz) {
+    opts.out.print("CTRLA: ");
+    PRINTFLAG(i2cm.CTRLA, ENABLE);
+    PRINTFLAG(i2cm.CTRLA, RUNSTDBY);
+    PRINTFLAG(i2cm.CTRLA, PINOUT);
+    opts.out.print(" sdahold=");
+    PRINTNAME(ZeroRegsSERCOM_I2CM_SDAHOLDs, i2cm.CTRLA.bit.SDAHOLD, ZeroRegs__empty);
+    PRINTFLAG(i2cm.CTRLA, MEXTTOEN);
+    PRINTFLAG(i2cm.CTRLA, SEXTTOEN);
+    opts.out.print(" speed=");
+    PRINTNAME(ZeroRegsSERCOM_I2C_SPEEDs, i2cm.CTRLA.bit.SPEED, ZeroRegs__RESERVED);
     PRINTFLAG(i2cm.CTRLA, SCLSM);
     opts.out.print(" inactout=");
-    switch (i2cm.CTRLA.bit.INACTOUT) {
-        case 0x0: opts.out.print("DIS"); break;
-        case 0x1: opts.out.print("55NS"); break;
-        case 0x2: opts.out.print("105NS"); break;
-        case 0x3: opts.out.print("205NS"); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_I2CM_INACTOUTs, i2cm.CTRLA.bit.INACTOUT, ZeroRegs__empty);
     PRINTFLAG(i2cm.CTRLA, LOWTOUTEN);
     PRINTNL();
 
@@ -1907,6 +3064,9 @@ void printZeroRegSERCOM_I2CM(ZeroRegOptions &opts, SercomI2cm &i2cm) {
     opts.out.print(" HSBAUDLOW=");
     PRINTHEX(i2cm.BAUD.bit.HSBAUDLOW);
     PRINTNL();
+    if (coreHz) {
+        ZeroRegs__printI2CMTiming(opts, i2cm, coreHz);
+    }
 
     opts.out.print("ADDR: ");
     opts.out.print(" ADDR=");
@@ -1919,26 +3079,16 @@ void printZeroRegSERCOM_I2CM(ZeroRegOptions &opts, SercomI2cm &i2cm) {
     PRINTNL();
 }
 
-void printZeroRegSERCOM_I2CS(ZeroRegOptions &opts, SercomI2cs &i2cs) {
+void printZeroRegSERCOM_I2CS(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM_I2CS &i2cs) {
     opts.out.print("CTRLA: ");
     PRINTFLAG(i2cs.CTRLA, ENABLE);
     PRINTFLAG(i2cs.CTRLA, RUNSTDBY);
     PRINTFLAG(i2cs.CTRLA, PINOUT);
     opts.out.print(" sdahold=");
-    switch (i2cs.CTRLA.bit.SDAHOLD) {
-        case 0x0: opts.out.print("DIS"); break;
-        case 0x1: opts.out.print("75NS"); break;
-        case 0x2: opts.out.print("450NS"); break;
-        case 0x3: opts.out.print("600NS"); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_I2CM_SDAHOLDs, i2cs.CTRLA.bit.SDAHOLD, ZeroRegs__empty);
     PRINTFLAG(i2cs.CTRLA, SEXTTOEN);
     opts.out.print(" speed=");
-    switch (i2cs.CTRLA.bit.SPEED) {
-        case 0x0: opts.out.print("SM<100kHz,FM<400kHz"); break;
-        case 0x1: opts.out.print("FM+<1MHz"); break;
-        case 0x2: opts.out.print("HS<3.4MHz"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_I2C_SPEEDs, i2cs.CTRLA.bit.SPEED, ZeroRegs__RESERVED);
     PRINTFLAG(i2cs.CTRLA, SCLSM);
     PRINTFLAG(i2cs.CTRLA, LOWTOUTEN);
     PRINTNL();
@@ -1948,12 +3098,7 @@ void printZeroRegSERCOM_I2CS(ZeroRegOptions &opts, SercomI2cs &i2cs) {
     PRINTFLAG(i2cs.CTRLB, GCMD);
     PRINTFLAG(i2cs.CTRLB, AACKEN);
     opts.out.print(" amode=");
-    switch (i2cs.CTRLB.bit.AMODE) {
-        case 0x0: opts.out.print("MASK"); break;
-        case 0x1: opts.out.print("2ADDRS"); break;
-        case 0x2: opts.out.print("RANGE"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_AMODEs, i2cs.CTRLB.bit.AMODE, ZeroRegs__RESERVED);
     opts.out.print(" ackact=");
     opts.out.print(i2cs.CTRLB.bit.ACKACT ? "NACK" : "ACK");
     PRINTNL();
@@ -1968,18 +3113,30 @@ void printZeroRegSERCOM_I2CS(ZeroRegOptions &opts, SercomI2cs &i2cs) {
     PRINTNL();
 }
 
-void printZeroRegSERCOM_SPI(ZeroRegOptions &opts, SercomSpi &spi, bool master) {
+// Prints how long one character takes on the wire at `bps`.
+static void ZeroRegs__printCharTime(ZeroRegOptions &opts, uint32_t bps, uint8_t bits) {
+    if (bps) {
+        opts.out.print(" char=");
+        ZeroRegs__printNS(opts.out, (uint32_t)((1000000000ULL * bits + bps / 2) / bps));
+    }
+}
+
+static const char* const ZeroRegsSERCOM_SPI_DIPOs[] = {
+    "PAD0", "PAD1", "PAD2", "PAD3",
+};
+static const char* const ZeroRegsSERCOM_SPI_FORMs[] = {
+    "SPI", ZeroRegs__RESERVED, "SPI_ADDR",
+};
+static const char* const ZeroRegsSERCOM_SPI_CHSIZEs[] = {
+    "8bit", "9bit",
+};
+void printZeroRegSERCOM_SPI(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM_SPI &spi, bool master, uint32_t coreHz) {
     opts.out.print("CTRLA: ");
     PRINTFLAG(spi.CTRLA, ENABLE);
     PRINTFLAG(spi.CTRLA, RUNSTDBY);
     PRINTFLAG(spi.CTRLA, IBON);
     opts.out.print(master ? " miso=" : " mosi=");
-    switch (spi.CTRLA.bit.DIPO) {
-        case 0x0: opts.out.print("PAD0"); break;
-        case 0x1: opts.out.print("PAD1"); break;
-        case 0x2: opts.out.print("PAD2"); break;
-        case 0x3: opts.out.print("PAD3"); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_SPI_DIPOs, spi.CTRLA.bit.DIPO, ZeroRegs__empty);
     opts.out.print(master ? " mosi=" : " miso=");
     switch (spi.CTRLA.bit.DOPO) {
         case 0x0:
@@ -2008,12 +3165,7 @@ void printZeroRegSERCOM_SPI(ZeroRegOptions &opts, SercomSpi &spi, bool master) {
             break;
     }
     opts.out.print(" form=");
-    switch (spi.CTRLA.bit.FORM) {
-        case 0x0: opts.out.print("SPI"); break;
-        /*   0x1 */
-        case 0x2: opts.out.print("SPI_ADDR"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_SPI_FORMs, spi.CTRLA.bit.FORM, ZeroRegs__RESERVED);
     opts.out.print(" cpha=");
     opts.out.print(spi.CTRLA.bit.CPHA ? "TRAILING" : "LEADING");
     opts.out.print(" cpol=");
@@ -2022,29 +3174,26 @@ void printZeroRegSERCOM_SPI(ZeroRegOptions &opts, SercomSpi &spi, bool master) {
     opts.out.print(spi.CTRLA.bit.DORD ? "LSB" : "MSB");
     PRINTNL();
 
-    while (spi.SYNCBUSY.bit.CTRLB) {}
     opts.out.print("CTRLB: ");
     opts.out.print(" chsize=");
-    switch (spi.CTRLB.bit.CHSIZE) {
-        case 0x0: opts.out.print("8bit"); break;
-        case 0x1: opts.out.print("9bit"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_SPI_CHSIZEs, spi.CTRLB.bit.CHSIZE, ZeroRegs__RESERVED);
     PRINTFLAG(spi.CTRLB, PLOADEN);
     PRINTFLAG(spi.CTRLB, SSDE);
     PRINTFLAG(spi.CTRLB, MSSEN);
     opts.out.print(" amode=");
-    switch (spi.CTRLB.bit.AMODE) {
-        case 0x0: opts.out.print("MASK"); break;
-        case 0x1: opts.out.print("2ADDRS"); break;
-        case 0x2: opts.out.print("RANGE"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_AMODEs, spi.CTRLB.bit.AMODE, ZeroRegs__RESERVED);
     PRINTFLAG(spi.CTRLB, RXEN);
     PRINTNL();
 
     opts.out.print("BAUD:  ");
     PRINTHEX(spi.BAUD.reg);
+    if (master && coreHz) {
+        // [25.6.2.3 DSrevF] synchronous: fBAUD = fref / (2 * (BAUD + 1))
+        uint32_t bps = coreHz / (2 * (spi.BAUD.reg + 1));
+        opts.out.print(" rate=");
+        ZeroRegs__printRate(opts.out, bps, "bps");
+        ZeroRegs__printCharTime(opts, bps, spi.CTRLB.bit.CHSIZE ? 9 : 8);
+    }
     PRINTNL();
 
     if (spi.CTRLA.bit.FORM == 0x2) {
@@ -2057,7 +3206,45 @@ void printZeroRegSERCOM_SPI(ZeroRegOptions &opts, SercomSpi &spi, bool master) {
     }
 }
 
-void printZeroRegSERCOM_USART(ZeroRegOptions &opts, SercomUsart &usart) {
+static const char* const ZeroRegsSERCOM_USART_RXPOs[] = {
+    " rx=PAD0", " rx=PAD1", " rx=PAD2", " rx=PAD3",
+};
+// The usual USART rates, to find the one which was probably intended.
+static const uint32_t ZeroRegsSERCOM_USART_RATEs[] = {
+    300, 600, 1200, 2400, 4800, 9600, 14400, 19200, 28800, 31250, 38400,
+    57600, 74880, 76800, 115200, 230400, 250000, 460800, 500000, 921600,
+    1000000, 1500000, 2000000, 3000000,
+};
+static const char* const ZeroRegsSERCOM_USART_SAMPRs[] = {
+    "16x", "16x-fractional", "8x", "8x-fractional", "3x",
+};
+static const char* const ZeroRegsSERCOM_USART_FORMs[] = {
+    "USART", "USART+PARITY", ZeroRegs__RESERVED, ZeroRegs__RESERVED, "AUTOBAUD", "AUTOBAUD+PARITY",
+};
+static const char* const ZeroRegsSERCOM_USART_CHSIZEs[] = {
+    "8bit", "9bit", ZeroRegs__RESERVED, ZeroRegs__RESERVED, ZeroRegs__RESERVED, "5bit", "6bit", "7bit",
+};
+// [25.6.2.3 DSrevF] Table 25-2 Baud Rate Equations, for the internal clock
+static uint32_t ZeroRegs__usartBPS(const ZeroRegSnapshot_SERCOM_USART &usart, uint32_t coreHz) {
+    if (usart.CTRLA.bit.CMODE) {
+        // synchronous
+        return coreHz / (2 * ((usart.BAUD.reg & 0xFF) + 1));
+    }
+    static const uint8_t samples[] = { 16, 16, 8, 8, 3 };
+    if (usart.CTRLA.bit.SAMPR >= sizeof(samples)) {
+        return 0;
+    }
+    uint32_t s = samples[usart.CTRLA.bit.SAMPR];
+    if (usart.CTRLA.bit.SAMPR & 0x1) {
+        // fractional: fBAUD = fref / (S * (BAUD + FP/8))
+        uint32_t div = s * (8 * usart.BAUD.FRAC.BAUD + usart.BAUD.FRAC.FP);
+        return div ? (uint32_t)((8ULL * coreHz + div / 2) / div) : 0;
+    }
+    // arithmetic: fBAUD = fref/S * (1 - BAUD/65536)
+    return (uint32_t)(((uint64_t)coreHz * (65536 - usart.BAUD.reg) + s * 32768) / (s * 65536));
+}
+
+void printZeroRegSERCOM_USART(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM_USART &usart, uint32_t coreHz) {
     opts.out.print("CTRLA: ");
     PRINTFLAG(usart.CTRLA, ENABLE);
     PRINTFLAG(usart.CTRLA, RUNSTDBY);
@@ -2073,21 +3260,8 @@ void printZeroRegSERCOM_USART(ZeroRegOptions &opts, SercomUsart &usart) {
     opts.out.print(" dord=");
     opts.out.print(usart.CTRLA.bit.CPOL ? "LSB" : "MSB");
     opts.out.print(" form=");
-    switch(usart.CTRLA.bit.FORM) {
-        case 0x0: opts.out.print("USART"); break;
-        case 0x1: opts.out.print("USART+PARITY"); break;
-        /*   0x2 */
-        /*   0x3 */
-        case 0x4: opts.out.print("AUTOBAUD"); break;
-        case 0x5: opts.out.print("AUTOBAUD+PARITY"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
-    switch (usart.CTRLA.bit.RXPO) {
-        case 0x0: opts.out.print(" rx=PAD0"); break;
-        case 0x1: opts.out.print(" rx=PAD1"); break;
-        case 0x2: opts.out.print(" rx=PAD2"); break;
-        case 0x3: opts.out.print(" rx=PAD3"); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_USART_FORMs, usart.CTRLA.bit.FORM, ZeroRegs__RESERVED);
+    PRINTNAME(ZeroRegsSERCOM_USART_RXPOs, usart.CTRLA.bit.RXPO, ZeroRegs__empty);
     switch (usart.CTRLA.bit.TXPO) {
         case 0x0:
             opts.out.print(" tx=PAD0");
@@ -2104,19 +3278,8 @@ void printZeroRegSERCOM_USART(ZeroRegOptions &opts, SercomUsart &usart) {
     }
     PRINTNL();
 
-    while (usart.SYNCBUSY.bit.CTRLB) {}
     opts.out.print("CTRLB:  chsize=");
-    switch (usart.CTRLB.bit.CHSIZE) {
-        case 0x0: opts.out.print("8bit"); break;
-        case 0x1: opts.out.print("9bit"); break;
-        /*   0x2 */
-        /*   0x3 */
-        /*   0x4 */
-        case 0x5: opts.out.print("5bit"); break;
-        case 0x6: opts.out.print("6bit"); break;
-        case 0x7: opts.out.print("7bit"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsSERCOM_USART_CHSIZEs, usart.CTRLB.bit.CHSIZE, ZeroRegs__RESERVED);
     PRINTFLAG(usart.CTRLB, SBMODE);
     PRINTFLAG(usart.CTRLB, COLDEN);
     PRINTFLAG(usart.CTRLB, SFDE);
@@ -2131,6 +3294,38 @@ void printZeroRegSERCOM_USART(ZeroRegOptions &opts, SercomUsart &usart) {
 
     opts.out.print("BAUD:  ");
     PRINTHEX(usart.BAUD.reg);
+    if (usart.CTRLA.bit.MODE == 1 && coreHz) {
+        if (!usart.CTRLA.bit.CMODE) {
+            opts.out.print(" sampr=");
+            PRINTNAME(ZeroRegsSERCOM_USART_SAMPRs, usart.CTRLA.bit.SAMPR, ZeroRegs__RESERVED);
+        }
+        uint32_t bps = ZeroRegs__usartBPS(usart, coreHz);
+        opts.out.print(" rate=");
+        opts.out.print(bps);
+        opts.out.print("bps");
+        if (bps) {
+            uint32_t nearest = ZeroRegsSERCOM_USART_RATEs[0];
+            for (uint8_t i = 1; i < sizeof(ZeroRegsSERCOM_USART_RATEs) / sizeof(ZeroRegsSERCOM_USART_RATEs[0]); i++) {
+                uint32_t rate = ZeroRegsSERCOM_USART_RATEs[i];
+                if ((rate > bps ? rate - bps : bps - rate) < (nearest > bps ? nearest - bps : bps - nearest)) {
+                    nearest = rate;
+                }
+            }
+            // in hundredths of a percent
+            int32_t error = (int32_t)(((int64_t)bps - nearest) * 10000 / nearest);
+            opts.out.print(" nearest=");
+            opts.out.print(nearest);
+            opts.out.print(" error=");
+            ZeroRegs__printPercent(opts.out, error, true);
+        }
+        // start bit, data, parity, and stop bits
+        uint8_t bits = 1 + (usart.CTRLB.bit.CHSIZE >= 5 ? usart.CTRLB.bit.CHSIZE : 8 + usart.CTRLB.bit.CHSIZE);
+        if (usart.CTRLA.bit.FORM & 0x1) {
+            bits++;
+        }
+        bits += usart.CTRLB.bit.SBMODE ? 2 : 1;
+        ZeroRegs__printCharTime(opts, bps, bits);
+    }
     PRINTNL();
 
     if (usart.CTRLB.bit.ENC) {
@@ -2140,358 +3335,1012 @@ void printZeroRegSERCOM_USART(ZeroRegOptions &opts, SercomUsart &usart) {
     }
 }
 
-void printZeroRegSERCOM(ZeroRegOptions &opts, Sercom* sercom, uint8_t idx) {
+void captureZeroRegSERCOM(ZeroRegSnapshot_SERCOM &snap, Sercom* sercom) {
     while (sercom->I2CM.CTRLA.bit.SWRST || sercom->I2CM.SYNCBUSY.reg) {}
-    if (!sercom->I2CM.CTRLA.bit.ENABLE && !opts.showDisabled) {
+    switch (sercom->I2CM.CTRLA.bit.MODE) {
+        case 0x0:
+        case 0x1:
+            while (sercom->USART.SYNCBUSY.bit.CTRLB) {}
+            snap.USART.CTRLA.reg = sercom->USART.CTRLA.reg;
+            snap.USART.CTRLB.reg = sercom->USART.CTRLB.reg;
+            snap.USART.BAUD.reg = sercom->USART.BAUD.reg;
+            snap.USART.RXPL.reg = sercom->USART.RXPL.reg;
+            break;
+        case 0x2:
+        case 0x3:
+            while (sercom->SPI.SYNCBUSY.bit.CTRLB) {}
+            snap.SPI.CTRLA.reg = sercom->SPI.CTRLA.reg;
+            snap.SPI.CTRLB.reg = sercom->SPI.CTRLB.reg;
+            snap.SPI.BAUD.reg = sercom->SPI.BAUD.reg;
+            snap.SPI.ADDR.reg = sercom->SPI.ADDR.reg;
+            break;
+        case 0x4:
+            snap.I2CS.CTRLA.reg = sercom->I2CS.CTRLA.reg;
+            snap.I2CS.CTRLB.reg = sercom->I2CS.CTRLB.reg;
+            snap.I2CS.ADDR.reg = sercom->I2CS.ADDR.reg;
+            break;
+        default:
+            snap.I2CM.CTRLA.reg = sercom->I2CM.CTRLA.reg;
+            snap.I2CM.CTRLB.reg = sercom->I2CM.CTRLB.reg;
+            snap.I2CM.BAUD.reg = sercom->I2CM.BAUD.reg;
+            snap.I2CM.ADDR.reg = sercom->I2CM.ADDR.reg;
+            break;
+    }
+}
+
+void printZeroRegSERCOM(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM &snap, uint8_t idx) {
+    printZeroRegSERCOM(opts, snap, idx, 0);
+}
+
+void printZeroRegSERCOM(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM &snap, uint8_t idx, uint32_t coreHz) {
+    if (!snap.I2CM.CTRLA.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.print("--------------------------- SERCOM");
     opts.out.print(idx);
-    switch (sercom->I2CM.CTRLA.bit.MODE) {
+    switch (snap.I2CM.CTRLA.bit.MODE) {
         case 0x0:
             opts.out.println(" USART (external clock)");
-            printZeroRegSERCOM_USART(opts, sercom->USART);
+            printZeroRegSERCOM_USART(opts, snap.USART, coreHz);
             break;
         case 0x1:
             opts.out.println(" USART (internal clock)");
-            printZeroRegSERCOM_USART(opts, sercom->USART);
+            printZeroRegSERCOM_USART(opts, snap.USART, coreHz);
             break;
         case 0x2:
             opts.out.println(" SPI slave");
-            printZeroRegSERCOM_SPI(opts, sercom->SPI, false);
+            printZeroRegSERCOM_SPI(opts, snap.SPI, false, coreHz);
             break;
         case 0x3:
             opts.out.println(" SPI master");
-            printZeroRegSERCOM_SPI(opts, sercom->SPI, true);
+            printZeroRegSERCOM_SPI(opts, snap.SPI, true, coreHz);
             break;
         case 0x4:
             opts.out.println(" I2C slave");
-            printZeroRegSERCOM_I2CS(opts, sercom->I2CS);
+            printZeroRegSERCOM_I2CS(opts, snap.I2CS);
             break;
         case 0x5:
             opts.out.println(" I2C master");
-            printZeroRegSERCOM_I2CM(opts, sercom->I2CM);
+            printZeroRegSERCOM_I2CM(opts, snap.I2CM, coreHz);
             break;
     }
 }
 
+// [16.6.2 DSrevF] Each peripheral has a bus clock (CLK_xxx_APB, from GCLK_MAIN
+// divided for that bus and gated by PM APBxMASK) for reaching its registers,
+// and many also have a core clock from a GCLK channel which runs the
+// peripheral itself.
+#define ZEROREGS_CLOCKS_NOGCLK 0xFF
+struct ZeroRegsCLOCKS_Peripheral {
+    const char* name;
+    uint8_t     bus;            // 0 = APBA, 1 = APBB, 2 = APBC
+    uint8_t     bit;            // in PM APBxMASK
+    uint8_t     gclkid;         // core clock, or ZEROREGS_CLOCKS_NOGCLK
+    uint8_t     uAperMHz;       // rough current its clocks draw, see printZeroRegIdleClocks()
+};
+static const char* const ZeroRegsCLOCKS_BUSes[] = {
+    "APBA", "APBB", "APBC",
+};
+static const ZeroRegsCLOCKS_Peripheral ZeroRegsCLOCKS_Peripherals[] = {
+    { "PAC0",       0, 0,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "PM",         0, 1,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "SYSCTRL",    0, 2,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "GCLK",       0, 3,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "WDT",        0, 4,   0x03,                   1 },
+    { "RTC",        0, 5,   0x04,                   1 },
+    { "EIC",        0, 6,   0x05,                   2 },
+    { "PAC1",       1, 0,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "DSU",        1, 1,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "NVMCTRL",    1, 2,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "PORT",       1, 3,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "DMAC",       1, 4,   ZEROREGS_CLOCKS_NOGCLK, 5 },
+    { "USB",        1, 5,   0x06,                   8 },
+    { "PAC2",       2, 0,   ZEROREGS_CLOCKS_NOGCLK, 0 },
+    { "EVSYS",      2, 1,   ZEROREGS_CLOCKS_NOGCLK, 2 },   // one GCLK per channel
+    { "SERCOM0",    2, 2,   0x14,                   4 },
+    { "SERCOM1",    2, 3,   0x15,                   4 },
+    { "SERCOM2",    2, 4,   0x16,                   4 },
+    { "SERCOM3",    2, 5,   0x17,                   4 },
+#ifdef SERCOM4
+    { "SERCOM4",    2, 6,   0x18,                   4 },
+#endif
+#ifdef SERCOM5
+    { "SERCOM5",    2, 7,   0x19,                   4 },
+#endif
+    { "TCC0",       2, 8,   0x1A,                   6 },
+    { "TCC1",       2, 9,   0x1A,                   6 },
+    { "TCC2",       2, 10,  0x1B,                   4 },
+    { "TC3",        2, 11,  0x1B,                   3 },
+    { "TC4",        2, 12,  0x1C,                   3 },
+    { "TC5",        2, 13,  0x1C,                   3 },
+#ifdef TC6
+    { "TC6",        2, 14,  0x1D,                   3 },
+#endif
+#ifdef TC7
+    { "TC7",        2, 15,  0x1D,                   3 },
+#endif
+    { "ADC",        2, 16,  0x1E,                   3 },
+    { "AC",         2, 17,  0x1F,                   2 },
+    { "DAC",        2, 18,  0x21,                   2 },
+    { "PTC",        2, 19,  0x22,                   3 },
+#ifdef I2S
+    { "I2S",        2, 20,  0x23,                   4 },
+#endif
+#ifdef AC1
+    { "AC1",        2, 21,  0x1F,                   2 },
+#endif
+#ifdef TCC3
+    { "TCC3",       2, 24,  0x25,                   6 },
+#endif
+};
+void printZeroRegClocks(ZeroRegOptions &opts, const ZeroRegSnapshot_PM &pm, const ZeroRegSnapshot_GCLK &gclk, const ZeroRegClocks &clocks) {
+    opts.out.println("--------------------------- CLOCKS");
+
+    // [16.6.2.3 DSrevF] the AHB runs at the same speed as the CPU
+    uint32_t cpu = clocks.GEN[0] >> pm.CPUSEL.bit.CPUDIV;
+    uint32_t bus[3] = {
+        clocks.GEN[0] >> pm.APBASEL.bit.APBADIV,
+        clocks.GEN[0] >> pm.APBBSEL.bit.APBBDIV,
+        clocks.GEN[0] >> pm.APBCSEL.bit.APBCDIV,
+    };
+    uint32_t mask[3] = { pm.APBAMASK.reg, pm.APBBMASK.reg, pm.APBCMASK.reg };
+    opts.out.print("CPU:  ");
+    PRINTHZ(cpu);
+    PRINTNL();
+    opts.out.print("AHB:  ");
+    PRINTHZ(cpu);
+    PRINTNL();
+    for (uint8_t b = 0; b < 3; b++) {
+        opts.out.print(ZeroRegsCLOCKS_BUSes[b]);
+        opts.out.print(":  ");
+        PRINTHZ(bus[b]);
+        PRINTNL();
+    }
+
+    for (uint8_t i = 0; i < sizeof(ZeroRegsCLOCKS_Peripherals) / sizeof(ZeroRegsCLOCKS_Peripherals[0]); i++) {
+        const ZeroRegsCLOCKS_Peripheral &p = ZeroRegsCLOCKS_Peripherals[i];
+        bool busOn = bitRead(mask[p.bus], p.bit);
+        bool coreOn = p.gclkid != ZEROREGS_CLOCKS_NOGCLK && gclk.CLKCTRL[p.gclkid].bit.CLKEN;
+        if (!busOn && !coreOn && !opts.showDisabled) {
+            continue;
+        }
+        opts.out.print(p.name);
+        opts.out.print(":  bus=");
+        opts.out.print(ZeroRegsCLOCKS_BUSes[p.bus]);
+        opts.out.print(":");
+        if (busOn) {
+            PRINTHZ(bus[p.bus]);
+        } else {
+            opts.out.print(ZeroRegs__DISABLED);
+        }
+        if (p.gclkid != ZEROREGS_CLOCKS_NOGCLK) {
+            opts.out.print(" core=");
+            if (coreOn) {
+                opts.out.print("GEN");
+                PRINTPAD2(gclk.CLKCTRL[p.gclkid].bit.GEN);
+                opts.out.print(":");
+                PRINTHZ(clocks.CLKCTRL[p.gclkid]);
+            } else {
+                opts.out.print(ZeroRegs__DISABLED);
+            }
+        }
+        if (coreOn && !busOn) {
+            // Its registers can't be reached, so it's probably a mistake
+            // (unless the GCLK channel is there for another peripheral).
+            bool shared = false;
+            for (uint8_t j = 0; j < sizeof(ZeroRegsCLOCKS_Peripherals) / sizeof(ZeroRegsCLOCKS_Peripherals[0]); j++) {
+                const ZeroRegsCLOCKS_Peripheral &q = ZeroRegsCLOCKS_Peripherals[j];
+                if (j != i && q.gclkid == p.gclkid && bitRead(mask[q.bus], q.bit)) {
+                    shared = true;
+                }
+            }
+            if (!shared) {
+                opts.out.print(" (no bus clock)");
+            }
+        }
+        if (coreOn && busOn && clocks.CLKCTRL[p.gclkid] && clocks.CLKCTRL[p.gclkid] < bus[p.bus]) {
+            opts.out.print(" (core slower than bus)");
+        }
+        PRINTNL();
+    }
+}
+
+// [37.12 DSrevF] Maximum operating frequency for each number of flash wait
+// states, for VDD 1.62V-2.7V and for VDD 2.7V-3.63V.
+static const uint32_t ZeroRegsNVMCTRL_MAXHZs[2][4] = {
+    { 14000000, 28000000, 42000000, 48000000 },
+    { 24000000, 48000000, 48000000, 48000000 },
+};
+// How many wait states the CPU clock needs, or 0xFF if it's too fast for any.
+// This allows 0.2% over, so that the DFLL48M closed-loop from a 32.768kHz
+// crystal (48.005MHz) counts as 48MHz.
+static uint8_t ZeroRegs__waitStates(uint32_t cpuHz, bool vddHigh) {
+    for (uint8_t rws = 0; rws < 4; rws++) {
+        uint32_t max = ZeroRegsNVMCTRL_MAXHZs[vddHigh][rws];
+        if (cpuHz <= max + max / 500) {
+            return rws;
+        }
+    }
+    return 0xFF;
+}
 
-void printZeroRegSYSCTRL(ZeroRegOptions &opts) {
+void printZeroRegWaitStates(ZeroRegOptions &opts, const ZeroRegSnapshot_NVMCTRL &nvmctrl, const ZeroRegSnapshot_SYSCTRL &sysctrl, uint32_t cpuHz) {
+    // VDD is only known to be 2.7V or more if BOD33 resets below that.
+    // [37.11.4 DSrevF] LEVEL 0x27 is 2.84V typical, 2.74V minimum
+    bool vddKnown = sysctrl.BOD33.bit.ENABLE && sysctrl.BOD33.bit.ACTION == 0x1 && sysctrl.BOD33.bit.LEVEL >= 0x27;
+    uint8_t rws = nvmctrl.CTRLB.bit.RWS;
+    uint8_t needs = ZeroRegs__waitStates(cpuHz, true);
+    uint8_t needsLow = ZeroRegs__waitStates(cpuHz, false);
+
+    opts.out.print("NVM:  RWS=");
+    opts.out.print(rws);
+    if (!cpuHz) {
+        opts.out.print(" needs=");
+        opts.out.print(ZeroRegs__UNKNOWN);
+    } else if (needs == 0xFF) {
+        opts.out.print(" (CPU faster than the flash can go)");
+    } else {
+        opts.out.print(" needs=");
+        opts.out.print(needs);
+        if (vddKnown) {
+            opts.out.print(" (VDD 2.7V+ from BOD33)");
+        } else if (needsLow != needs) {
+            opts.out.print(" (");
+            if (needsLow == 0xFF) {
+                opts.out.print("too fast");
+            } else {
+                opts.out.print(needsLow);
+            }
+            opts.out.print(" if VDD under 2.7V)");
+        }
+        if (rws < needs) {
+            opts.out.print(" (too few wait states, unsafe)");
+        } else if (rws > needs && (vddKnown || rws > needsLow || needsLow == 0xFF)) {
+            opts.out.print(" (more wait states than needed)");
+        }
+    }
+    if (nvmctrl.CTRLB.bit.CACHEDIS) {
+        opts.out.print(" (cache disabled)");
+    }
+    if (nvmctrl.CTRLB.bit.READMODE != 0x0) {
+        opts.out.print(" (readmode not NO_MISS_PENALTY)");
+    }
+    PRINTNL();
+}
+
+// Whether the peripheral on APBx `bus` at `bit` is enabled, or -1 if it's
+// always needed (or how it's enabled isn't captured).
+static int8_t ZeroRegs__peripheralEnabled(const ZeroRegSnapshot &snap, uint8_t bus, uint8_t bit) {
+    if (bus == 0) {
+        switch (bit) {
+            case 4: return snap.wdt.CTRL.bit.ENABLE;
+            case 5: return snap.rtc.MODE0.CTRL.bit.ENABLE;
+            case 6: return snap.eic.CTRL.bit.ENABLE;
+        }
+    } else if (bus == 1) {
+        switch (bit) {
+            case 4: return snap.dmac.CTRL.bit.DMAENABLE;
+            case 5: return snap.usb.DEVICE.CTRLA.bit.ENABLE;
+        }
+    } else {
+        if (bit == 1) {
+            ZeroRegEVSYSRoute routes[12];
+            return computeZeroRegEVSYSRoutes(routes, snap.evsys) > 0;
+        }
+        if (bit >= 2 && bit <= 7) {
+            // ENABLE is in the same place in every mode
+            return snap.sercom[bit - 2].USART.CTRLA.bit.ENABLE;
+        }
+        if (bit >= 8 && bit <= 10) {
+            return snap.tcc[bit - 8].CTRLA.bit.ENABLE;
+        }
+        if (bit >= 11 && bit <= 15) {
+            return snap.tc[bit - 11].COUNT8.CTRLA.bit.ENABLE;
+        }
+        switch (bit) {
+            case 16: return snap.adc.CTRLA.bit.ENABLE;
+            case 17: return snap.ac.CTRLA.bit.ENABLE;
+            case 18: return snap.dac.CTRLA.bit.ENABLE;
+#ifdef I2S
+            case 20: {
+                I2S_CTRLA_Type ctrla;
+                ctrla.reg = snap.i2s.CTRLA;
+                return ctrla.bit.ENABLE;
+            }
+#endif
+            case 24: return snap.tcc[3].CTRLA.bit.ENABLE;
+        }
+    }
+    return -1;
+}
+
+// Rough current (in uA) a clock draws when it feeds nothing: per MHz for a
+// generator or GCLK channel, and for each oscillator.  These are ballpark
+// figures for ranking what to turn off, not for a power budget.
+#define ZEROREGS_GCLK_UAPERMHZ 1
+static const uint16_t ZeroRegsSYSCTRL_UAs[] = {
+    200,    // XOSC
+    2,      // XOSC32K
+    1,      // OSC32K
+    64,     // OSC8M
+    400,    // DFLL48M
+    500,    // FDPLL96M
+};
+
+void printZeroRegIdleClocks(ZeroRegOptions &opts, const ZeroRegSnapshot &snap) {
+    opts.out.println("--------------------------- IDLECLOCKS");
+    ZeroRegClocks clocks;
+    computeZeroRegClocks(clocks, snap.sysctrl, snap.gclk, opts.xoscHz);
+    const ZeroRegSnapshot_PM &pm = snap.pm;
+    const ZeroRegSnapshot_GCLK &gclk = snap.gclk;
+    uint32_t bus[3] = {
+        clocks.GEN[0] >> pm.APBASEL.bit.APBADIV,
+        clocks.GEN[0] >> pm.APBBSEL.bit.APBBDIV,
+        clocks.GEN[0] >> pm.APBCSEL.bit.APBCDIV,
+    };
+    uint32_t mask[3] = { pm.APBAMASK.reg, pm.APBBMASK.reg, pm.APBCMASK.reg };
+    uint32_t total = 0;
+
+    // bus and core clocks of disabled peripherals
+    const uint8_t count = sizeof(ZeroRegsCLOCKS_Peripherals) / sizeof(ZeroRegsCLOCKS_Peripherals[0]);
+    for (uint8_t i = 0; i < count; i++) {
+        const ZeroRegsCLOCKS_Peripheral &p = ZeroRegsCLOCKS_Peripherals[i];
+        if (ZeroRegs__peripheralEnabled(snap, p.bus, p.bit) != 0) {
+            continue;
+        }
+        uint32_t busHz = bitRead(mask[p.bus], p.bit) ? bus[p.bus] : 0;
+        // [16.6.2.3 DSrevF] DMAC and USB also have an AHB clock
+        uint32_t ahbHz = 0;
+        if ((p.bus == 1 && p.bit == 4 && pm.AHBMASK.bit.DMAC_) || (p.bus == 1 && p.bit == 5 && pm.AHBMASK.bit.USB_)) {
+            ahbHz = clocks.GEN[0] >> pm.CPUSEL.bit.CPUDIV;
+        }
+        // a shared GCLK channel is only idle if all its peripherals are
+        uint32_t coreHz = 0;
+        if (p.gclkid != ZEROREGS_CLOCKS_NOGCLK && gclk.CLKCTRL[p.gclkid].bit.CLKEN) {
+            coreHz = clocks.CLKCTRL[p.gclkid];
+            for (uint8_t j = 0; j < count; j++) {
+                const ZeroRegsCLOCKS_Peripheral &q = ZeroRegsCLOCKS_Peripherals[j];
+                if (j != i && q.gclkid == p.gclkid && (j < i || ZeroRegs__peripheralEnabled(snap, q.bus, q.bit) != 0)) {
+                    coreHz = 0;
+                }
+            }
+        }
+        if (!busHz && !ahbHz && !coreHz) {
+            continue;
+        }
+        uint32_t uA = (uint32_t)(((uint64_t)busHz + ahbHz + coreHz) * p.uAperMHz / 1000000);
+        total += uA;
+        opts.out.print(p.name);
+        opts.out.print(": ");
+        if (busHz) {
+            opts.out.print(" bus=");
+            opts.out.print(ZeroRegsCLOCKS_BUSes[p.bus]);
+            opts.out.print(":");
+            PRINTHZ(busHz);
+        }
+        if (ahbHz) {
+            opts.out.print(" ahb=");
+            PRINTHZ(ahbHz);
+        }
+        if (coreHz) {
+            opts.out.print(" core=GEN");
+            PRINTPAD2(gclk.CLKCTRL[p.gclkid].bit.GEN);
+            opts.out.print(":");
+            PRINTHZ(coreHz);
+        }
+        opts.out.print(" wasted=");
+        opts.out.print(uA);
+        opts.out.println("uA (disabled)");
+    }
+
+    // [24.6.2.6 DSrevF] event channel clocks (GCLK_EVSYS_CHANNELx), which the
+    // asynchronous path doesn't use
+    ZeroRegEVSYSRoute routes[12];
+    uint8_t routeCount = computeZeroRegEVSYSRoutes(routes, snap.evsys);
+    for (uint8_t chid = 0; chid < 12; chid++) {
+        uint8_t gclkid = 0x07 + chid;
+        if (!gclk.CLKCTRL[gclkid].bit.CLKEN) {
+            continue;
+        }
+        const char* why = "(unused)";
+        for (uint8_t r = 0; r < routeCount; r++) {
+            if (routes[r].CHANNEL == chid) {
+                why = routes[r].PATH == 0x2 ? "(asynchronous path)" : NULL;
+            }
+        }
+        if (!why) {
+            continue;
+        }
+        uint32_t uA = (uint32_t)((uint64_t)clocks.CLKCTRL[gclkid] * ZEROREGS_GCLK_UAPERMHZ / 1000000);
+        total += uA;
+        opts.out.print("EVSYS_CHANNEL");
+        PRINTPAD2(chid);
+        opts.out.print(":  core=GEN");
+        PRINTPAD2(gclk.CLKCTRL[gclkid].bit.GEN);
+        opts.out.print(":");
+        PRINTHZ(clocks.CLKCTRL[gclkid]);
+        opts.out.print(" wasted=");
+        opts.out.print(uA);
+        opts.out.print("uA ");
+        opts.out.println(why);
+    }
+
+    // generators with nothing using them
+    for (uint8_t genid = 1; genid < 9; genid++) {
+        if (!gclk.GENCTRL[genid].bit.GENEN || gclk.GENCTRL[genid].bit.OE) {
+            continue;
+        }
+        bool used = false;
+        for (uint8_t gclkid = 0; gclkid < ZEROREGS_GCLK_CHANNELS; gclkid++) {
+            if (gclk.CLKCTRL[gclkid].bit.CLKEN && gclk.CLKCTRL[gclkid].bit.GEN == genid) {
+                used = true;
+            }
+        }
+        // [15.8.4 DSrevF] GEN1 can be the source for the others
+        for (uint8_t other = 0; other < 9; other++) {
+            if (genid == 1 && other != 1 && gclk.GENCTRL[other].bit.GENEN && gclk.GENCTRL[other].bit.SRC == 0x2) {
+                used = true;
+            }
+        }
+        if (used) {
+            continue;
+        }
+        uint32_t uA = (uint32_t)((uint64_t)clocks.GEN[genid] * ZEROREGS_GCLK_UAPERMHZ / 1000000);
+        total += uA;
+        opts.out.print("GEN");
+        PRINTPAD2(genid);
+        opts.out.print(":  src=");
+        PRINTNAME(ZeroRegsGCLK_SRCs, gclk.GENCTRL[genid].bit.SRC, ZeroRegs__RESERVED);
+        opts.out.print(" freq=");
+        PRINTHZ(clocks.GEN[genid]);
+        opts.out.print(" wasted=");
+        opts.out.print(uA);
+        opts.out.println("uA (no users)");
+    }
+
+    // oscillators which run whether or not anything wants them
+    const ZeroRegSnapshot_SYSCTRL &sysctrl = snap.sysctrl;
+    struct {
+        const char* name;
+        uint8_t     src;        // GENCTRL.SRC
+        bool        running;    // enabled, and not ONDEMAND
+        uint32_t    hz;
+    } oscs[] = {
+        { "XOSC",       0x0, sysctrl.XOSC.bit.ENABLE && !sysctrl.XOSC.bit.ONDEMAND,          clocks.XOSC },
+        { "XOSC32K",    0x5, sysctrl.XOSC32K.bit.ENABLE && !sysctrl.XOSC32K.bit.ONDEMAND,    clocks.XOSC32K },
+        { "OSC32K",     0x4, sysctrl.OSC32K.bit.ENABLE && !sysctrl.OSC32K.bit.ONDEMAND,      clocks.OSC32K },
+        { "OSC8M",      0x6, sysctrl.OSC8M.bit.ENABLE && !sysctrl.OSC8M.bit.ONDEMAND,        clocks.OSC8M },
+        { "DFLL48M",    0x7, sysctrl.DFLLCTRL.bit.ENABLE && !sysctrl.DFLLCTRL.bit.ONDEMAND,  clocks.DFLL48M },
+        { "FDPLL96M",   0x8, sysctrl.DPLLCTRLA.bit.ENABLE && !sysctrl.DPLLCTRLA.bit.ONDEMAND, clocks.FDPLL96M },
+    };
+    for (uint8_t o = 0; o < sizeof(oscs) / sizeof(oscs[0]); o++) {
+        if (!oscs[o].running) {
+            continue;
+        }
+        bool used = false;
+        for (uint8_t genid = 0; genid < 9; genid++) {
+            if (gclk.GENCTRL[genid].bit.GENEN && gclk.GENCTRL[genid].bit.SRC == oscs[o].src) {
+                used = true;
+            }
+        }
+        // [17.6.8.2 DSrevF] the FDPLL96M can use XOSC32K or XOSC directly
+        if (sysctrl.DPLLCTRLA.bit.ENABLE) {
+            if ((o == 0 && sysctrl.DPLLCTRLB.bit.REFCLK == 0x1) || (o == 1 && sysctrl.DPLLCTRLB.bit.REFCLK == 0x0)) {
+                used = true;
+            }
+        }
+        if (used) {
+            continue;
+        }
+        total += ZeroRegsSYSCTRL_UAs[o];
+        opts.out.print(oscs[o].name);
+        opts.out.print(":  freq=");
+        PRINTHZ(oscs[o].hz);
+        opts.out.print(" wasted=");
+        opts.out.print(ZeroRegsSYSCTRL_UAs[o]);
+        opts.out.println("uA (no users, not ONDEMAND)");
+    }
+
+    opts.out.print("total:  wasted=");
+    opts.out.print(total);
+    opts.out.println("uA");
+}
+
+void printZeroRegIdleClocks(ZeroRegOptions &opts) {
+    ZeroRegSnapshot snap;
+    captureZeroRegs(snap);
+    printZeroRegIdleClocks(opts, snap);
+}
+
+void printZeroRegClocks(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_SYSCTRL sysctrl;
+    ZeroRegSnapshot_GCLK gclk;
+    ZeroRegSnapshot_PM pm;
+    ZeroRegClocks clocks;
+    captureZeroRegSYSCTRL(sysctrl);
+    captureZeroRegGCLK(gclk);
+    ZeroRegSnapshot_NVMCTRL nvmctrl;
+    captureZeroRegPM(pm);
+    captureZeroRegNVMCTRL(nvmctrl);
+    computeZeroRegClocks(clocks, sysctrl, gclk, opts.xoscHz);
+    printZeroRegClocks(opts, pm, gclk, clocks);
+    printZeroRegWaitStates(opts, nvmctrl, sysctrl, clocks.GEN[0] >> pm.CPUSEL.bit.CPUDIV);
+}
+
+
+void printZeroRegSERCOM(ZeroRegOptions &opts, Sercom* sercom, uint8_t idx) {
+    ZeroRegSnapshot_SYSCTRL sysctrl;
+    ZeroRegSnapshot_GCLK gclk;
+    ZeroRegClocks clocks;
+    ZeroRegSnapshot_SERCOM snap;
+    captureZeroRegSYSCTRL(sysctrl);
+    captureZeroRegGCLK(gclk);
+    computeZeroRegClocks(clocks, sysctrl, gclk, opts.xoscHz);
+    captureZeroRegSERCOM(snap, sercom);
+    printZeroRegSERCOM(opts, snap, idx, clocks.CLKCTRL[GCLK_CLKCTRL_ID_SERCOM0_CORE_Val + idx]);
+}
+
+
+void captureZeroRegSYSCTRL(ZeroRegSnapshot_SYSCTRL &sysctrl) {
+    sysctrl.XOSC.reg = SYSCTRL->XOSC.reg;
+    sysctrl.XOSC32K.reg = SYSCTRL->XOSC32K.reg;
+    sysctrl.OSC32K.reg = SYSCTRL->OSC32K.reg;
+    sysctrl.OSCULP32K.reg = SYSCTRL->OSCULP32K.reg;
+    sysctrl.OSC8M.reg = SYSCTRL->OSC8M.reg;
+    sysctrl.DFLLCTRL.reg = SYSCTRL->DFLLCTRL.reg;
+    sysctrl.DFLLMUL.reg = SYSCTRL->DFLLMUL.reg;
+    sysctrl.BOD33.reg = SYSCTRL->BOD33.reg;
+    sysctrl.VREG.reg = SYSCTRL->VREG.reg;
+    sysctrl.VREF.reg = SYSCTRL->VREF.reg;
+    sysctrl.DPLLCTRLA.reg = SYSCTRL->DPLLCTRLA.reg;
+    sysctrl.DPLLRATIO.reg = SYSCTRL->DPLLRATIO.reg;
+    sysctrl.DPLLCTRLB.reg = SYSCTRL->DPLLCTRLB.reg;
+}
+
+static const char* const ZeroRegsSYSCTRL_FRANGEs[] = {
+    "4-6MHz", "6-8MHz", "8-11MHz", "11-15MHz",
+};
+static const char* const ZeroRegsSYSCTRL_GAINs[] = {
+    "2MHz", "4MHz", "8MHz", "16MHz", "30MHz",
+};
+static const char* const ZeroRegsSYSCTRL_BOD33_ACTIONs[] = {
+    "NONE", "RESET", "INT",
+};
+void printZeroRegSYSCTRL(ZeroRegOptions &opts, const ZeroRegSnapshot_SYSCTRL &sysctrl, const ZeroRegClocks *clocks) {
     opts.out.println("--------------------------- SYSCTRL");
 
-    if (SYSCTRL->OSC32K.bit.ENABLE || opts.showDisabled) {
+    if (sysctrl.OSC32K.bit.ENABLE || opts.showDisabled) {
         opts.out.print("OSC32K: ");
-        PRINTFLAG(SYSCTRL->OSC32K, ENABLE);
-        PRINTFLAG(SYSCTRL->OSC32K, EN32K);
-        PRINTFLAG(SYSCTRL->OSC32K, EN1K);
-        PRINTFLAG(SYSCTRL->OSC32K, RUNSTDBY);
-        PRINTFLAG(SYSCTRL->OSC32K, ONDEMAND);
-        PRINTFLAG(SYSCTRL->OSC32K, WRTLOCK);
+        PRINTFLAG(sysctrl.OSC32K, ENABLE);
+        PRINTFLAG(sysctrl.OSC32K, EN32K);
+        PRINTFLAG(sysctrl.OSC32K, EN1K);
+        PRINTFLAG(sysctrl.OSC32K, RUNSTDBY);
+        PRINTFLAG(sysctrl.OSC32K, ONDEMAND);
+        PRINTFLAG(sysctrl.OSC32K, WRTLOCK);
         opts.out.print(" STARTUP=");
-        PRINTHEX(SYSCTRL->OSC32K.bit.STARTUP);
+        PRINTHEX(sysctrl.OSC32K.bit.STARTUP);
         opts.out.print(" CALIB=");
-        PRINTHEX(SYSCTRL->OSC32K.bit.CALIB);
+        PRINTHEX(sysctrl.OSC32K.bit.CALIB);
+        if (clocks && sysctrl.OSC32K.bit.ENABLE) {
+            opts.out.print(" freq=");
+            PRINTHZ(clocks->OSC32K);
+        }
         PRINTNL();
     }
 
     opts.out.print("OSCULP32K:  CALIB=");
-    PRINTHEX(SYSCTRL->OSCULP32K.bit.CALIB);
-    PRINTFLAG(SYSCTRL->OSCULP32K, WRTLOCK);
+    PRINTHEX(sysctrl.OSCULP32K.bit.CALIB);
+    PRINTFLAG(sysctrl.OSCULP32K, WRTLOCK);
+    if (clocks) {
+        opts.out.print(" freq=");
+        PRINTHZ(clocks->OSCULP32K);
+    }
     PRINTNL();
 
-    if (SYSCTRL->OSC8M.bit.ENABLE || opts.showDisabled) {
+    if (sysctrl.OSC8M.bit.ENABLE || opts.showDisabled) {
         opts.out.print("OSC8M: ");
-        PRINTFLAG(SYSCTRL->OSC8M, ENABLE);
-        PRINTFLAG(SYSCTRL->OSC8M, RUNSTDBY);
-        PRINTFLAG(SYSCTRL->OSC8M, ONDEMAND);
+        PRINTFLAG(sysctrl.OSC8M, ENABLE);
+        PRINTFLAG(sysctrl.OSC8M, RUNSTDBY);
+        PRINTFLAG(sysctrl.OSC8M, ONDEMAND);
         opts.out.print(" presc=");
-        PRINTSCALE(SYSCTRL->OSC8M.bit.PRESC);
+        PRINTSCALE(sysctrl.OSC8M.bit.PRESC);
         opts.out.print(" CALIB=");
-        PRINTHEX(SYSCTRL->OSC8M.bit.CALIB);
+        PRINTHEX(sysctrl.OSC8M.bit.CALIB);
         opts.out.print(" frange=");
-        switch (SYSCTRL->OSC8M.bit.FRANGE) {
-            case 0x0: opts.out.print("4-6MHz"); break;
-            case 0x1: opts.out.print("6-8MHz"); break;
-            case 0x2: opts.out.print("8-11MHz"); break;
-            case 0x3: opts.out.print("11-15MHz"); break;
+        PRINTNAME(ZeroRegsSYSCTRL_FRANGEs, sysctrl.OSC8M.bit.FRANGE, ZeroRegs__empty);
+        if (clocks && sysctrl.OSC8M.bit.ENABLE) {
+            opts.out.print(" freq=");
+            PRINTHZ(clocks->OSC8M);
         }
         PRINTNL();
     }
 
-    if (SYSCTRL->XOSC.bit.ENABLE || opts.showDisabled) {
+    if (sysctrl.XOSC.bit.ENABLE || opts.showDisabled) {
         opts.out.print("XOSC: ");
-        PRINTFLAG(SYSCTRL->XOSC, ENABLE);
-        PRINTFLAG(SYSCTRL->XOSC, XTALEN);
-        PRINTFLAG(SYSCTRL->XOSC, RUNSTDBY);
-        PRINTFLAG(SYSCTRL->XOSC, ONDEMAND);
-        PRINTFLAG(SYSCTRL->XOSC, AMPGC);
+        PRINTFLAG(sysctrl.XOSC, ENABLE);
+        PRINTFLAG(sysctrl.XOSC, XTALEN);
+        PRINTFLAG(sysctrl.XOSC, RUNSTDBY);
+        PRINTFLAG(sysctrl.XOSC, ONDEMAND);
+        PRINTFLAG(sysctrl.XOSC, AMPGC);
         opts.out.print(" gain=");
-        switch (SYSCTRL->XOSC.bit.GAIN) {
-            case 0x0: opts.out.print("2MHz"); break;
-            case 0x1: opts.out.print("4MHz"); break;
-            case 0x2: opts.out.print("8MHz"); break;
-            case 0x3: opts.out.print("16MHz"); break;
-            case 0x4: opts.out.print("30MHz"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        PRINTNAME(ZeroRegsSYSCTRL_GAINs, sysctrl.XOSC.bit.GAIN, ZeroRegs__RESERVED);
         opts.out.print(" STARTUP=");
-        PRINTHEX(SYSCTRL->XOSC.bit.STARTUP);
+        PRINTHEX(sysctrl.XOSC.bit.STARTUP);
+        if (clocks && sysctrl.XOSC.bit.ENABLE) {
+            opts.out.print(" freq=");
+            PRINTHZ(clocks->XOSC);
+        }
         PRINTNL();
     }
 
-    if (SYSCTRL->XOSC32K.bit.ENABLE || opts.showDisabled) {
+    if (sysctrl.XOSC32K.bit.ENABLE || opts.showDisabled) {
         opts.out.print("XOSC32K: ");
-        PRINTFLAG(SYSCTRL->XOSC32K, ENABLE);
-        PRINTFLAG(SYSCTRL->XOSC32K, XTALEN);
-        PRINTFLAG(SYSCTRL->XOSC32K, EN32K);
-        PRINTFLAG(SYSCTRL->XOSC32K, EN1K);
-        PRINTFLAG(SYSCTRL->XOSC32K, AAMPEN);
-        PRINTFLAG(SYSCTRL->XOSC32K, RUNSTDBY);
-        PRINTFLAG(SYSCTRL->XOSC32K, ONDEMAND);
-        PRINTFLAG(SYSCTRL->XOSC32K, WRTLOCK);
+        PRINTFLAG(sysctrl.XOSC32K, ENABLE);
+        PRINTFLAG(sysctrl.XOSC32K, XTALEN);
+        PRINTFLAG(sysctrl.XOSC32K, EN32K);
+        PRINTFLAG(sysctrl.XOSC32K, EN1K);
+        PRINTFLAG(sysctrl.XOSC32K, AAMPEN);
+        PRINTFLAG(sysctrl.XOSC32K, RUNSTDBY);
+        PRINTFLAG(sysctrl.XOSC32K, ONDEMAND);
+        PRINTFLAG(sysctrl.XOSC32K, WRTLOCK);
         opts.out.print(" STARTUP=");
-        PRINTHEX(SYSCTRL->XOSC32K.bit.STARTUP);
+        PRINTHEX(sysctrl.XOSC32K.bit.STARTUP);
+        if (clocks && sysctrl.XOSC32K.bit.ENABLE) {
+            opts.out.print(" freq=");
+            PRINTHZ(clocks->XOSC32K);
+        }
         PRINTNL();
     }
 
-    if (SYSCTRL->DFLLCTRL.bit.ENABLE || opts.showDisabled) {
+    if (sysctrl.DFLLCTRL.bit.ENABLE || opts.showDisabled) {
         opts.out.print("DFLL: ");
-        PRINTFLAG(SYSCTRL->DFLLCTRL, ENABLE);
+        PRINTFLAG(sysctrl.DFLLCTRL, ENABLE);
         opts.out.print(" mode=");
-        opts.out.print(SYSCTRL->DFLLCTRL.bit.MODE ? "closed-loop" : "open-loop");
-        PRINTFLAG(SYSCTRL->DFLLCTRL, STABLE);
-        PRINTFLAG(SYSCTRL->DFLLCTRL, LLAW);
-        PRINTFLAG(SYSCTRL->DFLLCTRL, USBCRM);
-        PRINTFLAG(SYSCTRL->DFLLCTRL, RUNSTDBY);
-        PRINTFLAG(SYSCTRL->DFLLCTRL, ONDEMAND);
-        PRINTFLAG(SYSCTRL->DFLLCTRL, CCDIS);
-        PRINTFLAG(SYSCTRL->DFLLCTRL, QLDIS);
-        PRINTFLAG(SYSCTRL->DFLLCTRL, BPLCKC);
-        PRINTFLAG(SYSCTRL->DFLLCTRL, WAITLOCK);
-        if (SYSCTRL->DFLLCTRL.bit.MODE == 1) {
+        opts.out.print(sysctrl.DFLLCTRL.bit.MODE ? "closed-loop" : "open-loop");
+        PRINTFLAG(sysctrl.DFLLCTRL, STABLE);
+        PRINTFLAG(sysctrl.DFLLCTRL, LLAW);
+        PRINTFLAG(sysctrl.DFLLCTRL, USBCRM);
+        PRINTFLAG(sysctrl.DFLLCTRL, RUNSTDBY);
+        PRINTFLAG(sysctrl.DFLLCTRL, ONDEMAND);
+        PRINTFLAG(sysctrl.DFLLCTRL, CCDIS);
+        PRINTFLAG(sysctrl.DFLLCTRL, QLDIS);
+        PRINTFLAG(sysctrl.DFLLCTRL, BPLCKC);
+        PRINTFLAG(sysctrl.DFLLCTRL, WAITLOCK);
+        if (sysctrl.DFLLCTRL.bit.MODE == 1) {
             opts.out.print(" MUL=");
-            opts.out.print(SYSCTRL->DFLLMUL.bit.MUL);
+            opts.out.print(sysctrl.DFLLMUL.bit.MUL);
+        }
+        if (clocks && sysctrl.DFLLCTRL.bit.ENABLE) {
+            opts.out.print(" freq=");
+            PRINTHZ(clocks->DFLL48M);
         }
         PRINTNL();
     }
 
-    if (SYSCTRL->DPLLCTRLA.bit.ENABLE || opts.showDisabled) {
+    if (sysctrl.DPLLCTRLA.bit.ENABLE || opts.showDisabled) {
         opts.out.print("DPLL: ");
-        PRINTFLAG(SYSCTRL->DPLLCTRLA, ENABLE);
-        PRINTFLAG(SYSCTRL->DPLLCTRLA, RUNSTDBY);
-        PRINTFLAG(SYSCTRL->DPLLCTRLA, ONDEMAND);
-        //FUTURE -- calculate actual clock speed [out = REFCLK * (LDR+1+(LDRFRAC/16))]
+        PRINTFLAG(sysctrl.DPLLCTRLA, ENABLE);
+        PRINTFLAG(sysctrl.DPLLCTRLA, RUNSTDBY);
+        PRINTFLAG(sysctrl.DPLLCTRLA, ONDEMAND);
         opts.out.print(" refclk=");
-        switch (SYSCTRL->DPLLCTRLB.bit.REFCLK) {
+        switch (sysctrl.DPLLCTRLB.bit.REFCLK) {
             case 0x0: opts.out.print("XOSC32"); break;
             case 0x1:
+                      // fDIV = fXOSC / (2 * (DIV + 1))
                       opts.out.print("XOSC/");
-                      PRINTSCALE(SYSCTRL->DPLLCTRLB.bit.DIV + 1);
+                      opts.out.print(2 * (sysctrl.DPLLCTRLB.bit.DIV + 1));
                       break;
             case 0x2: opts.out.print("GCLK_DPLL"); break;
             default: opts.out.print(ZeroRegs__RESERVED); break;
         }
         opts.out.print(" ldr=");
-        opts.out.print(SYSCTRL->DPLLRATIO.bit.LDR);
+        opts.out.print(sysctrl.DPLLRATIO.bit.LDR);
         opts.out.print(".");
-        opts.out.print(SYSCTRL->DPLLRATIO.bit.LDRFRAC);
+        opts.out.print(sysctrl.DPLLRATIO.bit.LDRFRAC);
         opts.out.print(" FILTER=");
-        PRINTHEX(SYSCTRL->DPLLCTRLB.bit.FILTER);
-        PRINTFLAG(SYSCTRL->DPLLCTRLB, LPEN);
-        PRINTFLAG(SYSCTRL->DPLLCTRLB, WUF);
+        PRINTHEX(sysctrl.DPLLCTRLB.bit.FILTER);
+        PRINTFLAG(sysctrl.DPLLCTRLB, LPEN);
+        PRINTFLAG(sysctrl.DPLLCTRLB, WUF);
         opts.out.print(" LTIME=");
-        PRINTHEX(SYSCTRL->DPLLCTRLB.bit.LTIME);
-        PRINTFLAG(SYSCTRL->DPLLCTRLB, LBYPASS);
+        PRINTHEX(sysctrl.DPLLCTRLB.bit.LTIME);
+        PRINTFLAG(sysctrl.DPLLCTRLB, LBYPASS);
+        if (clocks && sysctrl.DPLLCTRLA.bit.ENABLE) {
+            opts.out.print(" freq=");
+            PRINTHZ(clocks->FDPLL96M);
+        }
         PRINTNL();
     }
 
-    if (SYSCTRL->BOD33.bit.ENABLE || opts.showDisabled) {
+    if (sysctrl.BOD33.bit.ENABLE || opts.showDisabled) {
         opts.out.print("BOD33: ");
-        PRINTFLAG(SYSCTRL->BOD33, ENABLE);
-        PRINTFLAG(SYSCTRL->BOD33, HYST);
-        PRINTFLAG(SYSCTRL->BOD33, RUNSTDBY);
-        PRINTFLAG(SYSCTRL->BOD33, MODE);
-        PRINTFLAG(SYSCTRL->BOD33, CEN);
+        PRINTFLAG(sysctrl.BOD33, ENABLE);
+        PRINTFLAG(sysctrl.BOD33, HYST);
+        PRINTFLAG(sysctrl.BOD33, RUNSTDBY);
+        PRINTFLAG(sysctrl.BOD33, MODE);
+        PRINTFLAG(sysctrl.BOD33, CEN);
         opts.out.print(" action=");
-        switch (SYSCTRL->BOD33.bit.ACTION) {
-            case 0x0: opts.out.print("NONE"); break;
-            case 0x1: opts.out.print("RESET"); break;
-            case 0x2: opts.out.print("INT"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        PRINTNAME(ZeroRegsSYSCTRL_BOD33_ACTIONs, sysctrl.BOD33.bit.ACTION, ZeroRegs__RESERVED);
         opts.out.print(" psel=");
-        PRINTSCALE(SYSCTRL->BOD33.bit.PSEL + 1);
+        PRINTSCALE(sysctrl.BOD33.bit.PSEL + 1);
         opts.out.print(" LEVEL=");
-        PRINTHEX(SYSCTRL->BOD33.bit.LEVEL);
+        PRINTHEX(sysctrl.BOD33.bit.LEVEL);
         PRINTNL();
     }
 
     opts.out.print("VREG: ");
-    PRINTFLAG(SYSCTRL->VREG, RUNSTDBY);
-    PRINTFLAG(SYSCTRL->VREG, FORCELDO);
+    PRINTFLAG(sysctrl.VREG, RUNSTDBY);
+    PRINTFLAG(sysctrl.VREG, FORCELDO);
     PRINTNL();
 
     opts.out.print("VREF: ");
-    PRINTFLAG(SYSCTRL->VREF, TSEN);
-    PRINTFLAG(SYSCTRL->VREF, BGOUTEN);
+    PRINTFLAG(sysctrl.VREF, TSEN);
+    PRINTFLAG(sysctrl.VREF, BGOUTEN);
     opts.out.print(" CALIB=");
-    PRINTHEX(SYSCTRL->VREF.bit.CALIB);
+    PRINTHEX(sysctrl.VREF.bit.CALIB);
     PRINTNL();
 }
 
+void printZeroRegSYSCTRL(ZeroRegOptions &opts, const ZeroRegSnapshot_SYSCTRL &sysctrl) {
+    printZeroRegSYSCTRL(opts, sysctrl, NULL);
+}
+
+void printZeroRegSYSCTRL(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_SYSCTRL sysctrl;
+    ZeroRegSnapshot_GCLK gclk;
+    ZeroRegClocks clocks;
+    captureZeroRegSYSCTRL(sysctrl);
+    captureZeroRegGCLK(gclk);
+    computeZeroRegClocks(clocks, sysctrl, gclk, opts.xoscHz);
+    printZeroRegSYSCTRL(opts, sysctrl, &clocks);
+}
 
-void printZeroRegTC(ZeroRegOptions &opts, Tc* tc, uint8_t idx) {
+
+void captureZeroRegTC(ZeroRegSnapshot_TC &snap, Tc* tc) {
     while (tc->COUNT8.CTRLA.bit.SWRST || tc->COUNT8.STATUS.bit.SYNCBUSY) {}
-    if (!opts.showDisabled && !tc->COUNT8.CTRLA.bit.ENABLE) {
-        return;
-    }
-    opts.out.print("--------------------------- TC");
-    opts.out.print(idx);
-    opts.out.print(" ");
+    // CTRLA, CTRLB, CTRLC, and EVCTRL are at the same place in all modes
+    snap.COUNT8.CTRLA.reg = tc->COUNT8.CTRLA.reg;
+    snap.COUNT8.CTRLBSET.reg = tc->COUNT8.CTRLBSET.reg;
+    snap.COUNT8.CTRLC.reg = tc->COUNT8.CTRLC.reg;
+    snap.COUNT8.EVCTRL.reg = tc->COUNT8.EVCTRL.reg;
     switch (tc->COUNT8.CTRLA.bit.MODE) {
-        case 0x0: opts.out.println("COUNT16"); break;
-        case 0x1: opts.out.println("COUNT8"); break;
-        case 0x2: opts.out.println("COUNT32"); break;
-        default:
-                  opts.out.println(ZeroRegs__UNKNOWN);
-                  return;
+        case 0x0:
+            snap.COUNT16.CC[0].reg = tc->COUNT16.CC[0].reg;
+            snap.COUNT16.CC[1].reg = tc->COUNT16.CC[1].reg;
+            break;
+        case 0x1:
+            snap.COUNT8.PER.reg = tc->COUNT8.PER.reg;
+            snap.COUNT8.CC[0].reg = tc->COUNT8.CC[0].reg;
+            snap.COUNT8.CC[1].reg = tc->COUNT8.CC[1].reg;
+            break;
+        case 0x2:
+            snap.COUNT32.CC[0].reg = tc->COUNT32.CC[0].reg;
+            snap.COUNT32.CC[1].reg = tc->COUNT32.CC[1].reg;
+            break;
     }
+}
 
-    opts.out.print("CTRLA: ");
-    PRINTFLAG(tc->COUNT8.CTRLA, ENABLE);
-    PRINTFLAG(tc->COUNT8.CTRLA, RUNSTDBY);
-    opts.out.print(" wavegen=");
-    switch (tc->COUNT8.CTRLA.bit.WAVEGEN) {
-        case 0x0: opts.out.print("NFRQ"); break;
-        case 0x1: opts.out.print("MFRQ"); break;
-        case 0x2: opts.out.print("NPWM"); break;
-        case 0x3: opts.out.print("MPWM"); break;
-    }
-    opts.out.print(" prescaler=");
-    switch (tc->COUNT8.CTRLA.bit.PRESCALER) {
-        case 0x0: opts.out.print("DIV1"); break;
-        case 0x1: opts.out.print("DIV2"); break;
-        case 0x2: opts.out.print("DIV4"); break;
-        case 0x3: opts.out.print("DIV8"); break;
-        case 0x4: opts.out.print("DIV16"); break;
-        case 0x5: opts.out.print("DIV64"); break;
-        case 0x6: opts.out.print("DIV256"); break;
-        case 0x7: opts.out.print("DIV1024"); break;
-    }
-    opts.out.print(" prescsync=");
-    switch (tc->COUNT8.CTRLA.bit.PRESCSYNC) {
-        case 0x0: opts.out.print("GCLK"); break;
-        case 0x1: opts.out.print("PRESC"); break;
-        case 0x2: opts.out.print("RESYNC"); break;
-        default:  opts.out.print(ZeroRegs__UNKNOWN); break;
+static const char* const ZeroRegsTC_WAVEGENs[] = {
+    "NFRQ", "MFRQ", "NPWM", "MPWM",
+};
+static const char* const ZeroRegsTC_PRESCALERs[] = {
+    "DIV1", "DIV2", "DIV4", "DIV8", "DIV16", "DIV64", "DIV256", "DIV1024",
+};
+// the same for TC and TCC
+static const char* const ZeroRegsTC_PRESCSYNCs[] = {
+    "GCLK", "PRESC", "RESYNC",
+};
+static const char* const ZeroRegsTC_EVACTs[] = {
+    "OFF", "RETRIGGER", "COUNT", "START", ZeroRegs__RESERVED, "PPW", "PWP", ZeroRegs__RESERVED,
+};
+// [30.6.2.5 DSrevF] and [31.6.2.5 DSrevF] how much the prescaler divides by
+static const uint16_t ZeroRegsTC_PRESCALER_DIVs[] = {
+    1, 2, 4, 8, 16, 64, 256, 1024,
+};
+
+// Prints the counter's tick rate, TOP, the frequency it produces, and its
+// resolution.  `period` is how many ticks a waveform period takes, in units
+// of 1/2^`dith` ticks (`dith` being how many bits of dithering, TCC only).
+static void ZeroRegs__printCounter(ZeroRegOptions &opts, uint32_t coreHz, uint8_t prescaler, uint32_t top, uint64_t period, uint8_t dith) {
+    uint32_t tick = coreHz / ZeroRegsTC_PRESCALER_DIVs[prescaler];
+    opts.out.print("counter:  tick=");
+    PRINTHZ(tick);
+    opts.out.print(" top=");
+    opts.out.print(top);
+    opts.out.print(" freq=");
+    uint32_t freq = period ? (uint32_t)(((uint64_t)tick << dith) / period) : 0;
+    if (tick && period && !freq) {
+        opts.out.print("<1Hz");
+    } else {
+        PRINTHZ(freq);
+    }
+    opts.out.print(" res=");
+    opts.out.print(ZeroRegs__bits((uint64_t)top + 1));
+    if (dith) {
+        opts.out.print("+");
+        opts.out.print(dith);
+    }
+    opts.out.print("bits");
+    PRINTNL();
+}
+
+// Prints the duty cycle of a compare channel, as part of its CCx line.
+static void ZeroRegs__printDuty(ZeroRegOptions &opts, uint64_t cc, uint64_t period, bool invert) {
+    if (cc > period) {
+        cc = period;
+    }
+    int32_t duty = period ? (int32_t)(cc * 10000 / period) : 0;
+    opts.out.print(" duty=");
+    ZeroRegs__printPercent(opts.out, invert ? 10000 - duty : duty, false);
+}
+
+void printZeroRegTC(ZeroRegOptions &opts, const ZeroRegSnapshot_TC &snap, uint8_t idx) {
+    printZeroRegTC(opts, snap, idx, 0);
+}
+
+void printZeroRegTC(ZeroRegOptions &opts, const ZeroRegSnapshot_TC &snap, uint8_t idx, uint32_t coreHz) {
+    if (!opts.showDisabled && !snap.COUNT8.CTRLA.bit.ENABLE) {
+        return;
+    }
+    opts.out.print("--------------------------- TC");
+    opts.out.print(idx);
+    opts.out.print(" ");
+    switch (snap.COUNT8.CTRLA.bit.MODE) {
+        case 0x0: opts.out.println("COUNT16"); break;
+        case 0x1: opts.out.println("COUNT8"); break;
+        case 0x2: opts.out.println("COUNT32"); break;
+        default:
+                  opts.out.println(ZeroRegs__UNKNOWN);
+                  return;
     }
+
+    opts.out.print("CTRLA: ");
+    PRINTFLAG(snap.COUNT8.CTRLA, ENABLE);
+    PRINTFLAG(snap.COUNT8.CTRLA, RUNSTDBY);
+    opts.out.print(" wavegen=");
+    PRINTNAME(ZeroRegsTC_WAVEGENs, snap.COUNT8.CTRLA.bit.WAVEGEN, ZeroRegs__empty);
+    opts.out.print(" prescaler=");
+    PRINTNAME(ZeroRegsTC_PRESCALERs, snap.COUNT8.CTRLA.bit.PRESCALER, ZeroRegs__empty);
+    opts.out.print(" prescsync=");
+    PRINTNAME(ZeroRegsTC_PRESCSYNCs, snap.COUNT8.CTRLA.bit.PRESCSYNC, ZeroRegs__UNKNOWN);
     PRINTNL();
 
     opts.out.print("CTRLB:  dir=");
-    opts.out.print(tc->COUNT8.CTRLBSET.bit.DIR ? "DOWN" : "UP");
-    PRINTFLAG(tc->COUNT8.CTRLBSET, ONESHOT);
+    opts.out.print(snap.COUNT8.CTRLBSET.bit.DIR ? "DOWN" : "UP");
+    PRINTFLAG(snap.COUNT8.CTRLBSET, ONESHOT);
     PRINTNL();
 
     opts.out.print("CTRLC: ");
-    PRINTFLAG(tc->COUNT8.CTRLC, INVEN0);
-    PRINTFLAG(tc->COUNT8.CTRLC, INVEN1);
-    PRINTFLAG(tc->COUNT8.CTRLC, CPTEN0);
-    PRINTFLAG(tc->COUNT8.CTRLC, CPTEN1);
+    PRINTFLAG(snap.COUNT8.CTRLC, INVEN0);
+    PRINTFLAG(snap.COUNT8.CTRLC, INVEN1);
+    PRINTFLAG(snap.COUNT8.CTRLC, CPTEN0);
+    PRINTFLAG(snap.COUNT8.CTRLC, CPTEN1);
     PRINTNL();
 
     opts.out.print("EVCTRL:  evact=");
-    switch (tc->COUNT8.EVCTRL.bit.EVACT) {
-        case 0x0: opts.out.print("OFF"); break;
-        case 0x1: opts.out.print("RETRIGGER"); break;
-        case 0x2: opts.out.print("COUNT"); break;
-        case 0x3: opts.out.print("START"); break;
-        case 0x4: opts.out.print(ZeroRegs__RESERVED); break;
-        case 0x5: opts.out.print("PPW"); break;
-        case 0x6: opts.out.print("PWP"); break;
-        case 0x7: opts.out.print(ZeroRegs__RESERVED); break;
-    }
-    PRINTFLAG(tc->COUNT8.EVCTRL, TCINV);
-    PRINTFLAG(tc->COUNT8.EVCTRL, TCEI);
-    PRINTFLAG(tc->COUNT8.EVCTRL, OVFEO);
-    PRINTFLAG(tc->COUNT8.EVCTRL, MCEO0);
-    PRINTFLAG(tc->COUNT8.EVCTRL, MCEO1);
-    PRINTNL();
-
-    if (tc->COUNT8.CTRLA.bit.MODE == 0x1) {
+    PRINTNAME(ZeroRegsTC_EVACTs, snap.COUNT8.EVCTRL.bit.EVACT, ZeroRegs__empty);
+    PRINTFLAG(snap.COUNT8.EVCTRL, TCINV);
+    PRINTFLAG(snap.COUNT8.EVCTRL, TCEI);
+    PRINTFLAG(snap.COUNT8.EVCTRL, OVFEO);
+    PRINTFLAG(snap.COUNT8.EVCTRL, MCEO0);
+    PRINTFLAG(snap.COUNT8.EVCTRL, MCEO1);
+    PRINTNL();
+
+    if (snap.COUNT8.CTRLA.bit.MODE == 0x1) {
         opts.out.print("PER:  ");
-        opts.out.println(tc->COUNT8.PER.bit.PER);
+        opts.out.println(snap.COUNT8.PER.bit.PER);
     }
 
-    opts.out.print("CC0:  ");
-    switch (tc->COUNT8.CTRLA.bit.MODE) {
-        case 0x0: opts.out.println(tc->COUNT16.CC[0].bit.CC); break;
-        case 0x1: opts.out.println(tc->COUNT8.CC[0].bit.CC); break;
-        case 0x2: opts.out.println(tc->COUNT32.CC[0].bit.CC); break;
+    uint32_t cc[2];
+    uint32_t max = 0;
+    for (uint8_t id = 0; id < 2; id++) {
+        switch (snap.COUNT8.CTRLA.bit.MODE) {
+            case 0x0: cc[id] = snap.COUNT16.CC[id].bit.CC; max = 0xFFFF; break;
+            case 0x1: cc[id] = snap.COUNT8.CC[id].bit.CC; max = snap.COUNT8.PER.bit.PER; break;
+            case 0x2: cc[id] = snap.COUNT32.CC[id].bit.CC; max = 0xFFFFFFFF; break;
+        }
+    }
+    // [30.6.2.6 DSrevF] MFRQ and MPWM use CC0 as TOP, the others use MAX
+    // (which in COUNT8 is PER)
+    uint8_t wavegen = snap.COUNT8.CTRLA.bit.WAVEGEN;
+    uint32_t top = (wavegen == 0x1 || wavegen == 0x3) ? cc[0] : max;
+    // frequency generation toggles the output once per period, so takes two
+    uint64_t period = (uint64_t)top + 1;
+    if (coreHz) {
+        ZeroRegs__printCounter(opts, coreHz, snap.COUNT8.CTRLA.bit.PRESCALER, top, wavegen < 0x2 ? 2 * period : period, 0);
     }
 
-    opts.out.print("CC1:  ");
-    switch (tc->COUNT8.CTRLA.bit.MODE) {
-        case 0x0: opts.out.println(tc->COUNT16.CC[1].bit.CC); break;
-        case 0x1: opts.out.println(tc->COUNT8.CC[1].bit.CC); break;
-        case 0x2: opts.out.println(tc->COUNT32.CC[1].bit.CC); break;
+    for (uint8_t id = 0; id < 2; id++) {
+        opts.out.print("CC");
+        opts.out.print(id);
+        opts.out.print(":  ");
+        opts.out.print(cc[id]);
+        // in MPWM, CC0 is TOP instead of a duty cycle
+        if (coreHz && (wavegen == 0x2 || (wavegen == 0x3 && id == 1))) {
+            ZeroRegs__printDuty(opts, cc[id], period, snap.COUNT8.CTRLC.reg & (TC_CTRLC_INVEN0 << id));
+        }
+        PRINTNL();
     }
 }
 
+// the GCLK channel for TC3 to TC7
+static const uint8_t ZeroRegsTC_GCLKIDs[] = {
+    0x1B, 0x1C, 0x1C, 0x1D, 0x1D,
+};
+void printZeroRegTC(ZeroRegOptions &opts, Tc* tc, uint8_t idx) {
+    ZeroRegSnapshot_SYSCTRL sysctrl;
+    ZeroRegSnapshot_GCLK gclk;
+    ZeroRegClocks clocks;
+    ZeroRegSnapshot_TC snap;
+    captureZeroRegSYSCTRL(sysctrl);
+    captureZeroRegGCLK(gclk);
+    computeZeroRegClocks(clocks, sysctrl, gclk, opts.xoscHz);
+    captureZeroRegTC(snap, tc);
+    printZeroRegTC(opts, snap, idx, clocks.CLKCTRL[ZeroRegsTC_GCLKIDs[idx - 3]]);
+}
 
-void printZeroRegTCC(ZeroRegOptions &opts, Tcc* tcc, uint8_t idx) {
+
+void captureZeroRegTCC(ZeroRegSnapshot_TCC &snap, Tcc* tcc) {
     while (tcc->CTRLA.bit.SWRST || tcc->SYNCBUSY.bit.ENABLE) {}
-    if (!tcc->CTRLA.bit.ENABLE && !opts.showDisabled) {
+    snap.CTRLA.reg = tcc->CTRLA.reg;
+    while (tcc->SYNCBUSY.bit.CTRLB) {}
+    snap.CTRLBSET.reg = tcc->CTRLBSET.reg;
+    snap.FCTRLA.reg = tcc->FCTRLA.reg;
+    snap.FCTRLB.reg = tcc->FCTRLB.reg;
+    snap.WEXCTRL.reg = tcc->WEXCTRL.reg;
+    snap.DRVCTRL.reg = tcc->DRVCTRL.reg;
+    snap.EVCTRL.reg = tcc->EVCTRL.reg;
+    while (tcc->SYNCBUSY.bit.PATT) {}
+    snap.PATT.reg = tcc->PATT.reg;
+    while (tcc->SYNCBUSY.bit.WAVE) {}
+    snap.WAVE.reg = tcc->WAVE.reg;
+    while (tcc->SYNCBUSY.bit.PER) {}
+    snap.PER.reg = tcc->PER.reg;
+    for (uint8_t id = 0; id < 4; id++) {
+        while (tcc->SYNCBUSY.vec.CC & (1<<id)) {}
+        snap.CC[id].reg = tcc->CC[id].reg;
+    }
+}
+
+static const char* const ZeroRegsTCC_RESOLUTIONs[] = {
+    "NONE", "DITH4", "DITH5", "DITH6",
+};
+void printZeroRegTCC(ZeroRegOptions &opts, const ZeroRegSnapshot_TCC &snap, uint8_t idx) {
+    printZeroRegTCC(opts, snap, idx, 0);
+}
+
+void printZeroRegTCC(ZeroRegOptions &opts, const ZeroRegSnapshot_TCC &snap, uint8_t idx, uint32_t coreHz) {
+    if (!snap.CTRLA.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.print("--------------------------- TCC");
     opts.out.println(idx);
 
     opts.out.print("CTRLA: ");
-    PRINTFLAG(tcc->CTRLA, ENABLE);
-    PRINTFLAG(tcc->CTRLA, RUNSTDBY);
-    uint8_t dith = tcc->CTRLA.bit.RESOLUTION;
+    PRINTFLAG(snap.CTRLA, ENABLE);
+    PRINTFLAG(snap.CTRLA, RUNSTDBY);
+    uint8_t dith = snap.CTRLA.bit.RESOLUTION;
     opts.out.print(" resolution=");
-    switch (dith) {
-        case 0x0: opts.out.print("NONE"); break;
-        case 0x1: opts.out.print("DITH4"); break;
-        case 0x2: opts.out.print("DITH5"); break;
-        case 0x3: opts.out.print("DITH6"); break;
-    }
+    PRINTNAME(ZeroRegsTCC_RESOLUTIONs, dith, ZeroRegs__empty);
     opts.out.print(" prescaler=");
-    switch (tcc->CTRLA.bit.PRESCALER) {
-        case 0x0: opts.out.print("DIV1"); break;
-        case 0x1: opts.out.print("DIV2"); break;
-        case 0x2: opts.out.print("DIV4"); break;
-        case 0x3: opts.out.print("DIV8"); break;
-        case 0x4: opts.out.print("DIV16"); break;
-        case 0x5: opts.out.print("DIV64"); break;
-        case 0x6: opts.out.print("DIV256"); break;
-        case 0x7: opts.out.print("DIV1024"); break;
-    }
+    PRINTNAME(ZeroRegsTC_PRESCALERs, snap.CTRLA.bit.PRESCALER, ZeroRegs__empty);
     opts.out.print(" prescsync=");
-    switch (tcc->CTRLA.bit.PRESCSYNC) {
-        case 0x0: opts.out.print("GCLK"); break;
-        case 0x1: opts.out.print("PRESC"); break;
-        case 0x2: opts.out.print("RESYNC"); break;
-        default:  opts.out.print(ZeroRegs__UNKNOWN); break;
-    }
-    PRINTFLAG(tcc->CTRLA, ALOCK);
-    PRINTFLAG(tcc->CTRLA, CPTEN0);
-    PRINTFLAG(tcc->CTRLA, CPTEN1);
-    PRINTFLAG(tcc->CTRLA, CPTEN2);
-    PRINTFLAG(tcc->CTRLA, CPTEN3);
+    PRINTNAME(ZeroRegsTC_PRESCSYNCs, snap.CTRLA.bit.PRESCSYNC, ZeroRegs__UNKNOWN);
+    PRINTFLAG(snap.CTRLA, ALOCK);
+    PRINTFLAG(snap.CTRLA, CPTEN0);
+    PRINTFLAG(snap.CTRLA, CPTEN1);
+    PRINTFLAG(snap.CTRLA, CPTEN2);
+    PRINTFLAG(snap.CTRLA, CPTEN3);
     PRINTNL();
 
-    while (tcc->SYNCBUSY.bit.CTRLB) {}
     opts.out.print("CTRLB:  dir=");
-    opts.out.print(tcc->CTRLBSET.bit.DIR ? "DOWN" : "UP");
-    PRINTFLAG(tcc->CTRLBSET, LUPD);
-    PRINTFLAG(tcc->CTRLBSET, ONESHOT);
+    opts.out.print(snap.CTRLBSET.bit.DIR ? "DOWN" : "UP");
+    PRINTFLAG(snap.CTRLBSET, LUPD);
+    PRINTFLAG(snap.CTRLBSET, ONESHOT);
     PRINTNL();
 
     for (uint8_t i = 0; i < 2; i++) {
         TCC_FCTRLA_Type fctrl;
-        fctrl.reg = (i == 0) ? tcc->FCTRLA.reg : tcc->FCTRLB.reg;
+        fctrl.reg = (i == 0) ? snap.FCTRLA.reg : snap.FCTRLB.reg;
         opts.out.print("FCTRL");
         opts.out.print(char('A' + i));
         opts.out.print(": ");
@@ -2516,85 +4365,83 @@ void printZeroRegTCC(ZeroRegOptions &opts, Tcc* tcc, uint8_t idx) {
     }
 
     opts.out.print("WEXCTRL:  OTMX=");
-    PRINTHEX(tcc->WEXCTRL.bit.OTMX);
-    PRINTFLAG(tcc->WEXCTRL, DTIEN0);
-    PRINTFLAG(tcc->WEXCTRL, DTIEN1);
-    PRINTFLAG(tcc->WEXCTRL, DTIEN2);
-    PRINTFLAG(tcc->WEXCTRL, DTIEN3);
+    PRINTHEX(snap.WEXCTRL.bit.OTMX);
+    PRINTFLAG(snap.WEXCTRL, DTIEN0);
+    PRINTFLAG(snap.WEXCTRL, DTIEN1);
+    PRINTFLAG(snap.WEXCTRL, DTIEN2);
+    PRINTFLAG(snap.WEXCTRL, DTIEN3);
     opts.out.print(" DTLS=");
-    opts.out.print(tcc->WEXCTRL.bit.DTLS);
+    opts.out.print(snap.WEXCTRL.bit.DTLS);
     opts.out.print(" DTHS=");
-    opts.out.print(tcc->WEXCTRL.bit.DTHS);
+    opts.out.print(snap.WEXCTRL.bit.DTHS);
     PRINTNL();
 
     opts.out.print("DRVCTRL: ");
     for (uint8_t id = 0; id < 8; id++) {
-        if (tcc->DRVCTRL.vec.NRE & (1<<id)) {
+        if (snap.DRVCTRL.vec.NRE & (1<<id)) {
             opts.out.print(" NRE");
             opts.out.print(id);
         }
     }
     for (uint8_t id = 0; id < 8; id++) {
-        if (tcc->DRVCTRL.vec.NRV & (1<<id)) {
+        if (snap.DRVCTRL.vec.NRV & (1<<id)) {
             opts.out.print(" NRV");
             opts.out.print(id);
         }
     }
     for (uint8_t id = 0; id < 8; id++) {
-        if (tcc->DRVCTRL.vec.INVEN & (1<<id)) {
+        if (snap.DRVCTRL.vec.INVEN & (1<<id)) {
             opts.out.print(" INVEN");
             opts.out.print(id);
         }
     }
     opts.out.print(" FILTERVAL0=");
-    PRINTHEX(tcc->DRVCTRL.bit.FILTERVAL0);
+    PRINTHEX(snap.DRVCTRL.bit.FILTERVAL0);
     opts.out.print(" FILTERVAL1=");
-    PRINTHEX(tcc->DRVCTRL.bit.FILTERVAL1);
+    PRINTHEX(snap.DRVCTRL.bit.FILTERVAL1);
     PRINTNL();
 
     opts.out.print("EVCTRL:  EVACT0=");
-    PRINTHEX(tcc->EVCTRL.bit.EVACT0);
+    PRINTHEX(snap.EVCTRL.bit.EVACT0);
     opts.out.print(" EVACT1=");
-    PRINTHEX(tcc->EVCTRL.bit.EVACT1);
+    PRINTHEX(snap.EVCTRL.bit.EVACT1);
     opts.out.print(" CNTSEL=");
-    PRINTHEX(tcc->EVCTRL.bit.CNTSEL);
-    PRINTFLAG(tcc->EVCTRL, OVFEO);
-    PRINTFLAG(tcc->EVCTRL, TRGEO);
-    PRINTFLAG(tcc->EVCTRL, CNTEO);
-    PRINTFLAG(tcc->EVCTRL, TCINV0);
-    PRINTFLAG(tcc->EVCTRL, TCINV1);
-    PRINTFLAG(tcc->EVCTRL, TCEI0);
-    PRINTFLAG(tcc->EVCTRL, TCEI1);
-    PRINTFLAG(tcc->EVCTRL, MCEI0);
-    PRINTFLAG(tcc->EVCTRL, MCEI1);
-    PRINTFLAG(tcc->EVCTRL, MCEI2);
-    PRINTFLAG(tcc->EVCTRL, MCEI3);
-    PRINTFLAG(tcc->EVCTRL, MCEO0);
-    PRINTFLAG(tcc->EVCTRL, MCEO1);
-    PRINTFLAG(tcc->EVCTRL, MCEO2);
-    PRINTFLAG(tcc->EVCTRL, MCEO3);
+    PRINTHEX(snap.EVCTRL.bit.CNTSEL);
+    PRINTFLAG(snap.EVCTRL, OVFEO);
+    PRINTFLAG(snap.EVCTRL, TRGEO);
+    PRINTFLAG(snap.EVCTRL, CNTEO);
+    PRINTFLAG(snap.EVCTRL, TCINV0);
+    PRINTFLAG(snap.EVCTRL, TCINV1);
+    PRINTFLAG(snap.EVCTRL, TCEI0);
+    PRINTFLAG(snap.EVCTRL, TCEI1);
+    PRINTFLAG(snap.EVCTRL, MCEI0);
+    PRINTFLAG(snap.EVCTRL, MCEI1);
+    PRINTFLAG(snap.EVCTRL, MCEI2);
+    PRINTFLAG(snap.EVCTRL, MCEI3);
+    PRINTFLAG(snap.EVCTRL, MCEO0);
+    PRINTFLAG(snap.EVCTRL, MCEO1);
+    PRINTFLAG(snap.EVCTRL, MCEO2);
+    PRINTFLAG(snap.EVCTRL, MCEO3);
     PRINTNL();
 
-    while (tcc->SYNCBUSY.bit.PATT) {}
     opts.out.print("PATT:  ");
     for (uint8_t id = 0; id < 8; id++) {
-        if (tcc->PATT.vec.PGE & (1<<id)) {
-            opts.out.print((tcc->PATT.vec.PGV & (1<<id)) ? "1" : "0");
+        if (snap.PATT.vec.PGE & (1<<id)) {
+            opts.out.print((snap.PATT.vec.PGV & (1<<id)) ? "1" : "0");
         } else {
             opts.out.print(".");
         }
     }
     PRINTNL();
 
-    while (tcc->SYNCBUSY.bit.WAVE) {}
     opts.out.print("WAVE: ");
     opts.out.print(" WAVEGEN=");
-    PRINTHEX(tcc->WAVE.bit.WAVEGEN);
+    PRINTHEX(snap.WAVE.bit.WAVEGEN);
     opts.out.print(" RAMP=");
-    PRINTHEX(tcc->WAVE.bit.RAMP);
-    PRINTFLAG(tcc->WAVE, CIPEREN);
+    PRINTHEX(snap.WAVE.bit.RAMP);
+    PRINTFLAG(snap.WAVE, CIPEREN);
     for (uint8_t id = 0; id < 4; id++) {
-        if (tcc->WAVE.vec.CICCEN & (1<<id)) {
+        if (snap.WAVE.vec.CICCEN & (1<<id)) {
             opts.out.print(" CICCEN");
             opts.out.print(id);
         }
@@ -2603,72 +4450,111 @@ void printZeroRegTCC(ZeroRegOptions &opts, Tcc* tcc, uint8_t idx) {
         opts.out.print(" POL");
         opts.out.print(id);
         opts.out.print("=");
-        opts.out.print(tcc->WAVE.vec.POL & (1<<id));
+        opts.out.print(snap.WAVE.vec.POL & (1<<id));
     }
     for (uint8_t id = 0; id < 4; id++) {
-        if (tcc->WAVE.vec.SWAP & (1<<id)) {
+        if (snap.WAVE.vec.SWAP & (1<<id)) {
             opts.out.print(" SWAP");
             opts.out.print(id);
         }
     }
     PRINTNL();
 
-    while (tcc->SYNCBUSY.bit.PER) {}
+    // [31.6.2.5 DSrevF] with dithering, the low bits of PER and CC are how
+    // many of every 16, 32, or 64 cycles get one more count
+    uint8_t dithBits = dith ? dith + 3 : 0;
+    uint32_t dithMask = (1 << dithBits) - 1;
+    uint32_t per = snap.PER.reg >> dithBits;
+    // [31.6.2.5.1 DSrevF] MFRQ uses CC0 as TOP, the others use PER
+    uint8_t wavegen = snap.WAVE.bit.WAVEGEN;
+    bool dual = wavegen >= 0x4;
+    uint32_t top = per;
+    uint32_t topDith = snap.PER.reg & dithMask;
+    if (wavegen == 0x1) {
+        top = snap.CC[0].reg >> dithBits;
+        topDith = snap.CC[0].reg & dithMask;
+    }
+    // single-slope counts 0 to TOP, dual-slope counts 0 to TOP and back, and
+    // frequency generation toggles the output once per period
+    uint64_t period = (((uint64_t)top + (dual ? 0 : 1)) << dithBits) + topDith;
     opts.out.print("PER:  ");
     switch (dith) {
         case 0x0:
-            opts.out.print(tcc->PER.bit.PER);
+            opts.out.print(snap.PER.bit.PER);
             break;
         case 0x1:
-            opts.out.print(tcc->PER.DITH4.PER);
+            opts.out.print(snap.PER.DITH4.PER);
             opts.out.print(" DITHERCY=");
-            opts.out.print(tcc->PER.DITH4.DITHERCY);
+            opts.out.print(snap.PER.DITH4.DITHERCY);
             break;
         case 0x2:
-            opts.out.print(tcc->PER.DITH5.PER);
+            opts.out.print(snap.PER.DITH5.PER);
             opts.out.print(" DITHERCY=");
-            opts.out.print(tcc->PER.DITH5.DITHERCY);
+            opts.out.print(snap.PER.DITH5.DITHERCY);
             break;
         case 0x3:
-            opts.out.print(tcc->PER.DITH6.PER);
+            opts.out.print(snap.PER.DITH6.PER);
             opts.out.print(" DITHERCY=");
-            opts.out.print(tcc->PER.DITH6.DITHERCY);
+            opts.out.print(snap.PER.DITH6.DITHERCY);
             break;
     }
     PRINTNL();
 
+    if (coreHz) {
+        ZeroRegs__printCounter(opts, coreHz, snap.CTRLA.bit.PRESCALER, top, (dual || wavegen < 0x2) ? 2 * period : period, dithBits);
+    }
+
     for (uint8_t id = 0; id < 4; id++) {
-        while (tcc->SYNCBUSY.vec.CC & (1<<id)) {}
         opts.out.print("CC");
         opts.out.print(id);
         opts.out.print(":  ");
         switch (dith) {
             case 0x0:
-                opts.out.print(tcc->CC[id].bit.CC);
+                opts.out.print(snap.CC[id].bit.CC);
                 break;
             case 0x1:
-                opts.out.print(tcc->CC[id].DITH4.CC);
+                opts.out.print(snap.CC[id].DITH4.CC);
                 opts.out.print(" DITHERCY=");
-                opts.out.print(tcc->CC[id].DITH4.DITHERCY);
+                opts.out.print(snap.CC[id].DITH4.DITHERCY);
                 break;
             case 0x2:
-                opts.out.print(tcc->CC[id].DITH5.CC);
+                opts.out.print(snap.CC[id].DITH5.CC);
                 opts.out.print(" DITHERCY=");
-                opts.out.print(tcc->CC[id].DITH5.DITHERCY);
+                opts.out.print(snap.CC[id].DITH5.DITHERCY);
                 break;
             case 0x3:
-                opts.out.print(tcc->CC[id].DITH6.CC);
+                opts.out.print(snap.CC[id].DITH6.CC);
                 opts.out.print(" DITHERCY=");
-                opts.out.print(tcc->CC[id].DITH6.DITHERCY);
+                opts.out.print(snap.CC[id].DITH6.DITHERCY);
                 break;
         }
+        // in MFRQ, CC0 is TOP instead of a duty cycle
+        if (coreHz && (wavegen == 0x2 || dual)) {
+            ZeroRegs__printDuty(opts, snap.CC[id].bit.CC, period, snap.WAVE.vec.POL & (1<<id));
+        }
         PRINTNL();
     }
 }
 
+// the GCLK channel for TCC0 to TCC3
+static const uint8_t ZeroRegsTCC_GCLKIDs[] = {
+    0x1A, 0x1A, 0x1B, 0x25,
+};
+void printZeroRegTCC(ZeroRegOptions &opts, Tcc* tcc, uint8_t idx) {
+    ZeroRegSnapshot_SYSCTRL sysctrl;
+    ZeroRegSnapshot_GCLK gclk;
+    ZeroRegClocks clocks;
+    ZeroRegSnapshot_TCC snap;
+    captureZeroRegSYSCTRL(sysctrl);
+    captureZeroRegGCLK(gclk);
+    computeZeroRegClocks(clocks, sysctrl, gclk, opts.xoscHz);
+    captureZeroRegTCC(snap, tcc);
+    printZeroRegTCC(opts, snap, idx, clocks.CLKCTRL[ZeroRegsTCC_GCLKIDs[idx]]);
+}
+
 
 #ifdef USB
-void printZeroRegUSB_PADCAL(ZeroRegOptions &opts, volatile USB_PADCAL_Type &pad) {
+void printZeroRegUSB_PADCAL(ZeroRegOptions &opts, USB_PADCAL_Type pad) {
     opts.out.print("PADCAL:  TRANSP=");
     PRINTHEX(pad.bit.TRANSP);
     opts.out.print(" TRANSN=");
@@ -2678,49 +4564,65 @@ void printZeroRegUSB_PADCAL(ZeroRegOptions &opts, volatile USB_PADCAL_Type &pad)
     PRINTNL();
 }
 
-void printZeroRegUSB_DESCADD(ZeroRegOptions &opts, uint8_t n, uint8_t b, bool isHost) {
+void captureZeroRegUSB_DESCADD(ZeroRegSnapshot_USB_DescBank (&banks)[8][2]) {
     uint32_t addr = USB->HOST.DESCADD.bit.DESCADD;
-    // UsbHostDescBank has all the fields we care about
-    UsbHostDescBank* desc = (UsbHostDescBank*)(addr + (n * sizeof(UsbHostDescriptor)) + (b * sizeof(UsbHostDescBank)));
+    for (uint8_t n = 0; n < 8; n++) {
+        for (uint8_t b = 0; b < 2; b++) {
+            if (!addr) {
+                // sketch hasn't set up the descriptors yet
+                memset(&banks[n][b], 0, sizeof(banks[n][b]));
+                continue;
+            }
+            // UsbHostDescBank has all the fields we care about
+            UsbHostDescBank* desc = (UsbHostDescBank*)(addr + (n * sizeof(UsbHostDescriptor)) + (b * sizeof(UsbHostDescBank)));
+            banks[n][b].ADDR.reg = desc->ADDR.reg;
+            banks[n][b].PCKSIZE.reg = desc->PCKSIZE.reg;
+            banks[n][b].EXTREG.reg = desc->EXTREG.reg;
+            banks[n][b].CTRL_PIPE.reg = desc->CTRL_PIPE.reg;
+        }
+    }
+}
+
+static const char* const ZeroRegsUSB_PCKSIZE_SIZEs[] = {
+    "8byte", "16byte", "32byte", "64byte", "128byte", "256byte", "512byte", "1023byte",
+};
+void printZeroRegUSB_DESCADD(ZeroRegOptions &opts, const ZeroRegSnapshot_USB_DescBank &desc, uint8_t b, bool isHost) {
     opts.out.print(" ADDR=");
-    PRINTHEX(desc->ADDR.bit.ADDR);
+    PRINTHEX(desc.ADDR.bit.ADDR);
     opts.out.print(" size=");
-    switch (desc->PCKSIZE.bit.SIZE) {
-        case 0x0: opts.out.print("8byte"); break;
-        case 0x1: opts.out.print("16byte"); break;
-        case 0x2: opts.out.print("32byte"); break;
-        case 0x3: opts.out.print("64byte"); break;
-        case 0x4: opts.out.print("128byte"); break;
-        case 0x5: opts.out.print("256byte"); break;
-        case 0x6: opts.out.print("512byte"); break;
-        case 0x7: opts.out.print("1023byte"); break;
-    }
-    PRINTFLAG(desc->PCKSIZE, AUTO_ZLP);
+    PRINTNAME(ZeroRegsUSB_PCKSIZE_SIZEs, desc.PCKSIZE.bit.SIZE, ZeroRegs__empty);
+    PRINTFLAG(desc.PCKSIZE, AUTO_ZLP);
     if (b == 0) {
         //FUTURE -- parse out SUBPID:4 and VARIABLE:11
         opts.out.print(" EXTREG=");
-        PRINTHEX(desc->EXTREG.reg);
+        PRINTHEX(desc.EXTREG.reg);
     }
     if (isHost) {
         opts.out.print(" PDADDR=");
-        PRINTHEX(desc->CTRL_PIPE.bit.PDADDR);
+        PRINTHEX(desc.CTRL_PIPE.bit.PDADDR);
         opts.out.print(" PEPNUM=");
-        opts.out.print(desc->CTRL_PIPE.bit.PEPNUM);
+        opts.out.print(desc.CTRL_PIPE.bit.PEPNUM);
         opts.out.print(" PERMAX=");
-        opts.out.print(desc->CTRL_PIPE.bit.PERMAX);
+        opts.out.print(desc.CTRL_PIPE.bit.PERMAX);
     }
 }
 
-void printZeroRegUSB_DEVICE(ZeroRegOptions &opts, UsbDevice &dev) {
+static const char* const ZeroRegsUSB_DEVICE_SPDCONFs[] = {
+    "FS", "LS",
+};
+// 0 is disabled
+static const char* const ZeroRegsUSB_DEVICE_EPTYPE0s[] = {
+    ZeroRegs__DISABLED, "CTRL-out", "ISO-out", "BULK-out", "INT-out", "DUAL-in",
+};
+static const char* const ZeroRegsUSB_DEVICE_EPTYPE1s[] = {
+    ZeroRegs__DISABLED, "CTRL-in", "ISO-in", "BULK-in", "INT-in", "DUAL-out",
+};
+void printZeroRegUSB_DEVICE(ZeroRegOptions &opts, const ZeroRegSnapshot_USB_DEVICE &dev) {
     opts.out.print("CTRLB: ");
     PRINTFLAG(dev.CTRLB, DETACH);
     PRINTFLAG(dev.CTRLB, UPRSM);
     opts.out.print(" spdconf=");
-    switch (dev.CTRLB.bit.SPDCONF) {
-        case 0x0: opts.out.print("FS"); break;
-        case 0x1: opts.out.print("LS"); break;
-        default: opts.out.print(ZeroRegs__RESERVED); break;
-    }
+    PRINTNAME(ZeroRegsUSB_DEVICE_SPDCONFs, dev.CTRLB.bit.SPDCONF, ZeroRegs__RESERVED);
     PRINTFLAG(dev.CTRLB, NREPLY);
     // for testing purposes:
     //  TSTJ:1
@@ -2743,52 +4645,34 @@ void printZeroRegUSB_DEVICE(ZeroRegOptions &opts, UsbDevice &dev) {
         opts.out.print("ENDPOINT");
         opts.out.print(n);
         opts.out.print(": ");
-        PRINTFLAG(dev.DeviceEndpoint[n].EPCFG, NYETDIS);
+        PRINTFLAG(dev.EPCFG[n], NYETDIS);
         PRINTNL();
 
         uint8_t b = 0;
-        bool disabled = false;
+        bool disabled = !dev.EPCFG[n].bit.EPTYPE0;
         opts.out.print("    BANK0:  eptype=");
-        switch (dev.DeviceEndpoint[n].EPCFG.bit.EPTYPE0) {
-            case 0x0:
-                opts.out.print(ZeroRegs__DISABLED);
-                disabled = true;
-                break;
-            case 0x1: opts.out.print("CTRL-out"); break;
-            case 0x2: opts.out.print("ISO-out"); break;
-            case 0x3: opts.out.print("BULK-out"); break;
-            case 0x4: opts.out.print("INT-out"); break;
-            case 0x5: opts.out.print("DUAL-in"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        PRINTNAME(ZeroRegsUSB_DEVICE_EPTYPE0s, dev.EPCFG[n].bit.EPTYPE0, ZeroRegs__RESERVED);
         if (!disabled || opts.showDisabled) {
-            printZeroRegUSB_DESCADD(opts, n, b, false);
+            printZeroRegUSB_DESCADD(opts, dev.DescBank[n][b], b, false);
         }
         PRINTNL();
 
         b = 1;
-        disabled = false;
+        disabled = !dev.EPCFG[n].bit.EPTYPE1;
         opts.out.print("    BANK1:  eptype=");
-        switch (dev.DeviceEndpoint[n].EPCFG.bit.EPTYPE1) {
-            case 0x0:
-                opts.out.print(ZeroRegs__DISABLED);
-                disabled = true;
-                break;
-            case 0x1: opts.out.print("CTRL-in"); break;
-            case 0x2: opts.out.print("ISO-in"); break;
-            case 0x3: opts.out.print("BULK-in"); break;
-            case 0x4: opts.out.print("INT-in"); break;
-            case 0x5: opts.out.print("DUAL-out"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        PRINTNAME(ZeroRegsUSB_DEVICE_EPTYPE1s, dev.EPCFG[n].bit.EPTYPE1, ZeroRegs__RESERVED);
         if (!disabled || opts.showDisabled) {
-            printZeroRegUSB_DESCADD(opts, n, b, false);
+            printZeroRegUSB_DESCADD(opts, dev.DescBank[n][b], b, false);
         }
         PRINTNL();
     }
 }
 
-void printZeroRegUSB_HOST(ZeroRegOptions &opts, UsbHost &host) {
+// 0 is disabled
+static const char* const ZeroRegsUSB_HOST_PTYPEs[] = {
+    ZeroRegs__DISABLED, "CTRL", "ISO", "BULK", "INT", "EXT",
+};
+void printZeroRegUSB_HOST(ZeroRegOptions &opts, const ZeroRegSnapshot_USB_HOST &host) {
 
     opts.out.print("CTRLB:  SPDCONF=");
     PRINTHEX(host.CTRLB.bit.SPDCONF);
@@ -2810,162 +4694,1450 @@ void printZeroRegUSB_HOST(ZeroRegOptions &opts, UsbHost &host) {
         opts.out.print("PIPE");
         opts.out.print(n);
         opts.out.print(":  ptype=");
-        bool disabled = false;
-        switch (host.HostPipe[n].PCFG.bit.PTYPE) {
-            case 0x0:
-                opts.out.print(ZeroRegs__DISABLED);
-                disabled = true;
-                break;
-            case 0x1: opts.out.print("CTRL"); break;
-            case 0x2: opts.out.print("ISO"); break;
-            case 0x3: opts.out.print("BULK"); break;
-            case 0x4: opts.out.print("INT"); break;
-            case 0x5: opts.out.print("EXT"); break;
-            default: opts.out.print(ZeroRegs__RESERVED); break;
-        }
+        bool disabled = !host.PCFG[n].bit.PTYPE;
+        PRINTNAME(ZeroRegsUSB_HOST_PTYPEs, host.PCFG[n].bit.PTYPE, ZeroRegs__RESERVED);
         if (disabled && !opts.showDisabled) {
             continue;
         }
         opts.out.print(" bk=");
-        opts.out.print(host.HostPipe[n].PCFG.bit.BK ? "DUAL" : "SINGLE");
+        opts.out.print(host.PCFG[n].bit.BK ? "DUAL" : "SINGLE");
         opts.out.print(" BINTERVAL=");
-        opts.out.print(host.HostPipe[n].BINTERVAL.bit.BITINTERVAL);
+        opts.out.print(host.BINTERVAL[n].bit.BITINTERVAL);
         PRINTNL();
 
         opts.out.print("    BANK0: ");
-        printZeroRegUSB_DESCADD(opts, n, 0, true);
+        printZeroRegUSB_DESCADD(opts, host.DescBank[n][0], 0, true);
         PRINTNL();
 
         opts.out.print("    BANK1: ");
-        printZeroRegUSB_DESCADD(opts, n, 1, true);
+        printZeroRegUSB_DESCADD(opts, host.DescBank[n][1], 1, true);
         PRINTNL();
     }
 }
 #endif
 
-void printZeroRegUSB(ZeroRegOptions &opts) {
+void captureZeroRegUSB(ZeroRegSnapshot_USB &usb) {
 #ifdef USB
     while (USB->DEVICE.SYNCBUSY.bit.SWRST || USB->DEVICE.SYNCBUSY.bit.ENABLE) {}
-    if (!USB->DEVICE.CTRLA.bit.ENABLE && !opts.showDisabled) {
+    // CTRLA and QOSCTRL are at the same place in both modes
+    usb.DEVICE.CTRLA.reg = USB->DEVICE.CTRLA.reg;
+    usb.DEVICE.QOSCTRL.reg = USB->DEVICE.QOSCTRL.reg;
+    if (USB->DEVICE.CTRLA.bit.MODE) {
+        usb.HOST.CTRLB.reg = USB->HOST.CTRLB.reg;
+        usb.HOST.HSOFC.reg = USB->HOST.HSOFC.reg;
+        usb.HOST.PADCAL.reg = USB->HOST.PADCAL.reg;
+        for (uint8_t n = 0; n < 8; n++) {
+            usb.HOST.PCFG[n].reg = USB->HOST.HostPipe[n].PCFG.reg;
+            usb.HOST.BINTERVAL[n].reg = USB->HOST.HostPipe[n].BINTERVAL.reg;
+        }
+        captureZeroRegUSB_DESCADD(usb.HOST.DescBank);
+    } else {
+        usb.DEVICE.CTRLB.reg = USB->DEVICE.CTRLB.reg;
+        usb.DEVICE.DADD.reg = USB->DEVICE.DADD.reg;
+        usb.DEVICE.PADCAL.reg = USB->DEVICE.PADCAL.reg;
+        for (uint8_t n = 0; n < 8; n++) {
+            usb.DEVICE.EPCFG[n].reg = USB->DEVICE.DeviceEndpoint[n].EPCFG.reg;
+        }
+        captureZeroRegUSB_DESCADD(usb.DEVICE.DescBank);
+    }
+#else
+    memset(&usb, 0, sizeof(usb));
+#endif
+}
+
+void printZeroRegUSB(ZeroRegOptions &opts, const ZeroRegSnapshot_USB &usb) {
+#ifdef USB
+    if (!usb.DEVICE.CTRLA.bit.ENABLE && !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- USB");
 
     opts.out.print("CTRLA: ");
-    PRINTFLAG(USB->DEVICE.CTRLA, ENABLE);
-    PRINTFLAG(USB->DEVICE.CTRLA, RUNSTDBY);
+    PRINTFLAG(usb.DEVICE.CTRLA, ENABLE);
+    PRINTFLAG(usb.DEVICE.CTRLA, RUNSTDBY);
     opts.out.print(" mode=");
-    opts.out.print(USB->DEVICE.CTRLA.bit.MODE ? "HOST" : "DEVICE");
+    opts.out.print(usb.DEVICE.CTRLA.bit.MODE ? "HOST" : "DEVICE");
     PRINTNL();
 
     opts.out.print("QOSCTRL:  cqos=");
-    printZeroReg_QOS(opts, USB->DEVICE.QOSCTRL.bit.CQOS);
+    printZeroReg_QOS(opts, usb.DEVICE.QOSCTRL.bit.CQOS);
     opts.out.print(" dqos=");
-    printZeroReg_QOS(opts, USB->DEVICE.QOSCTRL.bit.DQOS);
+    printZeroReg_QOS(opts, usb.DEVICE.QOSCTRL.bit.DQOS);
     PRINTNL();
 
-    if (USB->DEVICE.CTRLA.bit.MODE) {
-        printZeroRegUSB_HOST(opts, USB->HOST);
+    if (usb.DEVICE.CTRLA.bit.MODE) {
+        printZeroRegUSB_HOST(opts, usb.HOST);
     } else {
-        printZeroRegUSB_DEVICE(opts, USB->DEVICE);
+        printZeroRegUSB_DEVICE(opts, usb.DEVICE);
     }
 #endif
 }
 
+void printZeroRegUSB(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_USB usb;
+    captureZeroRegUSB(usb);
+    printZeroRegUSB(opts, usb);
+}
 
-void printZeroRegWDT(ZeroRegOptions &opts) {
+
+void captureZeroRegWDT(ZeroRegSnapshot_WDT &wdt) {
     while (WDT->STATUS.bit.SYNCBUSY) {}
-    if (!WDT->CTRL.bit.ENABLE || !opts.showDisabled) {
+    wdt.CTRL.reg = WDT->CTRL.reg;
+    wdt.CONFIG.reg = WDT->CONFIG.reg;
+    wdt.EWCTRL.reg = WDT->EWCTRL.reg;
+    // [10.3.1 DSrevF] NVM User Row Mapping
+    wdt.USER[0] = READADDR32(NVMCTRL_USER);
+    wdt.USER[1] = READADDR32(NVMCTRL_USER + 4);
+}
+
+void printZeroRegWDT(ZeroRegOptions &opts, const ZeroRegSnapshot_WDT &wdt) {
+    if (!wdt.CTRL.bit.ENABLE || !opts.showDisabled) {
         return;
     }
     opts.out.println("--------------------------- WDT");
 
     opts.out.print("CTRL: ");
-    PRINTFLAG(WDT->CTRL, ENABLE);
-    PRINTFLAG(WDT->CTRL, WEN);
-    PRINTFLAG(WDT->CTRL, ALWAYSON);
+    PRINTFLAG(wdt.CTRL, ENABLE);
+    PRINTFLAG(wdt.CTRL, WEN);
+    PRINTFLAG(wdt.CTRL, ALWAYSON);
     PRINTNL();
 
     opts.out.print("CONFIG:  PER=");
-    PRINTHEX(WDT->CONFIG.bit.PER);
+    PRINTHEX(wdt.CONFIG.bit.PER);
     opts.out.print(" WINDOW=");
-    PRINTHEX(WDT->CONFIG.bit.WINDOW);
+    PRINTHEX(wdt.CONFIG.bit.WINDOW);
     PRINTNL();
 
     opts.out.print("EWCTRL:  EWOFFSET=");
-    PRINTHEX(WDT->EWCTRL.bit.EWOFFSET);
+    PRINTHEX(wdt.EWCTRL.bit.EWOFFSET);
     PRINTNL();
 
     opts.out.print("NVM user row: ");
     opts.out.print(" ENABLE=");
-    opts.out.print(READFUSE(WDT, ENABLE));
+    opts.out.print(READFUSE(wdt.USER, WDT, ENABLE));
     opts.out.print(" ALWAYSON=");
-    opts.out.print(READFUSE(WDT, ALWAYSON));
+    opts.out.print(READFUSE(wdt.USER, WDT, ALWAYSON));
     opts.out.print(" PER=");
-    PRINTHEX(READFUSE(WDT, PER));
+    PRINTHEX(READFUSE(wdt.USER, WDT, PER));
     opts.out.print(" WINDOW=");
-    PRINTHEX(READ2FUSES(WDT, WINDOW, 1));
+    PRINTHEX(READ2FUSES(wdt.USER, WDT, WINDOW, 1));
     opts.out.print(" EWOFFSET=");
-    PRINTHEX(READFUSE(WDT, EWOFFSET));
+    PRINTHEX(READFUSE(wdt.USER, WDT, EWOFFSET));
     opts.out.print(" WEN=");
-    opts.out.print(READFUSE(WDT, WEN));
+    opts.out.print(READFUSE(wdt.USER, WDT, WEN));
     PRINTNL();
 }
 
+void printZeroRegWDT(ZeroRegOptions &opts) {
+    ZeroRegSnapshot_WDT wdt;
+    captureZeroRegWDT(wdt);
+    printZeroRegWDT(opts, wdt);
+}
 
-void printZeroRegs(ZeroRegOptions &opts) {
-    // show system basics
-    printZeroRegSCS(opts);
-    printZeroRegSYSCTRL(opts);
-    printZeroRegGCLK(opts);
-
-    // show core peripherals
-    printZeroRegDMAC(opts);
-    printZeroRegEVSYS(opts);
-    printZeroRegPAC(opts);
-    printZeroRegPM(opts);
-    printZeroRegWDT(opts);
-
-    // show other peripherals
-    printZeroRegAC(opts);
-    printZeroRegADC(opts);
-    printZeroRegDAC(opts);
-    printZeroRegEIC(opts);
+
+// printZeroRegs() prints the peripherals in this many sections
+#define ZEROREGS_SECTIONS 35
+
+// Captures what section `n` (see ZeroRegs__section()) decodes.  Both PORT
+// sections decode the same registers, so the second doesn't capture anything.
+static void ZeroRegs__captureSection(ZeroRegSnapshot &snap, uint8_t n) {
+    switch (n) {
+        case 0: captureZeroRegSCS(snap.scs); break;
+        case 1: captureZeroRegSYSCTRL(snap.sysctrl); break;
+        case 2: captureZeroRegGCLK(snap.gclk); break;
+        case 3: captureZeroRegDMAC(snap.dmac); break;
+        case 4: captureZeroRegEVSYS(snap.evsys); break;
+        case 5: captureZeroRegPAC(snap.pac); break;
+        case 6: captureZeroRegPM(snap.pm); break;
+        case 7: captureZeroRegWDT(snap.wdt); break;
+        case 8: captureZeroRegAC(snap.ac); break;
+        case 9: captureZeroRegADC(snap.adc); break;
+        case 10: captureZeroRegDAC(snap.dac); break;
+        case 11: captureZeroRegEIC(snap.eic); break;
+        case 12: captureZeroRegI2S(snap.i2s); break;
+        case 13: captureZeroRegNVMCTRL(snap.nvmctrl); break;
+        case 14: captureZeroRegPORT(snap.port); break;
+        case 16: captureZeroRegRTC(snap.rtc); break;
+        case 17: captureZeroRegSERCOM(snap.sercom[0], SERCOM0); break;
+        case 18: captureZeroRegSERCOM(snap.sercom[1], SERCOM1); break;
+        case 19: captureZeroRegSERCOM(snap.sercom[2], SERCOM2); break;
+        case 20: captureZeroRegSERCOM(snap.sercom[3], SERCOM3); break;
+#ifdef SERCOM4
+        case 21: captureZeroRegSERCOM(snap.sercom[4], SERCOM4); break;
+#endif
+#ifdef SERCOM5
+        case 22: captureZeroRegSERCOM(snap.sercom[5], SERCOM5); break;
+#endif
+        case 23: captureZeroRegTCC(snap.tcc[0], TCC0); break;
+        case 24: captureZeroRegTCC(snap.tcc[1], TCC1); break;
+        case 25: captureZeroRegTCC(snap.tcc[2], TCC2); break;
+#ifdef TCC3
+        case 26: captureZeroRegTCC(snap.tcc[3], TCC3); break;
+#endif
+        case 27: captureZeroRegTC(snap.tc[3 - 3], TC3); break;
+        case 28: captureZeroRegTC(snap.tc[4 - 3], TC4); break;
+        case 29: captureZeroRegTC(snap.tc[5 - 3], TC5); break;
+#ifdef TC6
+        case 30: captureZeroRegTC(snap.tc[6 - 3], TC6); break;
+#endif
+#ifdef TC7
+        case 31: captureZeroRegTC(snap.tc[7 - 3], TC7); break;
+#endif
+        case 32: captureZeroRegUSB(snap.usb); break;
+    }
+}
+
+void captureZeroRegs(ZeroRegSnapshot &snap) {
+    memset(snap.sercom, 0, sizeof(snap.sercom));
+    memset(snap.tcc, 0, sizeof(snap.tcc));
+    memset(snap.tc, 0, sizeof(snap.tc));
+    memset(&snap.rtc, 0, sizeof(snap.rtc));
+    memset(&snap.usb, 0, sizeof(snap.usb));
+    for (uint8_t n = 0; n < ZEROREGS_SECTIONS; n++) {
+        ZeroRegs__captureSection(snap, n);
+    }
+}
+
+
+// Prints section `n` of the snapshot (unless `opts` is NULL), counting in the
+// order printZeroRegs() prints them, and returns which part of the snapshot
+// that section decodes.  Sections which this chip doesn't have print nothing
+// and return a size of 0.
+// The SYSCTRL and GCLK sections both print frequencies which depend on the
+// registers of the other, so they each cover both.  The CLOCKS section also
+// needs PM and NVMCTRL, so covers everything from SYSCTRL through NVMCTRL.
+static void ZeroRegs__printClocks(ZeroRegOptions &opts, const ZeroRegSnapshot &snap, uint8_t n) {
+    ZeroRegClocks clocks;
+    computeZeroRegClocks(clocks, snap.sysctrl, snap.gclk, opts.xoscHz);
+    switch (n) {
+        case 1: printZeroRegSYSCTRL(opts, snap.sysctrl, &clocks); break;
+        case 2: printZeroRegGCLK(opts, snap.gclk, &clocks); break;
+        case 33:
+            printZeroRegClocks(opts, snap.pm, snap.gclk, clocks);
+            printZeroRegWaitStates(opts, snap.nvmctrl, snap.sysctrl, clocks.GEN[0] >> snap.pm.CPUSEL.bit.CPUDIV);
+            break;
+    }
+}
+
+// SERCOM sections show rates worked out from their GCLK channel.  They only
+// cover their own registers, so a change in the clock alone shows up in the
+// diff as a change to the CLOCKS section.
+static void ZeroRegs__printSERCOM(ZeroRegOptions &opts, const ZeroRegSnapshot &snap, uint8_t idx) {
+    ZeroRegClocks clocks;
+    computeZeroRegClocks(clocks, snap.sysctrl, snap.gclk, opts.xoscHz);
+    printZeroRegSERCOM(opts, snap.sercom[idx], idx, clocks.CLKCTRL[GCLK_CLKCTRL_ID_SERCOM0_CORE_Val + idx]);
+}
+
+// ADC, TC, and TCC sections likewise show rates worked out from their GCLK
+// channel.
+static void ZeroRegs__printADC(ZeroRegOptions &opts, const ZeroRegSnapshot &snap) {
+    ZeroRegClocks clocks;
+    computeZeroRegClocks(clocks, snap.sysctrl, snap.gclk, opts.xoscHz);
+    printZeroRegADC(opts, snap.adc, clocks.CLKCTRL[GCLK_CLKCTRL_ID_ADC_Val]);
+}
+static void ZeroRegs__printTCC(ZeroRegOptions &opts, const ZeroRegSnapshot &snap, uint8_t idx) {
+    ZeroRegClocks clocks;
+    computeZeroRegClocks(clocks, snap.sysctrl, snap.gclk, opts.xoscHz);
+    printZeroRegTCC(opts, snap.tcc[idx], idx, clocks.CLKCTRL[ZeroRegsTCC_GCLKIDs[idx]]);
+}
+static void ZeroRegs__printTC(ZeroRegOptions &opts, const ZeroRegSnapshot &snap, uint8_t idx) {
+    ZeroRegClocks clocks;
+    computeZeroRegClocks(clocks, snap.sysctrl, snap.gclk, opts.xoscHz);
+    printZeroRegTC(opts, snap.tc[idx - 3], idx, clocks.CLKCTRL[ZeroRegsTC_GCLKIDs[idx - 3]]);
+}
+
+#define SECTION(print,x) do { if (opts) { print; } offset = (const uint8_t*)&(x) - (const uint8_t*)&snap; return sizeof(x); } while(0)
+static size_t ZeroRegs__section(ZeroRegOptions *opts, const ZeroRegSnapshot &snap, uint8_t n, size_t &offset) {
+    switch (n) {
+        // show system basics
+        case 0: SECTION(printZeroRegSCS(*opts, snap.scs), snap.scs);
+        case 1:
+        case 2:
+            if (opts) {
+                ZeroRegs__printClocks(*opts, snap, n);
+            }
+            offset = (const uint8_t*)&snap.sysctrl - (const uint8_t*)&snap;
+            return sizeof(snap.sysctrl) + sizeof(snap.gclk);
+
+        // show core peripherals
+        case 3: SECTION(printZeroRegDMAC(*opts, snap.dmac), snap.dmac);
+        case 4: SECTION(printZeroRegEVSYS(*opts, snap.evsys), snap.evsys);
+        case 5: SECTION(printZeroRegPAC(*opts, snap.pac), snap.pac);
+        case 6: SECTION(printZeroRegPM(*opts, snap.pm), snap.pm);
+        case 7: SECTION(printZeroRegWDT(*opts, snap.wdt), snap.wdt);
+
+        // show other peripherals
+        case 8: SECTION(printZeroRegAC(*opts, snap.ac), snap.ac);
+        case 9: SECTION(ZeroRegs__printADC(*opts, snap), snap.adc);
+        case 10: SECTION(printZeroRegDAC(*opts, snap.dac), snap.dac);
+        case 11: SECTION(printZeroRegEIC(*opts, snap.eic), snap.eic);
 #ifdef I2S
-    printZeroRegI2S(opts);
+        case 12: SECTION(printZeroRegI2S(*opts, snap.i2s), snap.i2s);
 #endif
-    printZeroRegNVMCTRL(opts);
-    printZeroRegPORT(opts);
-    printZeroRegPORT_Arduino(opts);
-    printZeroRegRTC(opts);
-    printZeroRegSERCOM(opts, SERCOM0, 0);
-    printZeroRegSERCOM(opts, SERCOM1, 1);
-    printZeroRegSERCOM(opts, SERCOM2, 2);
-    printZeroRegSERCOM(opts, SERCOM3, 3);
+        case 13: SECTION(printZeroRegNVMCTRL(*opts, snap.nvmctrl), snap.nvmctrl);
+        case 14: SECTION(printZeroRegPORT(*opts, snap.port), snap.port);
+        case 15: SECTION(printZeroRegPORT_Arduino(*opts, snap.port), snap.port);
+        case 16: SECTION(printZeroRegRTC(*opts, snap.rtc), snap.rtc);
+        case 17: SECTION(ZeroRegs__printSERCOM(*opts, snap, 0), snap.sercom[0]);
+        case 18: SECTION(ZeroRegs__printSERCOM(*opts, snap, 1), snap.sercom[1]);
+        case 19: SECTION(ZeroRegs__printSERCOM(*opts, snap, 2), snap.sercom[2]);
+        case 20: SECTION(ZeroRegs__printSERCOM(*opts, snap, 3), snap.sercom[3]);
 #ifdef SERCOM4
-    printZeroRegSERCOM(opts, SERCOM4, 4);
+        case 21: SECTION(ZeroRegs__printSERCOM(*opts, snap, 4), snap.sercom[4]);
 #endif
 #ifdef SERCOM5
-    printZeroRegSERCOM(opts, SERCOM5, 5);
+        case 22: SECTION(ZeroRegs__printSERCOM(*opts, snap, 5), snap.sercom[5]);
 #endif
-    printZeroRegTCC(opts, TCC0, 0);
-    printZeroRegTCC(opts, TCC1, 1);
-    printZeroRegTCC(opts, TCC2, 2);
+        case 23: SECTION(ZeroRegs__printTCC(*opts, snap, 0), snap.tcc[0]);
+        case 24: SECTION(ZeroRegs__printTCC(*opts, snap, 1), snap.tcc[1]);
+        case 25: SECTION(ZeroRegs__printTCC(*opts, snap, 2), snap.tcc[2]);
 #ifdef TCC3
-    printZeroRegTCC(opts, TCC3, 3);
+        case 26: SECTION(ZeroRegs__printTCC(*opts, snap, 3), snap.tcc[3]);
 #endif
-    printZeroRegTC(opts, TC3, 3);
-    printZeroRegTC(opts, TC4, 4);
-    printZeroRegTC(opts, TC5, 5);
+        case 27: SECTION(ZeroRegs__printTC(*opts, snap, 3), snap.tc[3 - 3]);
+        case 28: SECTION(ZeroRegs__printTC(*opts, snap, 4), snap.tc[4 - 3]);
+        case 29: SECTION(ZeroRegs__printTC(*opts, snap, 5), snap.tc[5 - 3]);
 #ifdef TC6
-    printZeroRegTC(opts, TC6, 6);
+        case 30: SECTION(ZeroRegs__printTC(*opts, snap, 6), snap.tc[6 - 3]);
 #endif
 #ifdef TC7
-    printZeroRegTC(opts, TC7, 7);
+        case 31: SECTION(ZeroRegs__printTC(*opts, snap, 7), snap.tc[7 - 3]);
 #endif
 #ifdef USB
-    printZeroRegUSB(opts);
+        case 32: SECTION(printZeroRegUSB(*opts, snap.usb), snap.usb);
 #endif
+
+        // show how the above are clocked
+        case 33:
+            if (opts) {
+                ZeroRegs__printClocks(*opts, snap, n);
+            }
+            offset = (const uint8_t*)&snap.sysctrl - (const uint8_t*)&snap;
+            return (const uint8_t*)(&snap.nvmctrl + 1) - (const uint8_t*)&snap.sysctrl;
+
+        // and which clocks are running for nothing, which depends on nearly
+        // everything
+        case 34:
+            if (opts) {
+                printZeroRegIdleClocks(*opts, snap);
+            }
+            offset = (const uint8_t*)&snap.sysctrl - (const uint8_t*)&snap;
+            return sizeof(snap) - offset;
+    }
+    offset = 0;
+    return 0;
+}
+#undef SECTION
+
+
+void printZeroRegs(ZeroRegOptions &opts, const ZeroRegSnapshot &snap) {
+    if (opts.json) {
+        ZeroRegJSONWriter json(opts.out);
+        ZeroRegOptions jsonOpts = { json, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+        printZeroRegs(jsonOpts, snap);
+        return;
+    }
+    ZeroRegLineWriter lines(opts.out);
+    ZeroRegOptions lineOpts = { lines, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+    size_t offset;
+    for (uint8_t n = 0; n < ZEROREGS_SECTIONS; n++) {
+        ZeroRegs__section(&lineOpts, snap, n, offset);
+    }
 }
 
 
+// Goes through the lines a section prints, for printZeroRegsDiff().  First
+// HASH remembers a hash of each line of the new section.  Then OLD goes
+// through the old section and prints (and marks) each line which doesn't match
+// the new one, and NEW prints the new versions of those lines.
+class ZeroRegs__DiffPass : public Print {
+    public:
+        enum { HASH, OLD, NEW };
+        ZeroRegs__DiffPass(Print &out) : any(false), out(out) {}
+        void begin(uint8_t mode);
+        size_t write(uint8_t c);
+        using Print::write;
+        bool    any;        // whether OLD found any different lines
+    private:
+        void endLine();
+        Print   &out;
+        bool isChanged(uint8_t l) { return l >= ZEROREGS_DIFF_LINES || (changed[l / 8] & (1 << (l % 8))); }
+        uint8_t mode;
+        uint8_t line;
+        uint8_t newLines;
+        uint8_t oldLines;
+        uint32_t crc;
+        uint32_t hashes[ZEROREGS_DIFF_LINES];
+        uint8_t changed[(ZEROREGS_DIFF_LINES + 7) / 8];
+        size_t  len;
+        char    buf[ZEROREGS_MAX_LINE];
+        size_t  headerLen;
+        char    header[64];
+};
+
+void ZeroRegs__DiffPass::begin(uint8_t m) {
+    mode = m;
+    line = 0;
+    len = 0;
+    crc = 0;
+    if (mode == OLD) {
+        memset(changed, 0, sizeof(changed));
+        any = false;
+        headerLen = 0;
+    }
+}
+
+size_t ZeroRegs__DiffPass::write(uint8_t c) {
+    if (c == '\n') {
+        endLine();
+        line++;
+        len = 0;
+        crc = 0;
+    } else if (c != '\r') {
+        crc = ZeroRegs__crc32(crc, &c, 1);
+        if (len < sizeof(buf)) {
+            buf[len++] = c;
+        }
+    }
+    return 1;
+}
+
+void ZeroRegs__DiffPass::endLine() {
+    if (mode == HASH) {
+        if (line < ZEROREGS_DIFF_LINES) {
+            hashes[line] = crc;
+        }
+        newLines = line + 1;
+        return;
+    }
+    if (mode == OLD) {
+        oldLines = line + 1;
+        if (line < newLines && line < ZEROREGS_DIFF_LINES && hashes[line] == crc) {
+            if (line == 0) {
+                // keep the header in case anything else is different
+                headerLen = len < sizeof(header) ? len : sizeof(header);
+                memcpy(header, buf, headerLen);
+            }
+            return;
+        }
+        if (line < ZEROREGS_DIFF_LINES) {
+            changed[line / 8] |= 1 << (line % 8);
+        }
+        if (!any && headerLen) {
+            out.write((const uint8_t*)header, headerLen);
+            out.println();
+        }
+        any = true;
+        out.print("- ");
+        out.write((const uint8_t*)buf, len);
+        out.println();
+        return;
+    }
+    // NEW
+    if (line >= oldLines || isChanged(line)) {
+        out.print("+ ");
+        out.write((const uint8_t*)buf, len);
+        out.println();
+    }
+}
+
+
+void printZeroRegsDiff(ZeroRegOptions &opts, const ZeroRegSnapshot &base, const ZeroRegSnapshot &snap) {
+    ZeroRegLineWriter lines(opts.out);
+    ZeroRegs__DiffPass pass(lines);
+    ZeroRegOptions passOpts = { pass, true, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+    size_t offset, size;
+    for (uint8_t n = 0; n < ZEROREGS_SECTIONS; n++) {
+        // a quick check first, since most sections won't have changed
+        size = ZeroRegs__section(NULL, snap, n, offset);
+        if (!size || 0 == memcmp((const uint8_t*)&base + offset, (const uint8_t*)&snap + offset, size)) {
+            continue;
+        }
+        pass.begin(ZeroRegs__DiffPass::HASH);
+        ZeroRegs__section(&passOpts, snap, n, offset);
+        pass.begin(ZeroRegs__DiffPass::OLD);
+        ZeroRegs__section(&passOpts, base, n, offset);
+        if (pass.any) {
+            pass.begin(ZeroRegs__DiffPass::NEW);
+            ZeroRegs__section(&passOpts, snap, n, offset);
+        }
+    }
+}
+
+
+// Passes on only part of what's printed to it, for printZeroRegsStep().  It
+// skips the first `skip` bytes, then passes on bytes until the end of the line
+// or until `limit` bytes have been passed on.
+class ZeroRegs__StepSlice : public Print {
+    public:
+        ZeroRegs__StepSlice(Print &out, size_t skip, size_t limit) : total(0), written(0), out(out), skip(skip), limit(limit), ended(false) {}
+        size_t write(uint8_t c);
+        using Print::write;
+        size_t  total;      // how much was printed to this
+        size_t  written;    // how much was passed on
+    private:
+        ZeroRegLineWriter out;
+        size_t  skip;
+        size_t  limit;
+        bool    ended;
+};
+
+size_t ZeroRegs__StepSlice::write(uint8_t c) {
+    if (total++ < skip || ended || written == limit) {
+        return 1;
+    }
+    out.write(c);
+    written++;
+    ended = (c == '\n');
+    return 1;
+}
+
+
+void beginZeroRegsStep(ZeroRegStepState &state) {
+    captureZeroRegs(state.snap);
+    state.section = 0;
+    state.offset = 0;
+    state.checkAvailable = true;
+}
+
+bool printZeroRegsStep(ZeroRegOptions &opts, ZeroRegStepState &state, size_t maxBytes) {
+    if (state.checkAvailable) {
+        size_t available = opts.out.availableForWrite();
+        if (available < maxBytes) {
+            maxBytes = available;
+        }
+    }
+    if (!maxBytes) {
+        return state.section < ZEROREGS_SECTIONS;
+    }
+    if (state.section >= ZEROREGS_SECTIONS) {
+        return false;
+    }
+    // only one section each call, even if it prints nothing (such as when
+    // it's disabled), so each call takes at most one section's formatting
+    size_t offset;
+    size_t written;
+    size_t total;
+    {
+        ZeroRegs__StepSlice slice(opts.out, state.offset, maxBytes);
+        ZeroRegOptions sliceOpts = { slice, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+        ZeroRegs__section(&sliceOpts, state.snap, state.section, offset);
+        written = slice.written;
+        total = slice.total;
+    }
+    state.offset += written;
+    if (state.offset >= total) {
+        state.section++;
+        state.offset = 0;
+    }
+    return state.section < ZEROREGS_SECTIONS;
+}
+
+
+// CPU cycles since boot (wrapping every minute and a half or so).  The
+// Arduino core runs SysTick from the CPU clock and has it interrupt every
+// millisecond, so this is millis() worth of reloads plus how far SysTick has
+// counted down.  Like micros(), this checks for a reload which the interrupt
+// hasn't counted yet.
+static uint32_t ZeroRegs__cycles() {
+    uint32_t ms, val, pend;
+    do {
+        ms = millis();
+        val = SysTick->VAL;
+        pend = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    } while (ms != millis());
+    uint32_t load = SysTick->LOAD;
+    if (pend && val > load / 2) {
+        // reloaded before the interrupt had a chance to run
+        ms++;
+    }
+    return ms * (load + 1) + (load - val);
+}
+
+static const char* const ZeroRegs__sectionNames[ZEROREGS_SECTIONS] = {
+    "SCS", "SYSCTRL", "GCLK", "DMAC", "EVSYS", "PAC", "PM", "WDT",
+    "AC", "ADC", "DAC", "EIC", "I2S", "NVMCTRL", "PORT", "PORT_Arduino", "RTC",
+    "SERCOM0", "SERCOM1", "SERCOM2", "SERCOM3", "SERCOM4", "SERCOM5",
+    "TCC0", "TCC1", "TCC2", "TCC3", "TC3", "TC4", "TC5", "TC6", "TC7", "USB",
+    "CLOCKS",
+    "IDLECLOCKS",
+};
+
+static void ZeroRegs__printTiming(ZeroRegOptions &opts, const ZeroRegSnapshot &snap, const uint32_t* capture, const uint32_t* print) {
+    uint32_t perUS = (SysTick->LOAD + 1) / 1000;
+    uint32_t totalCapture = 0;
+    uint32_t totalPrint = 0;
+    size_t offset;
+    opts.out.println("--------------------------- TIMING");
+    for (uint8_t n = 0; n < ZEROREGS_SECTIONS; n++) {
+        if (!ZeroRegs__section(NULL, snap, n, offset)) {
+            continue;
+        }
+        totalCapture += capture[n];
+        totalPrint += print[n];
+        opts.out.print(ZeroRegs__sectionNames[n]);
+        opts.out.print(":  CAPTURE=");
+        opts.out.print(capture[n]);
+        opts.out.print(" PRINT=");
+        opts.out.print(print[n]);
+        PRINTNL();
+    }
+    opts.out.print("total:  CAPTURE=");
+    opts.out.print(totalCapture);
+    opts.out.print(" PRINT=");
+    opts.out.print(totalPrint);
+    opts.out.print(" (cycles");
+    if (perUS) {
+        opts.out.print(", ");
+        opts.out.print((totalCapture + totalPrint) / perUS);
+        opts.out.print("us");
+    }
+    opts.out.println(")");
+}
+
+void printZeroRegsTimed(ZeroRegOptions &opts) {
+    ZeroRegSnapshot snap;
+    uint32_t capture[ZEROREGS_SECTIONS];
+    uint32_t print[ZEROREGS_SECTIONS];
+    uint32_t start;
+    size_t offset;
+
+    memset(snap.sercom, 0, sizeof(snap.sercom));
+    memset(snap.tcc, 0, sizeof(snap.tcc));
+    memset(snap.tc, 0, sizeof(snap.tc));
+    memset(&snap.rtc, 0, sizeof(snap.rtc));
+    memset(&snap.usb, 0, sizeof(snap.usb));
+    for (uint8_t n = 0; n < ZEROREGS_SECTIONS; n++) {
+        start = ZeroRegs__cycles();
+        ZeroRegs__captureSection(snap, n);
+        capture[n] = ZeroRegs__cycles() - start;
+    }
+
+    ZeroRegLineWriter lines(opts.out);
+    ZeroRegOptions lineOpts = { lines, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+    for (uint8_t n = 0; n < ZEROREGS_SECTIONS; n++) {
+        start = ZeroRegs__cycles();
+        ZeroRegs__section(&lineOpts, snap, n, offset);
+        lines.flush();
+        print[n] = ZeroRegs__cycles() - start;
+    }
+    ZeroRegs__printTiming(lineOpts, snap, capture, print);
+}
+
+
+
+// Which part of the snapshot section `n` keeps in a watch sample.  SYSCTRL
+// and GCLK are printed together, but are captured (and so kept) apart.
+static size_t ZeroRegs__watchRegion(const ZeroRegSnapshot &snap, uint8_t n, size_t &offset) {
+    if (n == 1) {
+        offset = (const uint8_t*)&snap.sysctrl - (const uint8_t*)&snap;
+        return sizeof(snap.sysctrl);
+    }
+    if (n == 2) {
+        offset = (const uint8_t*)&snap.gclk - (const uint8_t*)&snap;
+        return sizeof(snap.gclk);
+    }
+    return ZeroRegs__section(NULL, snap, n, offset);
+}
+
+// the clocks overview sections decode nearly everything, so can't be watched
+#define ZEROREGS_WATCH_SECTIONS 33
+
+// Sets a bit in `mask` for each section named in the space-separated list.
+// Returns false if a name isn't a section which can be watched on this chip.
+static bool ZeroRegs__parseSections(const ZeroRegSnapshot &snap, const char* sections, uint64_t &mask) {
+    const char* name = sections;
+    while (*name) {
+        if (*name == ' ') {
+            name++;
+            continue;
+        }
+        size_t nameLen = 0;
+        while (name[nameLen] && name[nameLen] != ' ') {
+            nameLen++;
+        }
+        uint8_t n;
+        for (n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+            if (strlen(ZeroRegs__sectionNames[n]) == nameLen && 0 == strncmp(ZeroRegs__sectionNames[n], name, nameLen)) {
+                break;
+            }
+        }
+        size_t offset;
+        if (n == ZEROREGS_WATCH_SECTIONS || !ZeroRegs__section(NULL, snap, n, offset)) {
+            return false;
+        }
+        mask |= 1ULL << n;
+        name += nameLen;
+    }
+    return true;
+}
+
+bool beginZeroRegsWatch(ZeroRegWatchState &state, Tc* tc, uint8_t idx, uint32_t hz, const char* sections, uint8_t* buffer, size_t len) {
+    // the TCs are TC3 to TC7
+    if (idx < 3 || idx > 7) {
+        return false;
+    }
+    state.tc = tc;
+    state.idx = idx;
+    state.buffer = buffer;
+    state.sections = 0;
+    state.sampleSize = sizeof(uint32_t);
+    state.head = 0;
+    state.count = 0;
+    state.dropped = 0;
+    state.cycles = 0;
+    captureZeroRegs(state.snap);
+    if (!ZeroRegs__parseSections(state.snap, sections, state.sections)) {
+        return false;
+    }
+    size_t offset;
+    for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+        if (bitRead(state.sections, n)) {
+            state.sampleSize += ZeroRegs__watchRegion(state.snap, n, offset);
+        }
+    }
+    state.capacity = len / state.sampleSize;
+    if (!state.sections || !state.capacity) {
+        return false;
+    }
+
+    // [30.6.2.2 DSrevF] the TC needs its bus clock and its GCLK channel
+    uint8_t gclkid = ZeroRegsTC_GCLKIDs[idx - 3];
+    ZeroRegClocks clocks;
+    computeZeroRegClocks(clocks, state.snap.sysctrl, state.snap.gclk, 0);
+    uint32_t coreHz = clocks.CLKCTRL[gclkid];
+    if (!state.snap.gclk.CLKCTRL[gclkid].bit.CLKEN) {
+        GCLK_CLKCTRL_Type clkctrl;
+        clkctrl.reg = 0;
+        clkctrl.bit.ID = gclkid;
+        clkctrl.bit.GEN = 0;
+        clkctrl.bit.CLKEN = 1;
+        GCLK->CLKCTRL.reg = clkctrl.reg;
+        while (GCLK->STATUS.bit.SYNCBUSY) {}
+        coreHz = clocks.GEN[0];
+    }
+    PM->APBCMASK.reg |= PM_APBCMASK_TC3 << (idx - 3);
+
+    // [30.6.2.6 DSrevF] match frequency mode, with CC0 as the top
+    uint8_t prescaler;
+    uint32_t top = 0;
+    for (prescaler = 0; prescaler < 8; prescaler++) {
+        top = coreHz / ZeroRegsTC_PRESCALER_DIVs[prescaler] / hz;
+        if (top <= 0x10000) {
+            break;
+        }
+    }
+    if (!coreHz || !hz || !top || prescaler == 8) {
+        return false;
+    }
+    // the first sample, which also checks the budget
+    state.budget = (clocks.GEN[0] >> state.snap.pm.CPUSEL.bit.CPUDIV) / hz / ZEROREGS_WATCH_BUDGET;
+    sampleZeroRegsWatch(state);
+    if (state.cycles > state.budget) {
+        return false;
+    }
+
+    // start from a clean slate, whatever the TC was used for before
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_SWRST;
+    while (tc->COUNT16.CTRLA.bit.SWRST || tc->COUNT16.STATUS.bit.SYNCBUSY) {}
+    tc->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_WAVEGEN_MFRQ | TC_CTRLA_PRESCALER(prescaler);
+    while (tc->COUNT16.STATUS.bit.SYNCBUSY) {}
+    tc->COUNT16.CC[0].reg = top - 1;
+    while (tc->COUNT16.STATUS.bit.SYNCBUSY) {}
+    tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+    tc->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
+    // so the samples are decoded with the TC's clocks, done before the
+    // interrupt can start sampling into the same snapshot
+    captureZeroRegGCLK(state.snap.gclk);
+    captureZeroRegPM(state.snap.pm);
+    NVIC_EnableIRQ((IRQn_Type)(TC3_IRQn + idx - 3));
+    tc->COUNT16.CTRLA.reg |= TC_CTRLA_ENABLE;
+    while (tc->COUNT16.STATUS.bit.SYNCBUSY) {}
+    return true;
+}
+
+void sampleZeroRegsWatch(ZeroRegWatchState &state) {
+    // not just SysTick, since a sample can take longer than its reload
+    uint32_t start = ZeroRegs__cycles();
+    state.tc->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+    uint8_t* sample = state.buffer + state.head * state.sampleSize;
+    uint32_t now = micros();
+    memcpy(sample, &now, sizeof(now));
+    sample += sizeof(now);
+    for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+        if (!bitRead(state.sections, n)) {
+            continue;
+        }
+        // both PORT sections decode the registers the first captures
+        ZeroRegs__captureSection(state.snap, n == 15 ? 14 : n);
+        size_t offset;
+        size_t size = ZeroRegs__watchRegion(state.snap, n, offset);
+        memcpy(sample, (const uint8_t*)&state.snap + offset, size);
+        sample += size;
+    }
+    state.head = (state.head + 1) % state.capacity;
+    if (state.count < state.capacity) {
+        state.count++;
+    } else {
+        state.dropped++;
+    }
+    uint32_t cycles = ZeroRegs__cycles() - start;
+    if (cycles > state.cycles) {
+        state.cycles = cycles;
+    }
+}
+
+void endZeroRegsWatch(ZeroRegWatchState &state) {
+    NVIC_DisableIRQ((IRQn_Type)(TC3_IRQn + state.idx - 3));
+    state.tc->COUNT16.INTENCLR.reg = TC_INTENCLR_MC0;
+    state.tc->COUNT16.CTRLA.reg &= ~TC_CTRLA_ENABLE;
+    while (state.tc->COUNT16.STATUS.bit.SYNCBUSY) {}
+}
+
+// Takes the oldest sample out of the buffer, putting its sections into
+// `snap`.  Returns false if there are none.
+static bool ZeroRegs__popWatch(ZeroRegWatchState &state, ZeroRegSnapshot &snap, uint32_t &time) {
+    // keep the interrupt from replacing the sample while it's copied
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    bool found = state.count > 0;
+    if (found) {
+        uint16_t tail = (state.head + state.capacity - state.count) % state.capacity;
+        const uint8_t* sample = state.buffer + tail * state.sampleSize;
+        memcpy(&time, sample, sizeof(time));
+        sample += sizeof(time);
+        for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+            if (bitRead(state.sections, n)) {
+                size_t offset;
+                size_t size = ZeroRegs__watchRegion(snap, n, offset);
+                memcpy((uint8_t*)&snap + offset, sample, size);
+                sample += size;
+            }
+        }
+        state.count--;
+    }
+    __set_PRIMASK(primask);
+    return found;
+}
+
+void printZeroRegsWatch(ZeroRegOptions &opts, ZeroRegWatchState &state) {
+    ZeroRegLineWriter lines(opts.out);
+    ZeroRegOptions lineOpts = { lines, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+    // what isn't watched is decoded as it was when watching began
+    ZeroRegSnapshot snap;
+    memcpy(&snap, &state.snap, sizeof(snap));
+    lines.println("--------------------------- WATCH");
+    lines.print("watch:  samples=");
+    lines.print(state.count);
+    lines.print(" dropped=");
+    lines.print(state.dropped);
+    lines.print(" size=");
+    lines.print(state.sampleSize);
+    lines.print("bytes cycles=");
+    lines.print(state.cycles);
+    lines.print(" budget=");
+    lines.print(state.budget);
+    if (state.cycles > state.budget) {
+        lines.print(" (over budget)");
+    }
+    lines.println(ZeroRegs__empty);
+    uint32_t time;
+    size_t offset;
+    while (ZeroRegs__popWatch(state, snap, time)) {
+        lines.println("--------------------------- SAMPLE");
+        lines.print("time:  ");
+        lines.print(time);
+        lines.println("us");
+        for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+            if (bitRead(state.sections, n)) {
+                ZeroRegs__section(&lineOpts, snap, n, offset);
+            }
+        }
+    }
+}
+
+
+static uint32_t ZeroRegs__readWatchItem(uintptr_t addr, uint8_t size) {
+    switch (size) {
+        case 1: return *(volatile const uint8_t*)addr;
+        case 2: return *(volatile const uint16_t*)addr;
+    }
+    return *(volatile const uint32_t*)addr;
+}
+
+bool beginZeroRegsWatchlist(ZeroRegWatchlist &list, const ZeroRegWatchItem* items, uint8_t count, ZeroRegWatchChange* changes, uint16_t len) {
+    if (count > ZEROREGS_WATCHLIST_ITEMS) {
+        return false;
+    }
+    list.items = items;
+    list.count = count;
+    list.changes = changes;
+    list.capacity = len;
+    list.used = 0;
+    list.dropped = 0;
+    list.samples = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (items[i].size != 1 && items[i].size != 2 && items[i].size != 4) {
+            return false;
+        }
+        list.addr[i] = items[i].addr;
+        list.size[i] = items[i].size;
+        list.mask[i] = items[i].mask ? items[i].mask : (uint32_t)(0xFFFFFFFFULL >> (32 - 8 * items[i].size));
+        list.first[i] = ZeroRegs__readWatchItem(list.addr[i], list.size[i]) & list.mask[i];
+        list.last[i] = list.first[i];
+    }
+    list.begun = ZeroRegs__cycles();
+    list.ended = list.begun;
+    return true;
+}
+
+void sampleZeroRegsWatchlist(ZeroRegWatchlist &list, uint32_t times) {
+    uint32_t now = list.ended;
+    while (times--) {
+        now = ZeroRegs__cycles();
+        for (uint8_t i = 0; i < list.count; i++) {
+            uint32_t value = ZeroRegs__readWatchItem(list.addr[i], list.size[i]) & list.mask[i];
+            if (value == list.last[i]) {
+                continue;
+            }
+            list.last[i] = value;
+            if (list.used < list.capacity) {
+                ZeroRegWatchChange &change = list.changes[list.used++];
+                change.cycles = now;
+                change.value = value;
+                change.item = i;
+            } else {
+                list.dropped++;
+            }
+        }
+        list.samples++;
+    }
+    list.ended = now;
+}
+
+// Prints how long `cycles` is, or just the cycles if the CPU clock isn't known.
+static void ZeroRegs__printCycles(Print &out, uint32_t cycles) {
+    uint32_t perUS = (SysTick->LOAD + 1) / 1000;
+    if (perUS) {
+        ZeroRegs__printNS(out, (uint32_t)(cycles * 1000ULL / perUS));
+    } else {
+        out.print(cycles);
+        out.print("cycles");
+    }
+}
+
+static void ZeroRegs__printWatchValue(ZeroRegOptions &opts, const ZeroRegWatchlist &list, uint8_t i, uint32_t value, uint32_t changed) {
+    opts.out.print(list.items[i].name);
+    opts.out.print(":  value=");
+    PRINTHEX(value);
+    if (changed) {
+        opts.out.print(" changed=");
+        PRINTHEX(changed);
+    }
+}
+
+void printZeroRegsWatchlist(ZeroRegOptions &opts, const ZeroRegWatchlist &list) {
+    ZeroRegLineWriter lines(opts.out);
+    ZeroRegOptions lineOpts = { lines, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+    lineOpts.out.println("--------------------------- WATCHLIST");
+    lineOpts.out.print("watchlist:  samples=");
+    lineOpts.out.print(list.samples);
+    if (list.samples > 1) {
+        lineOpts.out.print(" interval=");
+        ZeroRegs__printCycles(lineOpts.out, (list.ended - list.begun) / (list.samples - 1));
+    }
+    lineOpts.out.print(" changes=");
+    lineOpts.out.print(list.used + list.dropped);
+    if (list.dropped) {
+        lineOpts.out.print(" dropped=");
+        lineOpts.out.print(list.dropped);
+    }
+    lineOpts.out.println(ZeroRegs__empty);
+    uint32_t value[ZEROREGS_WATCHLIST_ITEMS];
+    for (uint8_t i = 0; i < list.count; i++) {
+        value[i] = list.first[i];
+        ZeroRegs__printWatchValue(lineOpts, list, i, value[i], 0);
+        if (list.mask[i] != (uint32_t)(0xFFFFFFFFULL >> (32 - 8 * list.size[i]))) {
+            lineOpts.out.print(" mask=0x");
+            lineOpts.out.print(list.mask[i], HEX);
+        }
+        lineOpts.out.println(" (initial)");
+    }
+    for (uint16_t c = 0; c < list.used; c++) {
+        const ZeroRegWatchChange &change = list.changes[c];
+        ZeroRegs__printWatchValue(lineOpts, list, change.item, change.value, value[change.item] ^ change.value);
+        value[change.item] = change.value;
+        lineOpts.out.print(" time=+");
+        ZeroRegs__printCycles(lineOpts.out, change.cycles - list.begun);
+        lineOpts.out.println(ZeroRegs__empty);
+    }
+}
+
+// [22.6 DSrevF] a row is erased at once, and is written a page at a time
+#define ZEROREGS_NVM_PAGE 64
+#define ZEROREGS_NVM_ROW (4 * ZEROREGS_NVM_PAGE)
+// the datasheet's longest page programming time (tFPP)
+#define ZEROREGS_NVM_WRITE_US 2500
+
+// What's at the start of a post-mortem record, followed by the regions of
+// the saved sections (in section order).
+struct ZeroRegs__PostMortemHeader {
+    uint8_t     magic[2];       // "ZP"
+    uint8_t     version;        // ZEROREGS_FRAME_VERSION
+    uint8_t     reserved;
+    uint32_t    uptime;         // millis() when it was saved
+    uint64_t    sections;       // bitmask, indexed by section
+    uint16_t    snapSize;       // sizeof(ZeroRegSnapshot)
+    uint16_t    length;         // bytes of regions after the header
+    uint32_t    crc;            // CRC-32 of the header before this, then the regions
+};
+
+// Both PORT sections decode the same registers, so those are only kept once.
+static bool ZeroRegs__postMortemKeeps(uint64_t sections, uint8_t n) {
+    return bitRead(sections, n) && !(n == 15 && bitRead(sections, 14));
+}
+
+// Captures the kept sections, and continues `crc` over their regions.
+static uint32_t ZeroRegs__capturePostMortem(ZeroRegPostMortem &pm, uint32_t crc) {
+    size_t offset;
+    for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+        if (ZeroRegs__postMortemKeeps(pm.sections, n)) {
+            ZeroRegs__captureSection(pm.snap, n == 15 ? 14 : n);
+            size_t size = ZeroRegs__watchRegion(pm.snap, n, offset);
+            crc = ZeroRegs__crc32(crc, (const uint8_t*)&pm.snap + offset, size);
+        }
+    }
+    return crc;
+}
+
+// Runs an NVMCTRL command on the row or page with `addr`, and waits for it.
+static void ZeroRegs__nvmCommand(uint32_t addr, uint16_t cmd) {
+    while (!NVMCTRL->INTFLAG.bit.READY) {}
+    NVMCTRL->STATUS.reg = NVMCTRL_STATUS_MASK;
+    // [22.8 DSrevF] ADDR is in 16-bit words
+    NVMCTRL->ADDR.reg = addr / 2;
+    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMDEX_KEY | cmd;
+    while (!NVMCTRL->INTFLAG.bit.READY) {}
+}
+
+// Collects bytes into a page, and writes each page once it's full.  The page
+// buffer only takes 16- and 32-bit writes, so the page is kept in RAM first.
+struct ZeroRegs__FlashWriter {
+    uint32_t    addr;
+    uint8_t     fill;
+    uint32_t    page[ZEROREGS_NVM_PAGE / 4];
+};
+
+static void ZeroRegs__flashFlush(ZeroRegs__FlashWriter &w) {
+    if (!w.fill) {
+        return;
+    }
+    ZeroRegs__nvmCommand(w.addr, NVMCTRL_CTRLA_CMD_PBC);
+    volatile uint32_t* dst = (volatile uint32_t*)(uintptr_t)w.addr;
+    for (uint8_t i = 0; i < ZEROREGS_NVM_PAGE / 4; i++) {
+        dst[i] = w.page[i];
+    }
+    ZeroRegs__nvmCommand(w.addr, NVMCTRL_CTRLA_CMD_WP);
+    w.addr += ZEROREGS_NVM_PAGE;
+    w.fill = 0;
+    memset(w.page, 0xFF, sizeof(w.page));
+}
+
+static void ZeroRegs__flashWrite(ZeroRegs__FlashWriter &w, const void* data, size_t len) {
+    const uint8_t* src = (const uint8_t*)data;
+    while (len) {
+        size_t n = ZEROREGS_NVM_PAGE - w.fill;
+        if (n > len) {
+            n = len;
+        }
+        memcpy((uint8_t*)w.page + w.fill, src, n);
+        w.fill += n;
+        src += n;
+        len -= n;
+        if (w.fill == ZEROREGS_NVM_PAGE) {
+            ZeroRegs__flashFlush(w);
+        }
+    }
+}
+
+bool beginZeroRegsPostMortem(ZeroRegPostMortem &pm, uint32_t addr, size_t len, const char* sections) {
+    pm.addr = addr;
+    pm.sections = 0;
+    pm.size = sizeof(ZeroRegs__PostMortemHeader);
+    pm.writeUS = 0;
+    pm.windowUS = 0;
+    pm.armed = false;
+    captureZeroRegs(pm.snap);
+
+    size_t offset;
+    if (sections) {
+        if (!ZeroRegs__parseSections(pm.snap, sections, pm.sections)) {
+            return false;
+        }
+    } else {
+        for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+            if (n != 15 && ZeroRegs__section(NULL, pm.snap, n, offset)) {
+                pm.sections |= 1ULL << n;
+            }
+        }
+    }
+    for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+        if (ZeroRegs__postMortemKeeps(pm.sections, n)) {
+            pm.size += ZeroRegs__watchRegion(pm.snap, n, offset);
+        }
+    }
+
+    // the record has to fit in whole rows of flash
+    uint32_t flashSize = NVMCTRL->PARAM.bit.NVMP * (8UL << NVMCTRL->PARAM.bit.PSZ);
+    size_t rows = (pm.size + ZEROREGS_NVM_ROW - 1) / ZEROREGS_NVM_ROW;
+    if (!pm.sections || addr % ZEROREGS_NVM_ROW || rows * ZEROREGS_NVM_ROW > len || addr + len > flashSize) {
+        return false;
+    }
+
+    // saving captures and checksums before it writes, so time that
+    uint32_t start = ZeroRegs__cycles();
+    ZeroRegs__capturePostMortem(pm, 0);
+    uint32_t cycles = ZeroRegs__cycles() - start;
+    uint32_t perUS = (SysTick->LOAD + 1) / 1000;
+    pm.writeUS = (perUS ? cycles / perUS : 0) + (pm.size + ZEROREGS_NVM_PAGE - 1) / ZEROREGS_NVM_PAGE * ZEROREGS_NVM_WRITE_US;
+    // [18.6.2 DSrevF] the early warning comes EWOFFSET cycles after the
+    // WDT was cleared, and the reset PER cycles after
+    if (pm.snap.wdt.CTRL.bit.ENABLE && WDT->INTENSET.bit.EW) {
+        ZeroRegClocks clocks;
+        computeZeroRegClocks(clocks, pm.snap.sysctrl, pm.snap.gclk, 0);
+        uint32_t hz = clocks.CLKCTRL[GCLK_CLKCTRL_ID_WDT_Val];
+        uint32_t per = 8UL << pm.snap.wdt.CONFIG.bit.PER;
+        uint32_t ewoffset = 8UL << pm.snap.wdt.EWCTRL.bit.EWOFFSET;
+        if (hz && per > ewoffset) {
+            pm.windowUS = (uint64_t)(per - ewoffset) * 1000000 / hz;
+        }
+        if (pm.writeUS > pm.windowUS) {
+            return false;
+        }
+    }
+
+    // erasing takes longer than writing, so it's done now
+    for (size_t r = 0; r < rows; r++) {
+        ZeroRegs__nvmCommand(addr + r * ZEROREGS_NVM_ROW, NVMCTRL_CTRLA_CMD_ER);
+    }
+    pm.armed = true;
+    return true;
+}
+
+bool saveZeroRegsPostMortem(ZeroRegPostMortem &pm) {
+    // flash can only be written once between erases
+    if (!pm.armed) {
+        return false;
+    }
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    pm.armed = false;
+    ZeroRegs__PostMortemHeader header;
+    header.magic[0] = 'Z';
+    header.magic[1] = 'P';
+    header.version = ZEROREGS_FRAME_VERSION;
+    header.reserved = 0;
+    header.uptime = millis();
+    header.sections = pm.sections;
+    header.snapSize = sizeof(ZeroRegSnapshot);
+    header.length = pm.size - sizeof(header);
+    header.crc = ZeroRegs__crc32(0, (const uint8_t*)&header, offsetof(ZeroRegs__PostMortemHeader, crc));
+    header.crc = ZeroRegs__capturePostMortem(pm, header.crc);
+    size_t offset;
+
+    NVMCTRL_CTRLB_Type ctrlb;
+    ctrlb.reg = NVMCTRL->CTRLB.reg;
+    // [22.6 DSrevF] writing a page has to be asked for
+    NVMCTRL->CTRLB.bit.MANW = 1;
+    ZeroRegs__FlashWriter w;
+    w.addr = pm.addr;
+    w.fill = 0;
+    memset(w.page, 0xFF, sizeof(w.page));
+    ZeroRegs__flashWrite(w, &header, sizeof(header));
+    for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+        if (ZeroRegs__postMortemKeeps(pm.sections, n)) {
+            size_t size = ZeroRegs__watchRegion(pm.snap, n, offset);
+            ZeroRegs__flashWrite(w, (const uint8_t*)&pm.snap + offset, size);
+        }
+    }
+    ZeroRegs__flashFlush(w);
+    NVMCTRL->CTRLB.reg = ctrlb.reg;
+    NVMCTRL_STATUS_Type status;
+    status.reg = NVMCTRL->STATUS.reg;
+    bool ok = !status.bit.PROGE && !status.bit.LOCKE && !status.bit.NVME;
+    __set_PRIMASK(primask);
+    return ok;
+}
+
+static bool ZeroRegs__printPostMortem(ZeroRegOptions &opts, uint32_t addr) {
+    opts.out.println("--------------------------- POSTMORTEM");
+    // [16.8 DSrevF] why the chip last reset
+    PM_RCAUSE_Type rcause;
+    rcause.reg = PM->RCAUSE.reg;
+    opts.out.print("RCAUSE: ");
+    PRINTFLAG(rcause, POR);
+    PRINTFLAG(rcause, BOD12);
+    PRINTFLAG(rcause, BOD33);
+    PRINTFLAG(rcause, EXT);
+    // WDT is also the name of the peripheral
+    if (rcause.reg & PM_RCAUSE_WDT) {
+        opts.out.print(" WDT");
+    }
+    PRINTFLAG(rcause, SYST);
+    PRINTNL();
+
+    ZeroRegs__PostMortemHeader header;
+    const uint8_t* record = (const uint8_t*)(uintptr_t)addr;
+    memcpy(&header, record, sizeof(header));
+    bool found = header.magic[0] == 'Z' && header.magic[1] == 'P' && header.version == ZEROREGS_FRAME_VERSION
+        && header.snapSize == sizeof(ZeroRegSnapshot) && header.length <= sizeof(ZeroRegSnapshot)
+        && !(header.sections >> ZEROREGS_WATCH_SECTIONS);
+    if (found) {
+        uint32_t crc = ZeroRegs__crc32(0, record, offsetof(ZeroRegs__PostMortemHeader, crc));
+        found = header.crc == ZeroRegs__crc32(crc, record + sizeof(header), header.length);
+    }
+    if (!found) {
+        opts.out.println("postmortem:  (none saved)");
+        return false;
+    }
+    opts.out.print("postmortem:  uptime=");
+    opts.out.print(header.uptime);
+    opts.out.print("ms size=");
+    opts.out.print(sizeof(header) + header.length);
+    opts.out.println("bytes");
+
+    // what wasn't saved is left as zeros, which reads as disabled
+    ZeroRegSnapshot snap;
+    memset(&snap, 0, sizeof(snap));
+    const uint8_t* region = record + sizeof(header);
+    size_t offset;
+    for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+        if (ZeroRegs__postMortemKeeps(header.sections, n)) {
+            size_t size = ZeroRegs__watchRegion(snap, n, offset);
+            memcpy((uint8_t*)&snap + offset, region, size);
+            region += size;
+        }
+    }
+    for (uint8_t n = 0; n < ZEROREGS_WATCH_SECTIONS; n++) {
+        if (bitRead(header.sections, n)) {
+            ZeroRegs__section(&opts, snap, n, offset);
+        }
+    }
+    // the clocks overview needs SYSCTRL, GCLK, PM, and NVMCTRL
+    if (bitRead(header.sections, 1) && bitRead(header.sections, 2) && bitRead(header.sections, 6) && bitRead(header.sections, 13)) {
+        ZeroRegs__section(&opts, snap, 33, offset);
+    }
+    return true;
+}
+
+bool printZeroRegsPostMortem(ZeroRegOptions &opts, uint32_t addr) {
+    ZeroRegLineWriter lines(opts.out);
+    ZeroRegOptions lineOpts = { lines, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+    return ZeroRegs__printPostMortem(lineOpts, addr);
+}
+
+// Clears what changes as the sketch runs without being reconfigured, so that
+// the fingerprints only cover configuration.
+static void ZeroRegs__settleFingerprint(ZeroRegSnapshot &snap) {
+    snap.scs.SysTick_CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+    snap.scs.NVIC_ISPR = 0;
+    // the write-back descriptors are where each transfer has got to
+    memset(snap.dmac.WRB, 0, sizeof(snap.dmac.WRB));
+    // the levels driven on outputs, but not which way inputs are pulled
+    for (uint8_t g = 0; g < 2; g++) {
+        snap.port.Group[g].OUT.reg &= ~snap.port.Group[g].DIR.reg;
+    }
+    // what differs from chip to chip: the serial number, and the factory
+    // calibration which is loaded into the oscillators, ADC, and USB pads
+    memset(snap.nvmctrl.SERIAL, 0, sizeof(snap.nvmctrl.SERIAL));
+    memset(snap.nvmctrl.OTP4, 0, sizeof(snap.nvmctrl.OTP4));
+    snap.sysctrl.OSC32K.bit.CALIB = 0;
+    snap.sysctrl.OSCULP32K.bit.CALIB = 0;
+    snap.sysctrl.OSC8M.bit.CALIB = 0;
+    snap.adc.CALIB.reg = 0;
+    // the USB descriptors' byte counts are how far each transfer has got
+    if (snap.usb.DEVICE.CTRLA.bit.MODE) {
+        snap.usb.HOST.PADCAL.reg = 0;
+        for (uint8_t ep = 0; ep < 8; ep++) {
+            for (uint8_t b = 0; b < 2; b++) {
+                snap.usb.HOST.DescBank[ep][b].PCKSIZE.bit.BYTE_COUNT = 0;
+                snap.usb.HOST.DescBank[ep][b].PCKSIZE.bit.MULTI_PACKET_SIZE = 0;
+            }
+        }
+    } else {
+        snap.usb.DEVICE.PADCAL.reg = 0;
+        for (uint8_t ep = 0; ep < 8; ep++) {
+            for (uint8_t b = 0; b < 2; b++) {
+                snap.usb.DEVICE.DescBank[ep][b].PCKSIZE.bit.BYTE_COUNT = 0;
+                snap.usb.DEVICE.DescBank[ep][b].PCKSIZE.bit.MULTI_PACKET_SIZE = 0;
+            }
+        }
+    }
+}
+
+// Stops the CRC engine, putting back what ZeroRegs__crcEngineBegin() found.
+static void ZeroRegs__crcEngineEnd(uint16_t crcctrl, uint32_t chksum) {
+    DMAC->CTRL.reg &= ~DMAC_CTRL_CRCENABLE;
+    DMAC->CRCCTRL.reg = crcctrl;
+    DMAC->CRCCHKSUM.reg = chksum;
+}
+
+static uint32_t ZeroRegs__crcEngine(const uint8_t* data, size_t len) {
+    DMAC->CRCCHKSUM.reg = 0xFFFFFFFF;
+    while (len--) {
+        DMAC->CRCDATAIN.reg = *data++;
+    }
+    return DMAC->CRCCHKSUM.reg;
+}
+
+// [20.6.3.7 DSrevF] The DMAC CRC engine, fed bytes by the CPU.  It's only used
+// if nothing else is, and if it gives the same CRC-32 as ZeroRegs__crc32()
+// for the standard check string.
+static bool ZeroRegs__crcEngineBegin(uint16_t &crcctrl, uint32_t &chksum) {
+    if (DMAC->CTRL.bit.CRCENABLE) {
+        return false;
+    }
+    crcctrl = DMAC->CRCCTRL.reg;
+    chksum = DMAC->CRCCHKSUM.reg;
+    DMAC->CRCCTRL.reg = DMAC_CRCCTRL_CRCBEATSIZE_BYTE | DMAC_CRCCTRL_CRCPOLY_CRC32 | DMAC_CRCCTRL_CRCSRC_IO;
+    DMAC->CTRL.reg |= DMAC_CTRL_CRCENABLE;
+    static const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    if (ZeroRegs__crcEngine(check, sizeof(check)) != 0xCBF43926) {
+        ZeroRegs__crcEngineEnd(crcctrl, chksum);
+        return false;
+    }
+    return true;
+}
+
+void computeZeroRegFingerprints(ZeroRegFingerprints &fp, const ZeroRegSnapshot &snap) {
+    ZeroRegSnapshot settled;
+    memcpy(&settled, &snap, sizeof(settled));
+    ZeroRegs__settleFingerprint(settled);
+    // the DMAC registers have already been captured, so using its CRC engine
+    // doesn't change them
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint16_t crcctrl = 0;
+    uint32_t chksum = 0;
+    fp.dmac = ZeroRegs__crcEngineBegin(crcctrl, chksum);
+    fp.sections = 0;
+    fp.all = 0;
+    size_t offset;
+    for (uint8_t n = 0; n < ZEROREGS_FINGERPRINTS; n++) {
+        fp.crc[n] = 0;
+        // the second PORT section covers the same registers as the first
+        size_t size = n == 15 ? 0 : ZeroRegs__watchRegion(settled, n, offset);
+        if (!size) {
+            continue;
+        }
+        fp.sections |= 1ULL << n;
+        const uint8_t* region = (const uint8_t*)&settled + offset;
+        fp.crc[n] = fp.dmac ? ZeroRegs__crcEngine(region, size) : ZeroRegs__crc32(0, region, size);
+        // the combined one is of all the others, in order, little-endian
+        for (uint8_t b = 0; b < 4; b++) {
+            uint8_t c = fp.crc[n] >> (8 * b);
+            fp.all = ZeroRegs__crc32(fp.all, &c, 1);
+        }
+    }
+    if (fp.dmac) {
+        ZeroRegs__crcEngineEnd(crcctrl, chksum);
+    }
+    __set_PRIMASK(primask);
+}
+
+static void ZeroRegs__printFingerprints(ZeroRegOptions &opts, const ZeroRegFingerprints &fp) {
+    opts.out.println("--------------------------- FINGERPRINTS");
+    for (uint8_t n = 0; n < ZEROREGS_FINGERPRINTS; n++) {
+        if (!bitRead(fp.sections, n)) {
+            continue;
+        }
+        opts.out.print(ZeroRegs__sectionNames[n]);
+        opts.out.print(":  crc=");
+        PRINTHEX(fp.crc[n]);
+        PRINTNL();
+    }
+    opts.out.print("all:  crc=");
+    PRINTHEX(fp.all);
+    opts.out.print(" engine=");
+    opts.out.print(fp.dmac ? "DMAC" : "software");
+    PRINTNL();
+}
+
+void printZeroRegsFingerprints(ZeroRegOptions &opts, const ZeroRegSnapshot &snap) {
+    ZeroRegFingerprints fp;
+    computeZeroRegFingerprints(fp, snap);
+    if (opts.json) {
+        ZeroRegJSONWriter json(opts.out);
+        ZeroRegOptions jsonOpts = { json, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+        ZeroRegs__printFingerprints(jsonOpts, fp);
+        return;
+    }
+    ZeroRegLineWriter lines(opts.out);
+    ZeroRegOptions lineOpts = { lines, opts.showDisabled, false, opts.xoscHz, opts.irqCritical, opts.irqCriticalCount };
+    ZeroRegs__printFingerprints(lineOpts, fp);
+}
+
+void printZeroRegsFingerprints(ZeroRegOptions &opts) {
+    ZeroRegSnapshot snap;
+    captureZeroRegs(snap);
+    printZeroRegsFingerprints(opts, snap);
+}
+
+void printZeroRegs(ZeroRegOptions &opts) {
+    ZeroRegSnapshot snap;
+    captureZeroRegs(snap);
+    printZeroRegs(opts, snap);
+}
+
+void printZeroRegsDiff(ZeroRegOptions &opts, const ZeroRegSnapshot &base) {
+    ZeroRegSnapshot snap;
+    captureZeroRegs(snap);
+    printZeroRegsDiff(opts, base, snap);
+}
+
+
+// see ZeroRegs.h for the layout of the frame
+#define ZEROREGS_FRAME_HEADER 5
+void writeZeroRegs(Print &out, const ZeroRegSnapshot &snap) {
+    uint8_t header[ZEROREGS_FRAME_HEADER];
+    header[0] = 'Z';
+    header[1] = 'R';
+    header[2] = ZEROREGS_FRAME_VERSION;
+    header[3] = sizeof(snap) & 0xFF;
+    header[4] = sizeof(snap) >> 8;
+    uint32_t crc = ZeroRegs__crc32(0, header + 2, ZEROREGS_FRAME_HEADER - 2);
+    crc = ZeroRegs__crc32(crc, (const uint8_t*)&snap, sizeof(snap));
+    uint8_t trailer[4];
+    trailer[0] = crc & 0xFF;
+    trailer[1] = (crc >> 8) & 0xFF;
+    trailer[2] = (crc >> 16) & 0xFF;
+    trailer[3] = crc >> 24;
+    out.write(header, sizeof(header));
+    out.write((const uint8_t*)&snap, sizeof(snap));
+    out.write(trailer, sizeof(trailer));
+}
+
+void writeZeroRegs(Print &out) {
+    ZeroRegSnapshot snap;
+    captureZeroRegs(snap);
+    writeZeroRegs(out, snap);
+}
+
+bool readZeroRegs(const uint8_t* frame, size_t len, ZeroRegSnapshot &snap) {
+    if (len != ZEROREGS_FRAME_SIZE) {
+        return false;
+    }
+    if (frame[0] != 'Z' || frame[1] != 'R' || frame[2] != ZEROREGS_FRAME_VERSION) {
+        return false;
+    }
+    if ((frame[3] | (frame[4] << 8)) != sizeof(snap)) {
+        return false;
+    }
+    const uint8_t* trailer = frame + ZEROREGS_FRAME_HEADER + sizeof(snap);
+    uint32_t crc = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+    if (crc != ZeroRegs__crc32(0, frame + 2, ZEROREGS_FRAME_HEADER - 2 + sizeof(snap))) {
+        return false;
+    }
+    memcpy(&snap, frame + ZEROREGS_FRAME_HEADER, sizeof(snap));
+    return true;
+}
@@ -36,9 +36,568 @@ SOFTWARE.
 struct ZeroRegOptions {
     Print   &out;
     bool    showDisabled;
+    bool    json;           // printZeroRegs() prints JSON instead of text
+    uint32_t xoscHz;        // frequency of the XOSC crystal, 0 if unknown
+    // IRQs which mustn't wait, most critical first, for the SCS latency audit
+    const IRQn_Type *irqCritical;
+    uint8_t irqCriticalCount;
 };
 
 
+// Collects what is printed into whole lines and passes each line to the
+// wrapped Print with a single write().  The printers make many small prints
+// per line, and over SerialUSB each write() can cost about as much as a whole
+// line.  printZeroRegs() already does this.  To do the same when calling one
+// of the other printers:
+//      ZeroRegLineWriter lines(SerialUSB);
+//      ZeroRegOptions opts = { lines, false };
+//      printZeroRegGCLK(opts);
+// Lines longer than ZEROREGS_LINE_BUFFER are written in pieces.
+#ifndef ZEROREGS_LINE_BUFFER
+#define ZEROREGS_LINE_BUFFER 128
+#endif
+class ZeroRegLineWriter : public Print {
+    public:
+        ZeroRegLineWriter(Print &out) : out(out), len(0) {}
+        ~ZeroRegLineWriter() { flushLine(); }
+        size_t write(uint8_t c);
+        size_t write(const uint8_t *buffer, size_t size);
+        void flush();
+        using Print::write;
+    private:
+        void flushLine();
+        Print   &out;
+        size_t  len;
+        uint8_t buf[ZEROREGS_LINE_BUFFER];
+};
+
+
+// Turns the text printed to it into JSON, one line at a time, and writes that
+// to the wrapped Print.  Each section header becomes an object, each register
+// line becomes an object inside that, and each field inside that:
+//      "FLAG": true            for a flag
+//      "name": "value"         for `name=value`
+//      "value": "..."          for bare values (such as "PER:  255")
+//      "note": "..."           for comments (such as "(slow)")
+// Lines which are indented become objects inside the register line above
+// them.  Values are kept as the same strings the text has.  The JSON is
+// finished by end(), which the destructor calls.  printZeroRegs() uses one of
+// these when `opts.json` is set.  Lines longer than ZEROREGS_MAX_LINE are
+// cut short, and get a "truncated": true member so that it's noticed.
+#ifndef ZEROREGS_MAX_LINE
+#define ZEROREGS_MAX_LINE 256
+#endif
+class ZeroRegJSONWriter : public Print {
+    public:
+        ZeroRegJSONWriter(Print &out) : out(out), len(0), cut(false), started(false), inSection(false), inRegister(false), first(true) {}
+        ~ZeroRegJSONWriter() { end(); }
+        size_t write(uint8_t c);
+        size_t write(const uint8_t *buffer, size_t size);
+        void flush();
+        void end();
+        using Print::write;
+    private:
+        void line();
+        void fields(const char* s, size_t n);
+        void chars(const char* s, size_t n);
+        void member(const char* name, size_t n, bool newline);
+        ZeroRegLineWriter out;
+        size_t  len;
+        bool    cut;            // the line was longer than buf
+        bool    started;
+        bool    inSection;
+        bool    inRegister;
+        bool    first;
+        char    buf[ZEROREGS_MAX_LINE];
+};
+
+
+// Raw copies of the registers the decoders use, captured by the
+// captureZeroReg*() functions and decoded later by the printZeroReg*()
+// functions which take a snapshot.  Each register keeps its CMSIS type and
+// name so it decodes the same way the live register does.  Capturing is
+// quick and only reads hardware, so it can be done in a tight loop and
+// printed once things are idle.
+#define ZEROREGS_PACKED __attribute__((packed))
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_AC {
+    AC_CTRLA_Type       CTRLA;
+    AC_EVCTRL_Type      EVCTRL;
+    AC_WINCTRL_Type     WINCTRL;
+    AC_COMPCTRL_Type    COMPCTRL[2];
+    AC_SCALER_Type      SCALER[2];
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_ADC {
+    ADC_CTRLA_Type      CTRLA;
+    ADC_REFCTRL_Type    REFCTRL;
+    ADC_AVGCTRL_Type    AVGCTRL;
+    ADC_SAMPCTRL_Type   SAMPCTRL;
+    ADC_CTRLB_Type      CTRLB;
+    ADC_WINCTRL_Type    WINCTRL;
+    ADC_INPUTCTRL_Type  INPUTCTRL;
+    ADC_EVCTRL_Type     EVCTRL;
+    ADC_WINLT_Type      WINLT;
+    ADC_WINUT_Type      WINUT;
+    ADC_GAINCORR_Type   GAINCORR;
+    ADC_OFFSETCORR_Type OFFSETCORR;
+    ADC_CALIB_Type      CALIB;
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_DAC {
+    DAC_CTRLA_Type      CTRLA;
+    DAC_CTRLB_Type      CTRLB;
+    DAC_EVCTRL_Type     EVCTRL;
+};
+
+// a DMAC transfer descriptor, as found in SRAM
+struct ZEROREGS_PACKED ZeroRegSnapshot_DMAC_Descriptor {
+    DMAC_BTCTRL_Type    BTCTRL;
+    DMAC_BTCNT_Type     BTCNT;
+    DMAC_SRCADDR_Type   SRCADDR;
+    DMAC_DSTADDR_Type   DSTADDR;
+    DMAC_DESCADDR_Type  DESCADDR;
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_DMAC {
+    DMAC_CTRL_Type      CTRL;
+    DMAC_CRCCTRL_Type   CRCCTRL;
+    DMAC_QOSCTRL_Type   QOSCTRL;
+    DMAC_PRICTRL0_Type  PRICTRL0;
+    DMAC_BASEADDR_Type  BASEADDR;
+    DMAC_WRBADDR_Type   WRBADDR;
+    DMAC_CHCTRLA_Type   CHCTRLA[12];    // indexed by CHID
+    DMAC_CHCTRLB_Type   CHCTRLB[12];    // indexed by CHID
+    ZeroRegSnapshot_DMAC_Descriptor DESC[12];   // first descriptor, indexed by CHID
+    ZeroRegSnapshot_DMAC_Descriptor WRB[12];    // write-back descriptor, indexed by CHID
+    // found by following DESCADDR from the first descriptor
+    uint16_t            LINKS[12];      // how many descriptors
+    uint32_t            BYTES[12];      // how many bytes they move
+    uint16_t            LOOPS;          // bitmask of channels which end up back where they started
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_EIC {
+    EIC_CTRL_Type       CTRL;
+    EIC_NMICTRL_Type    NMICTRL;
+    EIC_EVCTRL_Type     EVCTRL;
+    EIC_WAKEUP_Type     WAKEUP;
+    EIC_CONFIG_Type     CONFIG[2];
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_EVSYS {
+    EVSYS_CTRL_Type     CTRL;
+    EVSYS_CHANNEL_Type  CHANNEL[12];    // indexed by CHANNEL.CHANNEL
+    EVSYS_USER_Type     USER[0x25];     // indexed by USER.USER
+};
+
+// GCLK channels 0x00 (DFLL48M) through 0x25 (TCC3)
+#define ZEROREGS_GCLK_CHANNELS 38
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_GCLK {
+    GCLK_GENCTRL_Type   GENCTRL[9];     // indexed by GENCTRL.ID
+    GCLK_GENDIV_Type    GENDIV[9];      // indexed by GENDIV.ID
+    GCLK_CLKCTRL_Type   CLKCTRL[ZEROREGS_GCLK_CHANNELS];    // indexed by CLKCTRL.ID
+};
+
+// not every SAM D21 has an I2S, so these are kept as plain integers
+struct ZEROREGS_PACKED ZeroRegSnapshot_I2S {
+    uint8_t             CTRLA;
+    uint32_t            CLKCTRL[2];
+    uint32_t            SERCTRL[2];
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_NVMCTRL {
+    NVMCTRL_CTRLB_Type  CTRLB;
+    NVMCTRL_PARAM_Type  PARAM;
+    NVMCTRL_LOCK_Type   LOCK;
+    uint32_t            USER[2];        // NVM user row
+    uint32_t            OTP4[2];        // software calibration area
+    uint32_t            SERIAL[4];      // serial number words
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_PAC {
+    PAC_WPSET_Type      WPSET[3];       // PAC0, PAC1, PAC2
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_PM {
+    PM_SLEEP_Type       SLEEP;
+    PM_CPUSEL_Type      CPUSEL;
+    PM_APBASEL_Type     APBASEL;
+    PM_APBBSEL_Type     APBBSEL;
+    PM_APBCSEL_Type     APBCSEL;
+    PM_AHBMASK_Type     AHBMASK;
+    PM_APBAMASK_Type    APBAMASK;
+    PM_APBBMASK_Type    APBBMASK;
+    PM_APBCMASK_Type    APBCMASK;
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_PORT_Group {
+    PORT_DIR_Type       DIR;
+    PORT_OUT_Type       OUT;
+    PORT_CTRL_Type      CTRL;
+    PORT_PMUX_Type      PMUX[16];
+    PORT_PINCFG_Type    PINCFG[32];
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_PORT {
+    ZeroRegSnapshot_PORT_Group  Group[2];
+    uint32_t            SERCOM_CTRLA[6];    // for the pin hints
+    uint32_t            SERCOM_CTRLB[6];    // for the pin hints
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_RTC_MODE0 {
+    RTC_MODE0_CTRL_Type     CTRL;
+    RTC_MODE0_EVCTRL_Type   EVCTRL;
+    RTC_FREQCORR_Type       FREQCORR;
+    RTC_MODE0_COMP_Type     COMP[1];
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_RTC_MODE1 {
+    RTC_MODE1_CTRL_Type     CTRL;
+    RTC_MODE1_EVCTRL_Type   EVCTRL;
+    RTC_FREQCORR_Type       FREQCORR;
+    RTC_MODE1_PER_Type      PER;
+    RTC_MODE1_COMP_Type     COMP[2];
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_RTC_MODE2 {
+    RTC_MODE2_CTRL_Type     CTRL;
+    RTC_MODE2_EVCTRL_Type   EVCTRL;
+    RTC_FREQCORR_Type       FREQCORR;
+    RTC_MODE2_ALARM_Type    ALARM[1];
+    RTC_MODE2_MASK_Type     MASK[1];
+};
+union ZeroRegSnapshot_RTC {
+    ZeroRegSnapshot_RTC_MODE0   MODE0;
+    ZeroRegSnapshot_RTC_MODE1   MODE1;
+    ZeroRegSnapshot_RTC_MODE2   MODE2;
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_SCS {
+    uint32_t            CPUID;
+    uint32_t            SysTick_CTRL;
+    uint32_t            SysTick_LOAD;
+    uint32_t            SysTick_CALIB;
+    uint32_t            NVIC_IP[8];
+    uint32_t            NVIC_ISER;
+    uint32_t            NVIC_ISPR;
+    uint32_t            SCB_SHPR3;      // SysTick and PendSV priorities
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_SERCOM_I2CM {
+    SERCOM_I2CM_CTRLA_Type  CTRLA;
+    SERCOM_I2CM_CTRLB_Type  CTRLB;
+    SERCOM_I2CM_BAUD_Type   BAUD;
+    SERCOM_I2CM_ADDR_Type   ADDR;
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_SERCOM_I2CS {
+    SERCOM_I2CS_CTRLA_Type  CTRLA;
+    SERCOM_I2CS_CTRLB_Type  CTRLB;
+    SERCOM_I2CS_ADDR_Type   ADDR;
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_SERCOM_SPI {
+    SERCOM_SPI_CTRLA_Type   CTRLA;
+    SERCOM_SPI_CTRLB_Type   CTRLB;
+    SERCOM_SPI_BAUD_Type    BAUD;
+    SERCOM_SPI_ADDR_Type    ADDR;
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_SERCOM_USART {
+    SERCOM_USART_CTRLA_Type CTRLA;
+    SERCOM_USART_CTRLB_Type CTRLB;
+    SERCOM_USART_BAUD_Type  BAUD;
+    SERCOM_USART_RXPL_Type  RXPL;
+};
+union ZeroRegSnapshot_SERCOM {
+    ZeroRegSnapshot_SERCOM_I2CM     I2CM;
+    ZeroRegSnapshot_SERCOM_I2CS     I2CS;
+    ZeroRegSnapshot_SERCOM_SPI      SPI;
+    ZeroRegSnapshot_SERCOM_USART    USART;
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_SYSCTRL {
+    SYSCTRL_XOSC_Type       XOSC;
+    SYSCTRL_XOSC32K_Type    XOSC32K;
+    SYSCTRL_OSC32K_Type     OSC32K;
+    SYSCTRL_OSCULP32K_Type  OSCULP32K;
+    SYSCTRL_OSC8M_Type      OSC8M;
+    SYSCTRL_DFLLCTRL_Type   DFLLCTRL;
+    SYSCTRL_DFLLMUL_Type    DFLLMUL;
+    SYSCTRL_BOD33_Type      BOD33;
+    SYSCTRL_VREG_Type       VREG;
+    SYSCTRL_VREF_Type       VREF;
+    SYSCTRL_DPLLCTRLA_Type  DPLLCTRLA;
+    SYSCTRL_DPLLRATIO_Type  DPLLRATIO;
+    SYSCTRL_DPLLCTRLB_Type  DPLLCTRLB;
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_TC_COUNT8 {
+    TC_CTRLA_Type           CTRLA;
+    TC_CTRLBSET_Type        CTRLBSET;
+    TC_CTRLC_Type           CTRLC;
+    TC_EVCTRL_Type          EVCTRL;
+    TC_COUNT8_PER_Type      PER;
+    TC_COUNT8_CC_Type       CC[2];
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_TC_COUNT16 {
+    TC_CTRLA_Type           CTRLA;
+    TC_CTRLBSET_Type        CTRLBSET;
+    TC_CTRLC_Type           CTRLC;
+    TC_EVCTRL_Type          EVCTRL;
+    TC_COUNT16_CC_Type      CC[2];
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_TC_COUNT32 {
+    TC_CTRLA_Type           CTRLA;
+    TC_CTRLBSET_Type        CTRLBSET;
+    TC_CTRLC_Type           CTRLC;
+    TC_EVCTRL_Type          EVCTRL;
+    TC_COUNT32_CC_Type      CC[2];
+};
+union ZeroRegSnapshot_TC {
+    ZeroRegSnapshot_TC_COUNT8   COUNT8;
+    ZeroRegSnapshot_TC_COUNT16  COUNT16;
+    ZeroRegSnapshot_TC_COUNT32  COUNT32;
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_TCC {
+    TCC_CTRLA_Type      CTRLA;
+    TCC_CTRLBSET_Type   CTRLBSET;
+    TCC_FCTRLA_Type     FCTRLA;
+    TCC_FCTRLB_Type     FCTRLB;
+    TCC_WEXCTRL_Type    WEXCTRL;
+    TCC_DRVCTRL_Type    DRVCTRL;
+    TCC_EVCTRL_Type     EVCTRL;
+    TCC_PATT_Type       PATT;
+    TCC_WAVE_Type       WAVE;
+    TCC_PER_Type        PER;
+    TCC_CC_Type         CC[4];
+};
+
+// the fields of the USB descriptor banks which are decoded
+struct ZEROREGS_PACKED ZeroRegSnapshot_USB_DescBank {
+    USB_HOST_ADDR_Type      ADDR;
+    USB_HOST_PCKSIZE_Type   PCKSIZE;
+    USB_HOST_EXTREG_Type    EXTREG;
+    USB_HOST_CTRL_PIPE_Type CTRL_PIPE;
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_USB_DEVICE {
+    USB_CTRLA_Type          CTRLA;
+    USB_QOSCTRL_Type        QOSCTRL;
+    USB_DEVICE_CTRLB_Type   CTRLB;
+    USB_DEVICE_DADD_Type    DADD;
+    USB_PADCAL_Type         PADCAL;
+    USB_DEVICE_EPCFG_Type   EPCFG[8];
+    ZeroRegSnapshot_USB_DescBank    DescBank[8][2];
+};
+struct ZEROREGS_PACKED ZeroRegSnapshot_USB_HOST {
+    USB_CTRLA_Type          CTRLA;
+    USB_QOSCTRL_Type        QOSCTRL;
+    USB_HOST_CTRLB_Type     CTRLB;
+    USB_HOST_HSOFC_Type     HSOFC;
+    USB_PADCAL_Type         PADCAL;
+    USB_HOST_PCFG_Type      PCFG[8];
+    USB_HOST_BINTERVAL_Type BINTERVAL[8];
+    ZeroRegSnapshot_USB_DescBank    DescBank[8][2];
+};
+union ZeroRegSnapshot_USB {
+    ZeroRegSnapshot_USB_DEVICE  DEVICE;
+    ZeroRegSnapshot_USB_HOST    HOST;
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot_WDT {
+    WDT_CTRL_Type       CTRL;
+    WDT_CONFIG_Type     CONFIG;
+    WDT_EWCTRL_Type     EWCTRL;
+    uint32_t            USER[2];        // NVM user row
+};
+
+struct ZEROREGS_PACKED ZeroRegSnapshot {
+    ZeroRegSnapshot_SCS     scs;
+    ZeroRegSnapshot_SYSCTRL sysctrl;
+    ZeroRegSnapshot_GCLK    gclk;
+    ZeroRegSnapshot_DMAC    dmac;
+    ZeroRegSnapshot_EVSYS   evsys;
+    ZeroRegSnapshot_PAC     pac;
+    ZeroRegSnapshot_PM      pm;
+    ZeroRegSnapshot_WDT     wdt;
+    ZeroRegSnapshot_AC      ac;
+    ZeroRegSnapshot_ADC     adc;
+    ZeroRegSnapshot_DAC     dac;
+    ZeroRegSnapshot_EIC     eic;
+    ZeroRegSnapshot_I2S     i2s;
+    ZeroRegSnapshot_NVMCTRL nvmctrl;
+    ZeroRegSnapshot_PORT    port;
+    ZeroRegSnapshot_RTC     rtc;
+    ZeroRegSnapshot_SERCOM  sercom[6];  // indexed by SERCOM number
+    ZeroRegSnapshot_TCC     tcc[4];     // indexed by TCC number
+    ZeroRegSnapshot_TC      tc[5];      // indexed by TC number minus 3
+    ZeroRegSnapshot_USB     usb;
+};
+
+
+// Clock frequencies (in Hz) worked out from the SYSCTRL and GCLK registers,
+// from the oscillators through the generators to each peripheral channel.  A
+// frequency is 0 if that clock isn't running, or if it can't be known from
+// the registers (GCLKIN, or XOSC when `xoscHz` is 0).  The DFLL48M in
+// open-loop mode is taken to be its nominal 48MHz.
+struct ZeroRegClocks {
+    uint32_t    XOSC;
+    uint32_t    XOSC32K;
+    uint32_t    OSC32K;
+    uint32_t    OSCULP32K;
+    uint32_t    OSC8M;
+    uint32_t    DFLL48M;
+    uint32_t    FDPLL96M;
+    uint32_t    GEN[9];         // each generator, indexed by GENCTRL.ID
+    uint32_t    CLKCTRL[ZEROREGS_GCLK_CHANNELS];    // each peripheral channel, indexed by CLKCTRL.ID
+};
+void computeZeroRegClocks(ZeroRegClocks &clocks, const ZeroRegSnapshot_SYSCTRL &sysctrl, const ZeroRegSnapshot_GCLK &gclk, uint32_t xoscHz);
+
+// Prints the CPU, AHB, and APB bus frequencies, then for each peripheral the
+// frequency of its bus clock (gated by PM APBxMASK) and of its GCLK core
+// clock.  Peripherals whose core clock is slower than their bus clock, or
+// which have a core clock but no bus clock, are flagged.  printZeroRegs()
+// prints this just before printZeroRegIdleClocks().
+void printZeroRegClocks(ZeroRegOptions &opts, const ZeroRegSnapshot_PM &pm, const ZeroRegSnapshot_GCLK &gclk, const ZeroRegClocks &clocks);
+void printZeroRegClocks(ZeroRegOptions &opts);
+
+// Prints one line comparing the flash wait states (NVMCTRL CTRLB.RWS) with
+// how many the CPU clock needs, flagging too few (unsafe) or too many (lost
+// speed), and warning if the cache is disabled or READMODE isn't
+// NO_MISS_PENALTY.  VDD is taken to be 2.7V or more (as it is on most boards)
+// but is only known if BOD33 resets below that.  The live printZeroRegClocks()
+// and the CLOCKS section of printZeroRegs() print this at the end.
+void printZeroRegWaitStates(ZeroRegOptions &opts, const ZeroRegSnapshot_NVMCTRL &nvmctrl, const ZeroRegSnapshot_SYSCTRL &sysctrl, uint32_t cpuHz);
+
+// Prints the clocks which are running but feeding nothing useful, with a rough
+// guess at the current each wastes: bus and GCLK core clocks of disabled
+// peripherals, EVSYS channel clocks nothing uses, generators without users,
+// and oscillators without users which aren't ONDEMAND.  Ends with the total.
+// printZeroRegs() prints this after CLOCKS.
+void printZeroRegIdleClocks(ZeroRegOptions &opts, const ZeroRegSnapshot &snap);
+void printZeroRegIdleClocks(ZeroRegOptions &opts);
+
+// An event channel with where its events come from and where they go: the
+// generator, how the event gets through the channel, and every user reading
+// the channel.  [24.6.2.6 DSrevF] LATENCY is an estimate of the
+// GCLK_EVSYS_CHANNELx cycles the path adds (none for asynchronous, one for
+// synchronous, and up to three for resynchronized).
+struct ZeroRegEVSYSRoute {
+    uint8_t     CHANNEL;
+    uint8_t     EVGEN;          // 0 if only software events
+    uint8_t     PATH;
+    uint8_t     EDGSEL;
+    uint8_t     LATENCY;
+    uint64_t    USERS;          // bitmask, indexed by USER.USER
+};
+// Fills in a route for each channel which has a generator or any users, and
+// returns how many.
+uint8_t computeZeroRegEVSYSRoutes(ZeroRegEVSYSRoute (&routes)[12], const ZeroRegSnapshot_EVSYS &evsys);
+
+// Prints the event routes as a Graphviz DOT digraph, with an edge from each
+// generator to its channel (labeled with the path, edge selection, and
+// latency) and from each channel to its users.
+void printZeroRegEVSYSDot(ZeroRegOptions &opts, const ZeroRegSnapshot_EVSYS &evsys);
+void printZeroRegEVSYSDot(ZeroRegOptions &opts);
+
+
+void captureZeroRegAC(ZeroRegSnapshot_AC &ac);
+void captureZeroRegADC(ZeroRegSnapshot_ADC &adc);
+void captureZeroRegDAC(ZeroRegSnapshot_DAC &dac);
+void captureZeroRegDMAC(ZeroRegSnapshot_DMAC &dmac);
+void captureZeroRegEIC(ZeroRegSnapshot_EIC &eic);
+void captureZeroRegEVSYS(ZeroRegSnapshot_EVSYS &evsys);
+void captureZeroRegGCLK(ZeroRegSnapshot_GCLK &gclk);
+void captureZeroRegI2S(ZeroRegSnapshot_I2S &i2s);
+void captureZeroRegNVMCTRL(ZeroRegSnapshot_NVMCTRL &nvmctrl);
+void captureZeroRegPAC(ZeroRegSnapshot_PAC &pac);
+void captureZeroRegPM(ZeroRegSnapshot_PM &pm);
+void captureZeroRegPORT(ZeroRegSnapshot_PORT &port);
+void captureZeroRegRTC(ZeroRegSnapshot_RTC &rtc);
+void captureZeroRegSCS(ZeroRegSnapshot_SCS &scs);
+void captureZeroRegSERCOM(ZeroRegSnapshot_SERCOM &snap, Sercom* sercom);
+void captureZeroRegSYSCTRL(ZeroRegSnapshot_SYSCTRL &sysctrl);
+void captureZeroRegTC(ZeroRegSnapshot_TC &snap, Tc* tc);
+void captureZeroRegTCC(ZeroRegSnapshot_TCC &snap, Tcc* tcc);
+void captureZeroRegUSB(ZeroRegSnapshot_USB &usb);
+void captureZeroRegWDT(ZeroRegSnapshot_WDT &wdt);
+void captureZeroRegs(ZeroRegSnapshot &snap);
+
+void printZeroRegAC(ZeroRegOptions &opts, const ZeroRegSnapshot_AC &ac);
+void printZeroRegADC(ZeroRegOptions &opts, const ZeroRegSnapshot_ADC &adc);
+// Also prints the ADC clock, the sample and conversion times, and how many
+// results a second it gives free-running and triggered, given the frequency
+// of the GCLK_ADC channel.
+void printZeroRegADC(ZeroRegOptions &opts, const ZeroRegSnapshot_ADC &adc, uint32_t coreHz);
+void printZeroRegDAC(ZeroRegOptions &opts, const ZeroRegSnapshot_DAC &dac);
+void printZeroRegDMAC(ZeroRegOptions &opts, const ZeroRegSnapshot_DMAC &dmac);
+void printZeroRegEIC(ZeroRegOptions &opts, const ZeroRegSnapshot_EIC &eic);
+void printZeroRegEVSYS(ZeroRegOptions &opts, const ZeroRegSnapshot_EVSYS &evsys);
+void printZeroRegGCLK(ZeroRegOptions &opts, const ZeroRegSnapshot_GCLK &gclk);
+void printZeroRegGCLK(ZeroRegOptions &opts, const ZeroRegSnapshot_GCLK &gclk, const ZeroRegClocks *clocks);
+void printZeroRegI2S(ZeroRegOptions &opts, const ZeroRegSnapshot_I2S &i2s);
+void printZeroRegNVMCTRL(ZeroRegOptions &opts, const ZeroRegSnapshot_NVMCTRL &nvmctrl);
+void printZeroRegPAC(ZeroRegOptions &opts, const ZeroRegSnapshot_PAC &pac);
+void printZeroRegPM(ZeroRegOptions &opts, const ZeroRegSnapshot_PM &pm);
+void printZeroRegPORT(ZeroRegOptions &opts, const ZeroRegSnapshot_PORT &port);
+void printZeroRegPORT_Arduino(ZeroRegOptions &opts, const ZeroRegSnapshot_PORT &port);
+void printZeroRegRTC(ZeroRegOptions &opts, const ZeroRegSnapshot_RTC &rtc);
+// Also audits interrupt latency: which IRQs are enabled and pending, how
+// deep enabled handlers can nest, and for each IRQ in opts.irqCritical which
+// enabled IRQs it can wait behind, flagging those less critical than it.
+void printZeroRegSCS(ZeroRegOptions &opts, const ZeroRegSnapshot_SCS &scs);
+void printZeroRegSERCOM(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM &snap, uint8_t idx);
+// Also prints the achieved rate (and for a USART the nearest usual rate and
+// the error from it) and how long each character takes, given the frequency
+// of the GCLK_SERCOMx_CORE channel.  For an I2C master it prints the SCL
+// frequency, high and low times, and about how many single-byte register
+// reads a second that allows, and flags timing which is slower than the
+// SPEED allows (or breaks it).  SCL rise time is taken to be
+// ZEROREGS_I2C_RISE_NS, which is what the Arduino core assumes.
+#ifndef ZEROREGS_I2C_RISE_NS
+#define ZEROREGS_I2C_RISE_NS 125
+#endif
+void printZeroRegSERCOM(ZeroRegOptions &opts, const ZeroRegSnapshot_SERCOM &snap, uint8_t idx, uint32_t coreHz);
+void printZeroRegSYSCTRL(ZeroRegOptions &opts, const ZeroRegSnapshot_SYSCTRL &sysctrl);
+void printZeroRegSYSCTRL(ZeroRegOptions &opts, const ZeroRegSnapshot_SYSCTRL &sysctrl, const ZeroRegClocks *clocks);
+void printZeroRegTC(ZeroRegOptions &opts, const ZeroRegSnapshot_TC &snap, uint8_t idx);
+// Also prints the counter's tick rate, TOP, output frequency, and resolution,
+// and the duty cycle of each PWM channel, given the frequency of the
+// GCLK_TCx channel.
+void printZeroRegTC(ZeroRegOptions &opts, const ZeroRegSnapshot_TC &snap, uint8_t idx, uint32_t coreHz);
+void printZeroRegTCC(ZeroRegOptions &opts, const ZeroRegSnapshot_TCC &snap, uint8_t idx);
+// Same as printZeroRegTC(), with the extra bits of resolution which the
+// RESOLUTION dithering modes give.
+void printZeroRegTCC(ZeroRegOptions &opts, const ZeroRegSnapshot_TCC &snap, uint8_t idx, uint32_t coreHz);
+void printZeroRegUSB(ZeroRegOptions &opts, const ZeroRegSnapshot_USB &usb);
+void printZeroRegWDT(ZeroRegOptions &opts, const ZeroRegSnapshot_WDT &wdt);
+void printZeroRegs(ZeroRegOptions &opts, const ZeroRegSnapshot &snap);
+
+// Prints only the lines which are different between the two snapshots, as
+//      - old line
+//      + new line
+// under the header of the section they're in.  Sections with no differences
+// aren't printed at all.  This always acts as if `opts.showDisabled` is set
+// (so that something being disabled shows up) and always prints text.
+#ifndef ZEROREGS_DIFF_LINES
+#define ZEROREGS_DIFF_LINES 96
+#endif
+void printZeroRegsDiff(ZeroRegOptions &opts, const ZeroRegSnapshot &base, const ZeroRegSnapshot &snap);
+
+// For printing the registers a little at a time, such as from loop().
+// beginZeroRegsStep() captures the registers, then each call to
+// printZeroRegsStep() prints at most one line of them, and at most `maxBytes`.
+// If `checkAvailable` is set (it is by default) then it also doesn't print
+// more than opts.out.availableForWrite(), so it never waits for the output.
+// It returns false once everything has been printed.  The text is the same as
+// printZeroRegs() (but never JSON).  Each call formats at most one section,
+// so takes at most about as long as the largest printZeroRegPERIPHERAL().
+// A call on a section which prints nothing (such as a disabled peripheral)
+// prints nothing, and the next call moves on.
+struct ZeroRegStepState {
+    ZeroRegSnapshot snap;
+    uint8_t         section;        // which section is being printed
+    uint16_t        offset;         // how much of it has been printed
+    bool            checkAvailable;
+};
+void beginZeroRegsStep(ZeroRegStepState &state);
+bool printZeroRegsStep(ZeroRegOptions &opts, ZeroRegStepState &state, size_t maxBytes);
+
 void printZeroRegAC(ZeroRegOptions &opts);
 void printZeroRegADC(ZeroRegOptions &opts);
 void printZeroRegDAC(ZeroRegOptions &opts);
@@ -61,5 +620,195 @@ void printZeroRegTCC(ZeroRegOptions &opts, Tcc* tcc, uint8_t idx);
 void printZeroRegUSB(ZeroRegOptions &opts);
 void printZeroRegWDT(ZeroRegOptions &opts);
 void printZeroRegs(ZeroRegOptions &opts);
+void printZeroRegsDiff(ZeroRegOptions &opts, const ZeroRegSnapshot &base);
+
+// Same as printZeroRegs() (but never JSON), then prints how long capturing
+// (reading the registers, including waiting for them to synchronize) and
+// printing (formatting and output) each section took, in CPU cycles.  This
+// uses SysTick, so expects it to be set up the way the Arduino core does.
+void printZeroRegsTimed(ZeroRegOptions &opts);
+
+// Samples some sections of the registers at a fixed rate from a TC interrupt
+// into a ring buffer, for seeing how they changed around an intermittent
+// problem.  beginZeroRegsWatch() captures all the registers once (so that
+// what isn't watched can still be decoded), then sets up the TC to interrupt
+// `hz` times a second.  The TC's interrupt handler has to call
+// sampleZeroRegsWatch(), such as:
+//      void TC4_Handler() { sampleZeroRegsWatch(watch); }
+// `sections` names the watched sections as printZeroRegs() does, separated by
+// spaces (such as "TC3 SERCOM0").  CLOCKS and IDLECLOCKS can't be watched.
+// Each sample is a micros() timestamp and the watched sections' part of the
+// snapshot, and once `buffer` is full each sample replaces the oldest.
+//
+// Each sample takes about the CAPTURE cycles printZeroRegsTimed() shows for
+// the watched sections, plus a little.  beginZeroRegsWatch() takes the first
+// sample itself, and returns false without starting the TC if that took more
+// than 1/ZEROREGS_WATCH_BUDGET of the period.  It also returns false if a
+// section isn't known, `len` doesn't fit one sample, `idx` isn't 3 to 7, or
+// the TC can't run at `hz`.  The TC is reset (so anything else using it
+// stops), then clocked from GCLK_MAIN unless its GCLK channel is already
+// enabled.  Watching GCLK changes which generator and channel GCLK's
+// registers select, so don't if anything sets up clocks with interrupts on.
+#ifndef ZEROREGS_WATCH_BUDGET
+#define ZEROREGS_WATCH_BUDGET 10
+#endif
+struct ZeroRegWatchState {
+    ZeroRegSnapshot     snap;
+    Tc*                 tc;
+    uint8_t             idx;
+    uint8_t*            buffer;
+    uint64_t            sections;       // bitmask, indexed by section
+    uint16_t            sampleSize;     // bytes, including the timestamp
+    uint16_t            capacity;       // how many samples fit in the buffer
+    uint32_t            budget;         // CPU cycles a sample may take
+    volatile uint16_t   head;           // where the next sample goes
+    volatile uint16_t   count;          // how many samples are in the buffer
+    volatile uint32_t   dropped;        // how many were replaced unprinted
+    volatile uint32_t   cycles;         // the most CPU cycles a sample took
+};
+bool beginZeroRegsWatch(ZeroRegWatchState &state, Tc* tc, uint8_t idx, uint32_t hz, const char* sections, uint8_t* buffer, size_t len);
+void sampleZeroRegsWatch(ZeroRegWatchState &state);
+void endZeroRegsWatch(ZeroRegWatchState &state);
+
+// Prints a `watch` line with how many samples there are, how many were
+// dropped, and the cycle budget, then removes and prints each sample (oldest
+// first) as its time and the watched sections.  This can run while sampling
+// carries on.  Like printZeroRegsStep(), it never prints JSON.
+void printZeroRegsWatch(ZeroRegOptions &opts, ZeroRegWatchState &state);
+
+// For watching a few registers (such as status registers, which snapshots
+// don't have) much faster than a watch can.  List them with
+// ZEROREGS_WATCH_ITEM(), giving which bits to keep (0 for all of them):
+//      const ZeroRegWatchItem items[] = {
+//          ZEROREGS_WATCH_ITEM(TCC0->STATUS.reg, 0),
+//          ZEROREGS_WATCH_ITEM(DMAC->ACTIVE.reg, DMAC_ACTIVE_ABUSY | DMAC_ACTIVE_ID_Msk),
+//      };
+// beginZeroRegsWatchlist() turns them into a flat list of addresses and masks
+// and reads where each starts.  Then each of the `times` rounds of
+// sampleZeroRegsWatchlist() reads every register in a tight loop, and keeps
+// only the values which changed, with the CPU cycle (see printZeroRegsTimed())
+// the round started on.  Once `changes` is full the rest are counted but
+// dropped.  It returns false if there are more than ZEROREGS_WATCHLIST_ITEMS
+// items or an item isn't 1, 2, or 4 bytes.
+struct ZeroRegWatchItem {
+    const char* name;
+    uintptr_t   addr;
+    uint32_t    mask;
+    uint8_t     size;
+};
+#define ZEROREGS_WATCH_ITEM(reg, mask) { #reg, (uintptr_t)&(reg), (mask), sizeof(reg) }
+struct ZEROREGS_PACKED ZeroRegWatchChange {
+    uint32_t    cycles;
+    uint32_t    value;
+    uint8_t     item;
+};
+#ifndef ZEROREGS_WATCHLIST_ITEMS
+#define ZEROREGS_WATCHLIST_ITEMS 8
+#endif
+struct ZeroRegWatchlist {
+    const ZeroRegWatchItem* items;
+    uint8_t             count;
+    uintptr_t           addr[ZEROREGS_WATCHLIST_ITEMS];
+    uint32_t            mask[ZEROREGS_WATCHLIST_ITEMS];
+    uint8_t             size[ZEROREGS_WATCHLIST_ITEMS];
+    uint32_t            first[ZEROREGS_WATCHLIST_ITEMS];    // when it began
+    uint32_t            last[ZEROREGS_WATCHLIST_ITEMS];     // the latest
+    ZeroRegWatchChange* changes;
+    uint16_t            capacity;
+    uint16_t            used;
+    uint32_t            dropped;
+    uint32_t            samples;
+    uint32_t            begun;          // CPU cycle it began on
+    uint32_t            ended;          // CPU cycle the latest round started on
+};
+bool beginZeroRegsWatchlist(ZeroRegWatchlist &list, const ZeroRegWatchItem* items, uint8_t count, ZeroRegWatchChange* changes, uint16_t len);
+void sampleZeroRegsWatchlist(ZeroRegWatchlist &list, uint32_t times);
+
+// Prints a `watchlist` line with how many rounds were sampled, how long each
+// took, and how many changes there were, then each register's value when
+// watching began, then each change (in order) with its time since then and
+// which bits changed.  Like printZeroRegsStep(), it never prints JSON.
+void printZeroRegsWatchlist(ZeroRegOptions &opts, const ZeroRegWatchlist &list);
+
+
+// For finding out what the registers were when the watchdog (or anything
+// else) reset the chip.  beginZeroRegsPostMortem() erases the reserved rows
+// of flash at `addr` (which has to be at the start of a 256-byte row, in
+// `len` bytes the sketch doesn't use, such as the end of flash), and then
+// saveZeroRegsPostMortem() captures the listed sections (or all the ones a
+// watch could, for NULL) and writes them there.  That's quick enough to do
+// from the WDT early warning interrupt:
+//      void WDT_Handler() { saveZeroRegsPostMortem(postMortem); }
+// The rows are erased up front since that's the slow part, so only the
+// first save after beginning is kept.  It returns false if it wasn't armed
+// or the write failed (such as into the bootloader).
+// beginZeroRegsPostMortem() returns false if a section isn't known or the
+// record doesn't fit in `len`, or if the WDT early warning is on and the
+// save wouldn't finish before the reset.  `writeUS` is how long it should
+// take (capturing, plus the datasheet's longest page write time for each 64
+// bytes) and `windowUS` is how long the early warning leaves.
+struct ZeroRegPostMortem {
+    ZeroRegSnapshot     snap;
+    uint32_t            addr;
+    uint64_t            sections;       // bitmask, indexed by section
+    uint16_t            size;           // bytes, including the header
+    uint32_t            writeUS;
+    uint32_t            windowUS;       // 0 if there's no early warning
+    volatile bool       armed;          // the rows are erased, and unwritten
+};
+bool beginZeroRegsPostMortem(ZeroRegPostMortem &pm, uint32_t addr, size_t len, const char* sections);
+bool saveZeroRegsPostMortem(ZeroRegPostMortem &pm);
+
+// Prints why the chip last reset (from PM RCAUSE), then the sections saved
+// at `addr` with how long the sketch had been running, or that none were.
+// Call it before beginZeroRegsPostMortem() erases them.  Returns whether a
+// record was found.  Like printZeroRegsStep(), it never prints JSON.
+bool printZeroRegsPostMortem(ZeroRegOptions &opts, uint32_t addr);
+
+// A CRC-32 of each peripheral's configuration, for spotting which boards in a
+// fleet have drifted without sending whole dumps.  Only what comes from
+// configuring the peripheral is covered; the SysTick COUNTFLAG, pending
+// interrupts, DMAC write-back descriptors, USB descriptor byte counts, and
+// the levels of output pins are left out, as are the serial number and the
+// factory calibration (NVM OTP4, the OSC8M, OSC32K, and OSCULP32K CALIB
+// fields, ADC CALIB, and USB PADCAL), which differ between chips.  There's one for each section printZeroRegs() prints before the
+// clock overviews (SYSCTRL and GCLK each cover only their own registers, and
+// PORT_Arduino is left out since it's the same as PORT), plus `all`, which
+// is a CRC-32 of all of those in order.  `sections` says which this chip has.
+// They're the same CRC-32 as zlib, worked out by the DMAC CRC engine if
+// nothing else is using it (`dmac` is true) or in software if it is.
+#define ZEROREGS_FINGERPRINTS 33
+struct ZeroRegFingerprints {
+    uint32_t    crc[ZEROREGS_FINGERPRINTS];     // indexed by section
+    uint64_t    sections;                       // bitmask, indexed by section
+    uint32_t    all;
+    bool        dmac;
+};
+void computeZeroRegFingerprints(ZeroRegFingerprints &fp, const ZeroRegSnapshot &snap);
+
+// Prints a FINGERPRINTS section, with a line for each peripheral's CRC and
+// one for `all`.  This follows `opts.json`.
+void printZeroRegsFingerprints(ZeroRegOptions &opts, const ZeroRegSnapshot &snap);
+void printZeroRegsFingerprints(ZeroRegOptions &opts);
+
+// Writes the registers as a binary frame instead of as text.  This is smaller
+// (1.8k bytes, versus 4k to 13k of text) and isn't formatted on the board, so
+// it's much quicker over a slow serial link.  The frame is:
+//      "ZR"
+//      uint8_t     ZEROREGS_FRAME_VERSION
+//      uint16_t    sizeof(ZeroRegSnapshot), little-endian
+//      (the ZeroRegSnapshot)
+//      uint32_t    CRC-32 of everything after "ZR", little-endian
+// extras/host/zeroregs-decode prints a frame as the same text printZeroRegs()
+// would have.  ZEROREGS_FRAME_VERSION changes whenever ZeroRegSnapshot does.
+#define ZEROREGS_FRAME_VERSION 4
+#define ZEROREGS_FRAME_SIZE (5 + sizeof(ZeroRegSnapshot) + 4)
+void writeZeroRegs(Print &out, const ZeroRegSnapshot &snap);
+void writeZeroRegs(Print &out);
+
+// Checks a frame written by writeZeroRegs() and copies out its snapshot.
+// Returns false if `len` isn't ZEROREGS_FRAME_SIZE, or if the frame is for a
+// different version, or if it's corrupt.
+bool readZeroRegs(const uint8_t* frame, size_t len, ZeroRegSnapshot &snap);
 
 #endif // ZERO_REGS_H